@@ -0,0 +1,188 @@
+/**
+ * @file bench.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  End-to-end compiler benchmark
+ *
+ *  For every corpus size, generates a synthetic corpus,
+ *  counts its tokens with --stats and then compiles it
+ *  several times with "carbonsteel forge". The median wall
+ *  time gives the lines, tokens and output bytes per second,
+ *  the peak resident set size is the largest of the runs.
+ *
+ *  The results are printed as a table and written
+ *  as a JSON baseline which can be compared between releases.
+ *
+ *  Usage: carbonsteel-bench <carbonsteel> <corpus generator>
+ *             <work directory> <baseline> [-r repeats] [lines...]
+ */
+    /* includes */
+#include <stdio.h> /* file functions */
+#include <stdlib.h> /* number parsing */
+#include <string.h> /* string functions */
+#include <sys/stat.h> /* directories */
+
+#include "run.h" /* process helpers */
+
+    /* defines */
+/**
+ * Maximum number of corpus sizes
+ */
+#define BENCH_MAX_SIZES 32
+
+    /* typedefs */
+/**
+ * Result of a corpus size
+ */
+typedef struct bench_result {
+    unsigned long long lines; /* actual lines of the corpus */
+    unsigned long long source_bytes;
+    unsigned long long tokens;
+    unsigned long long output_bytes;
+    double seconds; /* median wall time */
+    unsigned long long peak_rss; /* bytes */
+} bench_result;
+
+    /* global variables */
+/**
+ * Default corpus sizes in lines
+ */
+static const unsigned long long bench_default_sizes[] = { 1000, 10000, 100000, 1000000 };
+
+    /* internal functions */
+/**
+ * Benchmarks a corpus size
+ *
+ * @param[in]  compiler  Path to the compiler
+ * @param[in]  generator Path to the corpus generator
+ * @param[in]  directory The work directory
+ * @param[in]  size      Requested corpus lines
+ * @param[in]  repeats   Number of timed compilations
+ * @param[out] result    Pointer to the result
+ *
+ * @return false if the generator or the compiler have failed
+ */
+static bool bench_size(char* compiler, char* generator, const char* directory,
+        unsigned long long size, int repeats, bench_result* result) {
+    char lines[32], input[BENCH_PATH_SIZE], output[BENCH_PATH_SIZE], report[BENCH_PATH_SIZE];
+    snprintf(lines, sizeof(lines), "%llu", size);
+    snprintf(input, sizeof(input), "%s/corpus-%llu.cst", directory, size);
+    snprintf(output, sizeof(output), "%s/corpus-%llu.c", directory, size);
+    snprintf(report, sizeof(report), "%s/corpus-%llu.stats", directory, size);
+
+    /* generate the corpus */
+    char* generate[] = { generator, lines, input, NULL };
+    if (!bench_run(generate, NULL, NULL, NULL, NULL)) {
+        return false;
+    }
+    result->lines = bench_file_lines(input);
+    result->source_bytes = bench_file_size(input);
+
+    /* count the tokens, the statistics are not timed */
+    char* count[] = { compiler, "forge", "--stats", input, "-o", output, NULL };
+    if (!bench_run(count, NULL, report, NULL, NULL)) {
+        return false;
+    }
+    result->tokens = bench_read_stat(report, "total");
+
+    /* timed compilations */
+    char* forge[] = { compiler, "forge", input, "-o", output, NULL };
+    if (!bench_repeat(forge, repeats, &result->seconds, &result->peak_rss)) {
+        return false;
+    }
+    result->output_bytes = bench_file_size(output);
+    return true;
+}
+
+/**
+ * Parses a corpus size argument
+ *
+ * @param[in]  value The argument
+ * @param[out] sizes The corpus sizes
+ * @param[in]  index Index of the parsed size
+ *
+ * @return false if the size is invalid
+ */
+static bool bench_parse_size(const char* value, void* sizes, size_t index) {
+    char* end;
+    unsigned long long size = strtoull(value, &end, 10);
+    if (*end != '\0' || size == 0) {
+        fprintf(stderr, "Invalid corpus size: %s\n", value);
+        return false;
+    }
+    ((unsigned long long*) sizes)[index] = size;
+    return true;
+}
+
+/**
+ * Writes the fields of a corpus size result into the baseline
+ *
+ * @param[in] file   The baseline
+ * @param[in] result Pointer to the result
+ */
+static void bench_write_result(FILE* file, const void* result) {
+    const bench_result* r = result;
+    fprintf(file, "\"lines\": %llu, \"source_bytes\": %llu, \"tokens\": %llu, \"output_bytes\": %llu, "
+        "\"seconds\": %.6f, \"lines_per_second\": %.1f, \"tokens_per_second\": %.1f, "
+        "\"output_bytes_per_second\": %.1f, \"peak_rss_bytes\": %llu",
+        r->lines, r->source_bytes, r->tokens, r->output_bytes, r->seconds,
+        bench_rate(r->lines, r->seconds), bench_rate(r->tokens, r->seconds),
+        bench_rate(r->output_bytes, r->seconds), r->peak_rss);
+}
+
+    /* functions */
+/**
+ * Runs the benchmark
+ *
+ * @param argc Number of arguments
+ * @param argv Arguments (programs, directories, options and sizes)
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <carbonsteel> <corpus generator> <work directory> <baseline> "
+            "[-r repeats] [lines...]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    char* compiler = argv[1];
+    char* generator = argv[2];
+    const char* directory = argv[3];
+    const char* baseline = argv[4];
+
+    /* options and sizes */
+    int repeats = BENCH_DEFAULT_REPEATS;
+    unsigned long long sizes[BENCH_MAX_SIZES];
+    size_t size_count;
+    if (!bench_parse_arguments(argc, argv, 5, bench_parse_size, sizes, BENCH_MAX_SIZES, &size_count, &repeats)) {
+        return EXIT_FAILURE;
+    }
+    if (size_count == 0) {
+        size_count = sizeof(bench_default_sizes) / sizeof(*bench_default_sizes);
+        memcpy(sizes, bench_default_sizes, sizeof(bench_default_sizes));
+    }
+    mkdir(directory, 0755);
+
+    /* run */
+    bench_result results[BENCH_MAX_SIZES];
+    printf("%10s %10s %10s %14s %14s %14s %12s\n",
+        "lines", "tokens", "seconds", "lines/s", "tokens/s", "output B/s", "peak RSS");
+    for (size_t i = 0; i < size_count; i++) {
+        bench_result* r = &results[i];
+        if (!bench_size(compiler, generator, directory, sizes[i], repeats, r)) {
+            fprintf(stderr, "Benchmark of %llu lines has failed\n", sizes[i]);
+            return EXIT_FAILURE;
+        }
+        printf("%10llu %10llu %10.3f %14.0f %14.0f %14.0f %12llu\n", r->lines, r->tokens, r->seconds,
+            bench_rate(r->lines, r->seconds), bench_rate(r->tokens, r->seconds),
+            bench_rate(r->output_bytes, r->seconds), r->peak_rss);
+        fflush(stdout);
+    }
+
+    if (!bench_write_baseline(baseline, "forge", repeats, results, sizeof(bench_result), size_count, bench_write_result)) {
+        fprintf(stderr, "Unable to write the baseline %s\n", baseline);
+        return EXIT_FAILURE;
+    }
+    printf("baseline written to %s\n", baseline);
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
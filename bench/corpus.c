@@ -0,0 +1,206 @@
+/**
+ * @file corpus.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Synthetic corpus generator for the compiler benchmarks
+ *
+ *  Writes a Carbonsteel program of about the requested
+ *  number of lines, made of units with an enum, a structure
+ *  which refers to the structure of the previous unit, a
+ *  constructor function and a function with loops, branches
+ *  and nested expressions. Every eighth unit also declares
+ *  a generic structure with two implementations.
+ *
+ *  The output only depends on the line count and the seed.
+ *  The programs are meant to be compiled, not run.
+ *
+ *  Usage: carbonsteel-corpus <lines> <output> [seed]
+ */
+    /* includes */
+#include <stdio.h> /* file functions */
+#include <stdlib.h> /* number parsing */
+
+#include "run.h" /* generator helpers */
+
+    /* defines */
+/**
+ * Default seed of the generator
+ */
+#define CORPUS_DEFAULT_SEED 0x5eed
+
+/**
+ * Maximum depth of a generated expression
+ */
+#define CORPUS_EXPRESSION_DEPTH 4
+
+/**
+ * Every n-th unit declares a generic structure
+ */
+#define CORPUS_GENERIC_INTERVAL 8
+
+    /* internal functions */
+/**
+ * Writes a nested arithmetic expression
+ * over the locals of a unit function
+ *
+ * @param[in] c Pointer to the generator
+ * @param[in] depth Remaining nesting depth
+ */
+static void corpus_expression(bench_writer* c, int depth) {
+    static const char* leaves[] = { "a", "b", "count", "n", "node->id", "node->total" };
+    static const char* operators[] = { "+", "-", "*", "/", "%" };
+
+    if (depth == 0 || bench_random(c, 3) == 0) {
+        if (bench_random(c, 3) == 0) {
+            bench_emit(c, "%d", (int) bench_random(c, 99) + 1);
+        } else {
+            bench_emit(c, "%s", leaves[bench_random(c, sizeof(leaves) / sizeof(*leaves))]);
+        }
+        return;
+    }
+
+    bench_emit(c, "(");
+    corpus_expression(c, depth - 1);
+    bench_emit(c, " %s ", operators[bench_random(c, sizeof(operators) / sizeof(*operators))]);
+    corpus_expression(c, depth - 1);
+    bench_emit(c, ")");
+}
+
+/**
+ * Writes the declarations of a unit
+ *
+ * @param[in] c Pointer to the generator
+ * @param[in] i Index of the unit
+ */
+static void corpus_unit(bench_writer* c, size_t i) {
+    /* enum */
+    bench_emit(c, "enum kind_%zu {\n", i);
+    bench_emit(c, "    KIND_%zu_A, KIND_%zu_B, KIND_%zu_C\n", i, i, i);
+    bench_emit(c, "};\n\n");
+
+    /* structure, linked to the previous unit */
+    bench_emit(c, "type node_%zu {\n", i);
+    bench_emit(c, "    long id;\n");
+    bench_emit(c, "    long total;\n");
+    bench_emit(c, "    double scale;\n");
+    bench_emit(c, "    kind_%zu kind;\n", i);
+    bench_emit(c, "    long[] values;\n");
+    if (i != 0) {
+        bench_emit(c, "    node_%zu* next;\n", i - 1);
+    }
+    bench_emit(c, "};\n\n");
+
+    /* constructor function */
+    bench_emit(c, "node_%zu* make_%zu(long id) {\n", i, i);
+    bench_emit(c, "    return new node_%zu(id, 0, %d.5, kind_%zu.KIND_%zu_%c, new long[4](id, id + 1, id * 2, %d)",
+        i, (int) bench_random(c, 10), i, i, 'A' + (int) bench_random(c, 3), (int) bench_random(c, 100));
+    if (i != 0) {
+        bench_emit(c, ", make_%zu(id + 1)", i - 1);
+    }
+    bench_emit(c, ");\n");
+    bench_emit(c, "}\n\n");
+
+    /* function with loops, branches and nested expressions */
+    bench_emit(c, "long compute_%zu(node_%zu* node, long n) {\n", i, i);
+    bench_emit(c, "    long a = n * 3 + 1;\n");
+    bench_emit(c, "    long b = node->id - (a %% 7);\n");
+    bench_emit(c, "    long count = 0;\n");
+    int loops = 1 + (int) bench_random(c, 3);
+    for (int loop = 0; loop < loops; loop++) {
+        bench_emit(c, "    while (count < n) {\n");
+        bench_emit(c, "        if (");
+        corpus_expression(c, CORPUS_EXPRESSION_DEPTH);
+        bench_emit(c, " > ");
+        corpus_expression(c, CORPUS_EXPRESSION_DEPTH - 1);
+        bench_emit(c, " && node->kind != kind_%zu.KIND_%zu_C) {\n", i, i);
+        bench_emit(c, "            a = ");
+        corpus_expression(c, CORPUS_EXPRESSION_DEPTH);
+        bench_emit(c, ";\n");
+        bench_emit(c, "        } else {\n");
+        bench_emit(c, "            b += node->values[count %% 4] * ");
+        corpus_expression(c, CORPUS_EXPRESSION_DEPTH - 1);
+        bench_emit(c, ";\n");
+        bench_emit(c, "        }\n");
+        bench_emit(c, "        count++;\n");
+        bench_emit(c, "    }\n");
+    }
+    bench_emit(c, "    node->total = a + b;\n");
+    if (i != 0) {
+        bench_emit(c, "    return compute_%zu(node->next, a) + ", i - 1);
+    } else {
+        bench_emit(c, "    return ");
+    }
+    corpus_expression(c, CORPUS_EXPRESSION_DEPTH);
+    bench_emit(c, ";\n");
+    bench_emit(c, "}\n\n");
+
+    /* generic structure with two implementations */
+    if (i % CORPUS_GENERIC_INTERVAL == 0) {
+        bench_emit(c, "type box_%zu<T> {\n", i);
+        bench_emit(c, "    T value;\n");
+        bench_emit(c, "    long count;\n");
+        bench_emit(c, "};\n\n");
+
+        bench_emit(c, "long unbox_%zu(box_%zu<long>* value, box_%zu<double> other) {\n", i, i, i);
+        bench_emit(c, "    box_%zu<long> local = box_%zu<long>(value->value + %d, value->count);\n",
+            i, i, (int) bench_random(c, 100));
+        bench_emit(c, "    return local.value * other.count;\n");
+        bench_emit(c, "}\n\n");
+    }
+}
+
+    /* functions */
+/**
+ * Generates a synthetic corpus
+ *
+ * @param argc Number of arguments
+ * @param argv Arguments (line count, output filename and seed)
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 3 || argc > 4) {
+        fprintf(stderr, "Usage: %s <lines> <output> [seed]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    char* end;
+    unsigned long long target = strtoull(argv[1], &end, 10);
+    if (*end != '\0' || target == 0) {
+        fprintf(stderr, "Invalid line count: %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    bench_writer c;
+    c.state = CORPUS_DEFAULT_SEED;
+    if (argc == 4) {
+        c.state = strtoull(argv[3], &end, 0);
+        if (*end != '\0' || c.state == 0) {
+            fprintf(stderr, "Invalid seed: %s\n", argv[3]);
+            return EXIT_FAILURE;
+        }
+    }
+    c.lines = 0;
+    c.file = fopen(argv[2], "w");
+    if (c.file == NULL) {
+        fprintf(stderr, "Unable to open file %s for output\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    /* units, then the entry point which uses the last one */
+    size_t units = 0;
+    do {
+        corpus_unit(&c, units++);
+    } while (c.lines + 4 < target);
+
+    bench_emit(&c, "int main() {\n");
+    bench_emit(&c, "    node_%zu* root = make_%zu(0);\n", units - 1, units - 1);
+    bench_emit(&c, "    return (int) (compute_%zu(root, 10) %% 100);\n", units - 1);
+    bench_emit(&c, "}\n");
+
+    if (fclose(c.file) != 0) {
+        fprintf(stderr, "Unable to write to file %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,262 @@
+/**
+ * @file graph.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Import graph generator for the compiler benchmarks
+ *
+ *  Writes a program of modules arranged in levels of the
+ *  same width. Module i of a level imports module i of the
+ *  next level and, with the diamond probability, each other
+ *  module of the next level, so modules of the lower levels
+ *  are reached through many paths. Every module also imports
+ *  the same native header. The entry point main.cst imports
+ *  the first level.
+ *
+ *  A module declares a structure and functions which use
+ *  the structures and functions of its imports.
+ *
+ *  The output only depends on the arguments. A summary with
+ *  the numbers of modules, import edges and lines is printed
+ *  to the standard output.
+ *
+ *  Usage: carbonsteel-graph <directory> <width> <depth> <diamond percent> [seed]
+ */
+    /* includes */
+#include <stdbool.h> /* boolean */
+#include <stdio.h> /* file functions */
+#include <stdlib.h> /* number parsing */
+#include <sys/stat.h> /* directories */
+
+#include "run.h" /* generator helpers */
+
+    /* defines */
+/**
+ * Default seed of the generator
+ */
+#define GRAPH_DEFAULT_SEED 0x5eed
+
+/**
+ * Number of helper functions of a module
+ */
+#define GRAPH_MODULE_FUNCTIONS 4
+
+/**
+ * Native header imported by every module
+ */
+#define GRAPH_NATIVE_HEADER "stdio"
+
+    /* typedefs */
+/**
+ * Generator state
+ */
+typedef struct graph {
+    const char* directory;
+    unsigned long width;
+    unsigned long depth;
+    unsigned long diamonds; /* percent */
+    bench_writer writer; /* the current module */
+    unsigned long long modules;
+    unsigned long long imports;
+} graph;
+
+    /* internal functions */
+/**
+ * Creates a module file and makes it the current one
+ *
+ * @param[in] g    Pointer to the generator
+ * @param[in] name Name of the module
+ *
+ * @return false if the file could not be created
+ */
+static bool graph_open(graph* g, const char* name) {
+    char path[BENCH_PATH_SIZE];
+    snprintf(path, sizeof(path), "%s/%s.cst", g->directory, name);
+    g->writer.file = fopen(path, "w");
+    if (g->writer.file == NULL) {
+        fprintf(stderr, "Unable to open file %s for output\n", path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Closes the current module
+ *
+ * @param[in] g Pointer to the generator
+ *
+ * @return false if the file could not be written
+ */
+static bool graph_close(graph* g) {
+    bool result = fclose(g->writer.file) == 0;
+    if (!result) {
+        fprintf(stderr, "Unable to write a module to %s\n", g->directory);
+    }
+    return result;
+}
+
+/**
+ * Writes a module
+ *
+ * @param[in] g     Pointer to the generator
+ * @param[in] level Level of the module
+ * @param[in] index Index of the module in its level
+ *
+ * @return false if the module could not be written
+ */
+static bool graph_module(graph* g, unsigned long level, unsigned long index) {
+    char name[64];
+    snprintf(name, sizeof(name), "m_%lu_%lu", level, index);
+    if (!graph_open(g, name)) {
+        return false;
+    }
+    g->modules++;
+
+    /* the imported modules of the next level, the first one is always imported */
+    bool is_leaf = level + 1 == g->depth;
+    unsigned long children[g->width];
+    unsigned long child_count = 0;
+    if (!is_leaf) {
+        for (unsigned long k = 0; k < g->width; k++) {
+            if (k == 0 || bench_random(&g->writer, 100) < g->diamonds) {
+                children[child_count++] = (index + k) % g->width;
+            }
+        }
+    }
+
+    bench_emit(&g->writer, "import native " GRAPH_NATIVE_HEADER ";\n");
+    for (unsigned long i = 0; i < child_count; i++) {
+        bench_emit(&g->writer, "import m_%lu_%lu;\n", level + 1, children[i]);
+    }
+    g->imports += child_count + 1;
+    bench_emit(&g->writer, "\n");
+
+    /* structure */
+    bench_emit(&g->writer, "type t_%lu_%lu {\n", level, index);
+    bench_emit(&g->writer, "    long value;\n");
+    bench_emit(&g->writer, "    long weight;\n");
+    bench_emit(&g->writer, "};\n\n");
+
+    /* helper functions */
+    for (int f = 0; f < GRAPH_MODULE_FUNCTIONS; f++) {
+        bench_emit(&g->writer, "long h_%lu_%lu_%d(t_%lu_%lu* node, long n) {\n", level, index, f, level, index);
+        bench_emit(&g->writer, "    long total = node->value;\n");
+        bench_emit(&g->writer, "    while (n > 0) {\n");
+        bench_emit(&g->writer, "        total += (node->weight * %d + n) %% %d;\n",
+            (int) bench_random(&g->writer, 9) + 1, (int) bench_random(&g->writer, 97) + 2);
+        bench_emit(&g->writer, "        n--;\n");
+        bench_emit(&g->writer, "    }\n");
+        bench_emit(&g->writer, "    return total;\n");
+        bench_emit(&g->writer, "}\n\n");
+    }
+
+    /* entry function of the module, which uses every import */
+    bench_emit(&g->writer, "long f_%lu_%lu(long n) {\n", level, index);
+    bench_emit(&g->writer, "    t_%lu_%lu node = t_%lu_%lu(n, %d);\n", level, index, level, index, (int) bench_random(&g->writer, 100));
+    bench_emit(&g->writer, "    long total = h_%lu_%lu_0(&node, n);\n", level, index);
+    for (unsigned long i = 0; i < child_count; i++) {
+        bench_emit(&g->writer, "    t_%lu_%lu child_%lu = t_%lu_%lu(n, %lu);\n",
+            level + 1, children[i], i, level + 1, children[i], i);
+        bench_emit(&g->writer, "    total += f_%lu_%lu(n - 1) + child_%lu.weight;\n", level + 1, children[i], i);
+    }
+    bench_emit(&g->writer, "    if (total > 1000) {\n");
+    bench_emit(&g->writer, "        puts(\"%s\");\n", name);
+    bench_emit(&g->writer, "    }\n");
+    bench_emit(&g->writer, "    return total;\n");
+    bench_emit(&g->writer, "}\n");
+
+    return graph_close(g);
+}
+
+/**
+ * Parses a positive number argument
+ *
+ * @param[in]  value   The argument
+ * @param[in]  name    Name of the argument for errors
+ * @param[in]  maximum The largest allowed value
+ * @param[out] result  The number
+ *
+ * @return false if the argument is invalid
+ */
+static bool graph_parse(const char* value, const char* name, unsigned long maximum, unsigned long* result) {
+    char* end;
+    *result = strtoul(value, &end, 10);
+    if (*end != '\0' || *result > maximum) {
+        fprintf(stderr, "Invalid %s: %s, must be up to %lu\n", name, value, maximum);
+        return false;
+    }
+    return true;
+}
+
+    /* functions */
+/**
+ * Generates an import graph
+ *
+ * @param argc Number of arguments
+ * @param argv Arguments (directory, graph shape and seed)
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 5 || argc > 6) {
+        fprintf(stderr, "Usage: %s <directory> <width> <depth> <diamond percent> [seed]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    graph g;
+    g.directory = argv[1];
+    if (!graph_parse(argv[2], "width", 4096, &g.width)
+            || !graph_parse(argv[3], "depth", 4096, &g.depth)
+            || !graph_parse(argv[4], "diamond percent", 100, &g.diamonds)) {
+        return EXIT_FAILURE;
+    }
+    if (g.width == 0 || g.depth == 0) {
+        fprintf(stderr, "The width and the depth must be positive\n");
+        return EXIT_FAILURE;
+    }
+    g.writer.state = GRAPH_DEFAULT_SEED;
+    if (argc == 6) {
+        char* end;
+        g.writer.state = strtoull(argv[5], &end, 0);
+        if (*end != '\0' || g.writer.state == 0) {
+            fprintf(stderr, "Invalid seed: %s\n", argv[5]);
+            return EXIT_FAILURE;
+        }
+    }
+    g.modules = 0;
+    g.imports = 0;
+    g.writer.lines = 0;
+    mkdir(g.directory, 0755);
+
+    /* modules, level by level */
+    for (unsigned long level = 0; level < g.depth; level++) {
+        for (unsigned long index = 0; index < g.width; index++) {
+            if (!graph_module(&g, level, index)) {
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    /* the entry point imports the first level */
+    if (!graph_open(&g, "main")) {
+        return EXIT_FAILURE;
+    }
+    bench_emit(&g.writer, "import native " GRAPH_NATIVE_HEADER ";\n");
+    for (unsigned long index = 0; index < g.width; index++) {
+        bench_emit(&g.writer, "import m_0_%lu;\n", index);
+    }
+    g.imports += g.width + 1;
+    bench_emit(&g.writer, "\n");
+    bench_emit(&g.writer, "int main() {\n");
+    bench_emit(&g.writer, "    long total = 0;\n");
+    for (unsigned long index = 0; index < g.width; index++) {
+        bench_emit(&g.writer, "    total += f_0_%lu(10);\n", index);
+    }
+    bench_emit(&g.writer, "    return (int) (total %% 100);\n");
+    bench_emit(&g.writer, "}\n");
+    if (!graph_close(&g)) {
+        return EXIT_FAILURE;
+    }
+
+    printf("modules %llu imports %llu lines %llu\n", g.modules + 1, g.imports, g.writer.lines);
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,258 @@
+/**
+ * @file imports.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Import graph scaling benchmark
+ *
+ *  For every graph shape, generates an import graph and
+ *  compiles its entry point several times without the
+ *  persistent caches and several times with a warm module
+ *  and native header cache. Without the persistent caches,
+ *  a compilation still parses every module only once and
+ *  links its repeated imports from the in-process module
+ *  cache, so the uncached runs measure a cold compilation.
+ *  An untimed run with --stats counts the imports which
+ *  have been parsed and rejected as repeated.
+ *
+ *  The results are printed as a table, with the time per
+ *  module showing how the compilation scales with the graph,
+ *  and written as a JSON baseline.
+ *
+ *  Usage: carbonsteel-imports <carbonsteel> <graph generator>
+ *             <work directory> <baseline> [-r repeats] [WIDTHxDEPTHxDIAMONDS...]
+ */
+    /* includes */
+#include <stdio.h> /* file functions */
+#include <stdlib.h> /* environment */
+#include <sys/stat.h> /* directories */
+
+#include "run.h" /* process helpers */
+
+    /* defines */
+/**
+ * Maximum number of graph shapes
+ */
+#define BENCH_MAX_GRAPHS 32
+
+    /* typedefs */
+/**
+ * Shape of an import graph
+ */
+typedef struct bench_graph {
+    unsigned long width;
+    unsigned long depth;
+    unsigned long diamonds; /* percent */
+} bench_graph;
+
+/**
+ * Measurements of a cache configuration
+ */
+typedef struct bench_timing {
+    double seconds; /* median wall time */
+    unsigned long long peak_rss; /* bytes */
+} bench_timing;
+
+/**
+ * Result of a graph shape
+ */
+typedef struct bench_result {
+    bench_graph graph;
+    unsigned long long modules;
+    unsigned long long edges;   /* import declarations */
+    unsigned long long lines;
+    unsigned long long imports; /* imports handled by the compiler */
+    unsigned long long repeat_imports;
+    unsigned long long linked_imports;
+    bench_timing uncached;
+    bench_timing cached;
+} bench_result;
+
+    /* global variables */
+/**
+ * Default graph shapes, growing in width, depth and diamonds
+ */
+static const bench_graph bench_default_graphs[] = {
+    { 2, 2, 25 }, { 4, 3, 25 }, { 8, 4, 25 }, { 16, 5, 25 }, { 32, 6, 25 },
+    { 16, 5, 0 }, { 16, 5, 50 }, { 16, 5, 100 }
+};
+
+    /* internal functions */
+/**
+ * Reads the summary printed by the graph generator
+ *
+ * @param[in]  filename Name of the summary
+ * @param[out] result   Pointer to the result
+ *
+ * @return false if the summary is invalid
+ */
+static bool bench_read_summary(const char* filename, bench_result* result) {
+    FILE* file = fopen(filename, "r");
+    if (file == NULL) {
+        return false;
+    }
+    bool is_valid = fscanf(file, "modules %llu imports %llu lines %llu",
+        &result->modules, &result->edges, &result->lines) == 3;
+    fclose(file);
+    return is_valid;
+}
+
+/**
+ * Benchmarks a graph shape
+ *
+ * @param[in]  compiler  Path to the compiler
+ * @param[in]  generator Path to the graph generator
+ * @param[in]  directory The work directory
+ * @param[in]  repeats   Number of timed compilations
+ * @param[out] result    Pointer to the result with the graph shape
+ *
+ * @return false if the generator or the compiler have failed
+ */
+static bool bench_graph_run(char* compiler, char* generator, const char* directory,
+        int repeats, bench_result* result) {
+    bench_graph* shape = &result->graph;
+    char width[32], depth[32], diamonds[32];
+    char root[BENCH_PATH_SIZE - 16], summary[BENCH_PATH_SIZE], cache[BENCH_PATH_SIZE];
+    char input[BENCH_PATH_SIZE], output[BENCH_PATH_SIZE], report[BENCH_PATH_SIZE];
+    snprintf(width, sizeof(width), "%lu", shape->width);
+    snprintf(depth, sizeof(depth), "%lu", shape->depth);
+    snprintf(diamonds, sizeof(diamonds), "%lu", shape->diamonds);
+    snprintf(root, sizeof(root), "%s/graph-%lux%lux%lu", directory, shape->width, shape->depth, shape->diamonds);
+    snprintf(summary, sizeof(summary), "%s.summary", root);
+    snprintf(cache, sizeof(cache), "%s.cache", root);
+    snprintf(input, sizeof(input), "%s/main.cst", root);
+    snprintf(output, sizeof(output), "%s.c", root);
+    snprintf(report, sizeof(report), "%s.stats", root);
+
+    /* generate the graph */
+    char* generate[] = { generator, root, width, depth, diamonds, NULL };
+    if (!bench_run(generate, summary, NULL, NULL, NULL) || !bench_read_summary(summary, result)) {
+        return false;
+    }
+
+    /* without the caches, an empty cache directory disables them */
+    setenv("CARBONSTEEL_CACHE_DIR", "", 1);
+    char* count[] = { compiler, "forge", "--stats", input, "-o", output, NULL };
+    if (!bench_run(count, NULL, report, NULL, NULL)) {
+        return false;
+    }
+    result->imports = bench_read_stat(report, "imports");
+    result->repeat_imports = bench_read_stat(report, "repeat rejections");
+
+    char* forge[] = { compiler, "forge", input, "-o", output, NULL };
+    if (!bench_repeat(forge, repeats, &result->uncached.seconds, &result->uncached.peak_rss)) {
+        return false;
+    }
+
+    /* with caches warmed by untimed runs, the second one counts the linked imports */
+    setenv("CARBONSTEEL_CACHE_DIR", cache, 1);
+    if (!bench_run(count, NULL, report, NULL, NULL)) {
+        return false;
+    }
+    if (!bench_run(count, NULL, report, NULL, NULL)) {
+        return false;
+    }
+    result->linked_imports = bench_read_stat(report, "linked from modules");
+    if (!bench_repeat(forge, repeats, &result->cached.seconds, &result->cached.peak_rss)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Parses a graph shape argument
+ *
+ * @param[in]  value   The argument
+ * @param[out] results The results with the graph shapes
+ * @param[in]  index   Index of the parsed shape
+ *
+ * @return false if the shape is invalid
+ */
+static bool bench_parse_graph(const char* value, void* results, size_t index) {
+    bench_graph* shape = &((bench_result*) results)[index].graph;
+    char end;
+    if (sscanf(value, "%lux%lux%lu%c", &shape->width, &shape->depth, &shape->diamonds, &end) != 3
+            || shape->width == 0 || shape->depth == 0 || shape->diamonds > 100) {
+        fprintf(stderr, "Invalid graph shape: %s, must be WIDTHxDEPTHxDIAMONDS\n", value);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Writes the fields of a graph shape result into the baseline
+ *
+ * @param[in] file   The baseline
+ * @param[in] result Pointer to the result
+ */
+static void bench_write_result(FILE* file, const void* result) {
+    const bench_result* r = result;
+    fprintf(file, "\"width\": %lu, \"depth\": %lu, \"diamond_percent\": %lu, "
+        "\"modules\": %llu, \"edges\": %llu, \"lines\": %llu, "
+        "\"imports\": %llu, \"repeat_imports\": %llu, \"linked_imports\": %llu, "
+        "\"uncached_seconds\": %.6f, \"uncached_peak_rss_bytes\": %llu, "
+        "\"cached_seconds\": %.6f, \"cached_peak_rss_bytes\": %llu",
+        r->graph.width, r->graph.depth, r->graph.diamonds,
+        r->modules, r->edges, r->lines, r->imports, r->repeat_imports, r->linked_imports,
+        r->uncached.seconds, r->uncached.peak_rss, r->cached.seconds, r->cached.peak_rss);
+}
+
+    /* functions */
+/**
+ * Runs the benchmark
+ *
+ * @param argc Number of arguments
+ * @param argv Arguments (programs, directories, options and graph shapes)
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <carbonsteel> <graph generator> <work directory> <baseline> "
+            "[-r repeats] [WIDTHxDEPTHxDIAMONDS...]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    char* compiler = argv[1];
+    char* generator = argv[2];
+    const char* directory = argv[3];
+    const char* baseline = argv[4];
+
+    /* options and graph shapes */
+    int repeats = BENCH_DEFAULT_REPEATS;
+    bench_result results[BENCH_MAX_GRAPHS];
+    size_t count;
+    if (!bench_parse_arguments(argc, argv, 5, bench_parse_graph, results, BENCH_MAX_GRAPHS, &count, &repeats)) {
+        return EXIT_FAILURE;
+    }
+    if (count == 0) {
+        count = sizeof(bench_default_graphs) / sizeof(*bench_default_graphs);
+        for (size_t i = 0; i < count; i++) {
+            results[i].graph = bench_default_graphs[i];
+        }
+    }
+    mkdir(directory, 0755);
+
+    /* run */
+    printf("%-12s %8s %8s %8s %10s %12s %12s %12s %12s %12s\n", "graph", "modules", "edges", "imports",
+        "rejected", "uncached s", "cached s", "ms/module", "uncached RSS", "cached RSS");
+    for (size_t i = 0; i < count; i++) {
+        bench_result* r = &results[i];
+        if (!bench_graph_run(compiler, generator, directory, repeats, r)) {
+            fprintf(stderr, "Benchmark of graph %lux%lux%lu has failed\n",
+                r->graph.width, r->graph.depth, r->graph.diamonds);
+            return EXIT_FAILURE;
+        }
+        char shape[64];
+        snprintf(shape, sizeof(shape), "%lux%lux%lu", r->graph.width, r->graph.depth, r->graph.diamonds);
+        printf("%-12s %8llu %8llu %8llu %10llu %12.3f %12.3f %12.3f %12llu %12llu\n", shape,
+            r->modules, r->edges, r->imports, r->repeat_imports, r->uncached.seconds, r->cached.seconds,
+            1e3 * r->uncached.seconds / r->modules, r->uncached.peak_rss, r->cached.peak_rss);
+        fflush(stdout);
+    }
+
+    if (!bench_write_baseline(baseline, "imports", repeats, results, sizeof(bench_result), count, bench_write_result)) {
+        fprintf(stderr, "Unable to write the baseline %s\n", baseline);
+        return EXIT_FAILURE;
+    }
+    printf("baseline written to %s\n", baseline);
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,321 @@
+/**
+ * @file run.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Process, measurement and generator helpers of the benchmarks implementation
+ */
+    /* includes */
+#include "run.h" /* this */
+
+#include <fcntl.h> /* file control */
+#include <stdarg.h> /* variable arguments */
+#include <stdio.h> /* file functions */
+#include <stdlib.h> /* sorting */
+#include <string.h> /* string functions */
+#include <time.h> /* clock */
+#include <unistd.h> /* process functions */
+#include <sys/resource.h> /* resource usage */
+#include <sys/stat.h> /* file size */
+#include <sys/wait.h> /* process status */
+
+    /* internal functions */
+/**
+ * Opens the file of a redirected stream
+ *
+ * @param[in] filename Name of the file, NULL for /dev/null
+ *
+ * @return The file descriptor
+ */
+static int bench_open(const char* filename) {
+    if (filename == NULL) {
+        return open("/dev/null", O_WRONLY);
+    }
+    return open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
+/**
+ * Orders wall times
+ */
+static int bench_compare_times(const void* a, const void* b) {
+    double at = *(const double*) a;
+    double bt = *(const double*) b;
+    return at < bt ? -1 : at > bt ? 1 : 0;
+}
+
+/**
+ * Parses the number of timed runs of a -r option
+ *
+ * @param[in]  value   The option value
+ * @param[out] repeats The number of runs
+ *
+ * @return false if the value is invalid
+ */
+static bool bench_parse_repeats(const char* value, int* repeats) {
+    char* end;
+    long result = strtol(value, &end, 10);
+    if (*end != '\0' || result < 1 || result > BENCH_MAX_REPEATS) {
+        fprintf(stderr, "Invalid number of repeats: %s, must be from 1 to %d\n", value, BENCH_MAX_REPEATS);
+        return false;
+    }
+    *repeats = result;
+    return true;
+}
+
+    /* functions */
+/**
+ * Reads the monotonic clock
+ *
+ * @return The time in seconds
+ */
+double bench_now() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * Runs a program and waits for it
+ *
+ * @param[in]  argv    Arguments, starting with the program
+ * @param[in]  output  File for the standard output, NULL to discard it
+ * @param[in]  errors  File for the standard error, NULL to discard it
+ * @param[out] seconds Wall time of the program, may be NULL
+ * @param[out] rss     Peak resident set size in bytes, may be NULL
+ *
+ * @return true if the program has exited successfully
+ */
+bool bench_run(char* const argv[], const char* output, const char* errors,
+        double* seconds, unsigned long long* rss) {
+    double start = bench_now();
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return false;
+    }
+    if (pid == 0) {
+        int out = bench_open(output);
+        int error = bench_open(errors);
+        if (out < 0 || error < 0) {
+            _exit(127);
+        }
+        dup2(out, STDOUT_FILENO);
+        dup2(error, STDERR_FILENO);
+        execv(argv[0], argv);
+        _exit(127);
+    }
+
+    int status;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) < 0) {
+        perror("wait4");
+        return false;
+    }
+    if (seconds != NULL) {
+        *seconds = bench_now() - start;
+    }
+    if (rss != NULL) {
+        *rss = (unsigned long long) usage.ru_maxrss * 1024;
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "%s has failed with status %d\n", argv[0], status);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Runs a compilation several times
+ *
+ * @param[in]  argv    Arguments, starting with the compiler
+ * @param[in]  repeats Number of runs
+ * @param[out] seconds Median wall time of the runs
+ * @param[out] rss     Largest peak resident set size of the runs in bytes
+ *
+ * @return false if a run has failed
+ */
+bool bench_repeat(char* const argv[], int repeats, double* seconds, unsigned long long* rss) {
+    double times[BENCH_MAX_REPEATS];
+    *rss = 0;
+    for (int i = 0; i < repeats; i++) {
+        unsigned long long run_rss;
+        if (!bench_run(argv, NULL, NULL, &times[i], &run_rss)) {
+            return false;
+        }
+        if (run_rss > *rss) {
+            *rss = run_rss;
+        }
+    }
+    qsort(times, repeats, sizeof(double), bench_compare_times);
+    *seconds = times[repeats / 2];
+    return true;
+}
+
+/**
+ * Returns the size of a file
+ *
+ * @param[in] filename Name of the file
+ */
+unsigned long long bench_file_size(const char* filename) {
+    struct stat info;
+    return stat(filename, &info) == 0 ? (unsigned long long) info.st_size : 0;
+}
+
+/**
+ * Counts the lines of a file
+ *
+ * @param[in] filename Name of the file
+ */
+unsigned long long bench_file_lines(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (file == NULL) {
+        return 0;
+    }
+    unsigned long long lines = 0;
+    int c;
+    while ((c = getc(file)) != EOF) {
+        if (c == '\n') {
+            lines++;
+        }
+    }
+    fclose(file);
+    return lines;
+}
+
+/**
+ * Reads the first count with a name from a --stats report,
+ * the first "total" is the token count
+ *
+ * @param[in] filename Name of the report
+ * @param[in] name     Name of the count
+ *
+ * @return The count, or 0 if it is missing
+ */
+unsigned long long bench_read_stat(const char* filename, const char* name) {
+    FILE* file = fopen(filename, "r");
+    if (file == NULL) {
+        return 0;
+    }
+    char line[1024];
+    unsigned long long count = 0;
+    size_t length = strlen(name);
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char* label = line + strspn(line, " ");
+        if (strncmp(label, name, length) == 0 && label[length] == ' '
+                && sscanf(label + length, " %llu", &count) == 1) {
+            break;
+        }
+    }
+    fclose(file);
+    return count;
+}
+
+/**
+ * Returns a rate per second
+ *
+ * @param[in] count   The count
+ * @param[in] seconds The time in seconds
+ */
+double bench_rate(unsigned long long count, double seconds) {
+    return seconds > 0 ? count / seconds : 0;
+}
+
+/**
+ * Parses the options and inputs of a benchmark,
+ * the -r option sets the number of timed runs
+ *
+ * @param[in]  argc    Number of arguments
+ * @param[in]  argv    Arguments
+ * @param[in]  first   Index of the first option or input
+ * @param[in]  parse   The input parser
+ * @param[out] inputs  The inputs
+ * @param[in]  max     Maximum number of inputs
+ * @param[out] count   Number of inputs
+ * @param[out] repeats The number of runs, unchanged if there is no -r option
+ *
+ * @return false if an argument is invalid
+ */
+bool bench_parse_arguments(int argc, char* argv[], int first, bench_input_parser parse,
+        void* inputs, size_t max, size_t* count, int* repeats) {
+    *count = 0;
+    for (int i = first; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            if (!bench_parse_repeats(argv[++i], repeats)) {
+                return false;
+            }
+            continue;
+        }
+        if (*count == max) {
+            fprintf(stderr, "Too many inputs: %s, at most %zu are allowed\n", argv[i], max);
+            return false;
+        }
+        if (!parse(argv[i], inputs, *count)) {
+            return false;
+        }
+        (*count)++;
+    }
+    return true;
+}
+
+/**
+ * Writes the results of a benchmark as a JSON baseline
+ *
+ * @param[in] filename Name of the baseline
+ * @param[in] name     Name of the benchmark
+ * @param[in] repeats  Number of timed compilations
+ * @param[in] results  The results
+ * @param[in] size     Size of a result
+ * @param[in] count    Number of results
+ * @param[in] write    The result writer
+ *
+ * @return false if the baseline could not be written
+ */
+bool bench_write_baseline(const char* filename, const char* name, int repeats,
+        const void* results, size_t size, size_t count, bench_result_writer write) {
+    FILE* file = fopen(filename, "w");
+    if (file == NULL) {
+        return false;
+    }
+    fprintf(file, "{\n  \"benchmark\": \"%s\",\n  \"format\": 1,\n  \"repeats\": %d,\n  \"results\": [", name, repeats);
+    for (size_t i = 0; i < count; i++) {
+        fprintf(file, "%s\n    {", i == 0 ? "" : ",");
+        write(file, (const char*) results + size * i);
+        fprintf(file, "}");
+    }
+    fprintf(file, "\n  ]\n}\n");
+    return fclose(file) == 0;
+}
+
+/**
+ * Returns the next pseudo-random number of a generator
+ *
+ * @param[in] w     Pointer to the generator output
+ * @param[in] limit The exclusive upper bound
+ */
+uint64_t bench_random(bench_writer* w, uint64_t limit) {
+    w->state ^= w->state << 13;
+    w->state ^= w->state >> 7;
+    w->state ^= w->state << 17;
+    return w->state % limit;
+}
+
+/**
+ * Writes formatted text and counts its lines,
+ * the arguments must not contain line breaks
+ *
+ * @param[in] w      Pointer to the generator output
+ * @param[in] format The format string
+ */
+void bench_emit(bench_writer* w, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vfprintf(w->file, format, args);
+    va_end(args);
+
+    for (const char* i = format; *i != '\0'; i++) {
+        if (*i == '\n') {
+            w->lines++;
+        }
+    }
+}
\ No newline at end of file
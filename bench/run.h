@@ -0,0 +1,182 @@
+/**
+ * @file run.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Process, measurement and generator helpers of the benchmarks
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_BENCH_RUN_H
+#define CARBONSTEEL_BENCH_RUN_H
+
+    /* includes */
+#include <stdbool.h> /* boolean */
+#include <stddef.h> /* size type */
+#include <stdint.h> /* integer types */
+#include <stdio.h> /* file functions */
+
+    /* defines */
+/**
+ * Default number of timed compilations of each input
+ */
+#define BENCH_DEFAULT_REPEATS 3
+
+/**
+ * Maximum number of timed compilations of each input
+ */
+#define BENCH_MAX_REPEATS 64
+
+/**
+ * Maximum length of a path
+ */
+#define BENCH_PATH_SIZE 4096
+
+    /* typedefs */
+/**
+ * Output of a program generator
+ */
+typedef struct bench_writer {
+    FILE* file;
+    uint64_t state; /* xorshift state */
+    unsigned long long lines;
+} bench_writer;
+
+/**
+ * Parses a benchmark input argument
+ *
+ * @param[in]  value  The argument
+ * @param[out] inputs The inputs
+ * @param[in]  index  Index of the parsed input
+ *
+ * @return false if the argument is invalid
+ */
+typedef bool (*bench_input_parser)(const char* value, void* inputs, size_t index);
+
+/**
+ * Writes the fields of a result into a JSON baseline
+ *
+ * @param[in] file   The baseline
+ * @param[in] result Pointer to the result
+ */
+typedef void (*bench_result_writer)(FILE* file, const void* result);
+
+    /* functions */
+/**
+ * Reads the monotonic clock
+ *
+ * @return The time in seconds
+ */
+double bench_now();
+
+/**
+ * Runs a program and waits for it
+ *
+ * @param[in]  argv    Arguments, starting with the program
+ * @param[in]  output  File for the standard output, NULL to discard it
+ * @param[in]  errors  File for the standard error, NULL to discard it
+ * @param[out] seconds Wall time of the program, may be NULL
+ * @param[out] rss     Peak resident set size in bytes, may be NULL
+ *
+ * @return true if the program has exited successfully
+ */
+bool bench_run(char* const argv[], const char* output, const char* errors,
+    double* seconds, unsigned long long* rss);
+
+/**
+ * Runs a compilation several times
+ *
+ * @param[in]  argv    Arguments, starting with the compiler
+ * @param[in]  repeats Number of runs
+ * @param[out] seconds Median wall time of the runs
+ * @param[out] rss     Largest peak resident set size of the runs in bytes
+ *
+ * @return false if a run has failed
+ */
+bool bench_repeat(char* const argv[], int repeats, double* seconds, unsigned long long* rss);
+
+/**
+ * Returns the size of a file
+ *
+ * @param[in] filename Name of the file
+ */
+unsigned long long bench_file_size(const char* filename);
+
+/**
+ * Counts the lines of a file
+ *
+ * @param[in] filename Name of the file
+ */
+unsigned long long bench_file_lines(const char* filename);
+
+/**
+ * Reads the first count with a name from a --stats report,
+ * the first "total" is the token count
+ *
+ * @param[in] filename Name of the report
+ * @param[in] name     Name of the count
+ *
+ * @return The count, or 0 if it is missing
+ */
+unsigned long long bench_read_stat(const char* filename, const char* name);
+
+/**
+ * Returns a rate per second
+ *
+ * @param[in] count   The count
+ * @param[in] seconds The time in seconds
+ */
+double bench_rate(unsigned long long count, double seconds);
+
+/**
+ * Parses the options and inputs of a benchmark,
+ * the -r option sets the number of timed runs
+ *
+ * @param[in]  argc    Number of arguments
+ * @param[in]  argv    Arguments
+ * @param[in]  first   Index of the first option or input
+ * @param[in]  parse   The input parser
+ * @param[out] inputs  The inputs
+ * @param[in]  max     Maximum number of inputs
+ * @param[out] count   Number of inputs
+ * @param[out] repeats The number of runs, unchanged if there is no -r option
+ *
+ * @return false if an argument is invalid
+ */
+bool bench_parse_arguments(int argc, char* argv[], int first, bench_input_parser parse,
+    void* inputs, size_t max, size_t* count, int* repeats);
+
+/**
+ * Writes the results of a benchmark as a JSON baseline
+ *
+ * @param[in] filename Name of the baseline
+ * @param[in] name     Name of the benchmark
+ * @param[in] repeats  Number of timed compilations
+ * @param[in] results  The results
+ * @param[in] size     Size of a result
+ * @param[in] count    Number of results
+ * @param[in] write    The result writer
+ *
+ * @return false if the baseline could not be written
+ */
+bool bench_write_baseline(const char* filename, const char* name, int repeats,
+    const void* results, size_t size, size_t count, bench_result_writer write);
+
+/**
+ * Returns the next pseudo-random number of a generator
+ *
+ * @param[in] w     Pointer to the generator output
+ * @param[in] limit The exclusive upper bound
+ */
+uint64_t bench_random(bench_writer* w, uint64_t limit);
+
+/**
+ * Writes formatted text and counts its lines,
+ * the arguments must not contain line breaks
+ *
+ * @param[in] w      Pointer to the generator output
+ * @param[in] format The format string
+ */
+void bench_emit(bench_writer* w, const char* format, ...);
+
+#endif /* CARBONSTEEL_BENCH_RUN_H */
\ No newline at end of file
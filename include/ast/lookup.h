@@ -25,7 +25,7 @@
  * 
  * @param[in]  context The parser context
  * @param[out] yylval  Sematic value of the token
- * @param[in]  token   The token string
+ * @param[in]  token   The token string, interned
  * 
  * @return Type of the token, or IDENTIFIER
  */
@@ -33,13 +33,13 @@ myytoken_kind_t ast_lex_token(se_context* context, MYYSTYPE* yylval, char* token
 cyytoken_kind_t ast_lex_token_native(se_context* context, CYYSTYPE* yylval, char* token);
 
 /**
- * Iterates the context stack to
+ * Looks up the local symbol table of the context to
  * determine the kind of an identifier
  * and assign its value to the yylval parameter
  * 
  * @param[in]  context Pointer to the parser context
  * @param[out] yylval  Sematic value of the token
- * @param[in]  token   The identifier
+ * @param[in]  token   The identifier, interned
  * 
  * @return Token kind, or -1 if not found
  */
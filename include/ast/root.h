@@ -14,9 +14,20 @@
     /* includes */
 #include "syntax/predeclaration.h" /* predeclarations */
 #include "misc/list.h"             /* list utilities */
-#include "ast/search.h"            /* hash table search */
+#include "ast/symbol.h"            /* symbol table */
 
     /* typedefs */
+/**
+ * Saved contents of a partial value owned by a cached
+ * module, which a tree linking the module has completed
+ */
+typedef struct ast_shared_value {
+    int kind;    /* kind of the declaration */
+    void* value; /* the completed value */
+    void* saved; /* the contents before the completion */
+} ast_shared_value;
+arraylist_declare(ast_shared_value);
+
 /**
  * Abstract syntax tree root
  * that contains the list of all 
@@ -24,9 +35,18 @@
  */
 typedef struct ast_root {
     arraylist(declaration_ptr) declaration_list;
-    struct hsearch_data* hash_table;
+    ast_symbol_table symbol_table;
+    arraylist(ast_shared_value) shared_list; /* restored by ast_restore_shared */
+    bool is_dependent; /* has copied or completed values of cached modules */
 } ast_root;
 
+    /* global variables */
+/**
+ * Number of shared values completed by
+ * all trees that have not been restored yet
+ */
+extern size_t ast_shared_count;
+
     /* functions */
 /**
  * Initializes an abstract syntax tree instance
@@ -62,6 +82,31 @@ declaration* ast_add_declaration(ast_root* ast, int kind, void* value, bool is_n
  */
 void ast_add_identifier(ast_root* ast, int token, int ctoken, declaration* dc);
 
+/**
+ * Adds a native file to the files which declare
+ * a native declaration, if it is not listed yet
+ * 
+ * A header declares every structure and enum it names,
+ * even when another header has declared them first
+ * 
+ * @param[in] dc              Pointer to the declaration
+ * @param[in] native_filename The native file
+ */
+void ast_add_native_filename(declaration* dc, char* native_filename);
+
+/**
+ * Adds a declaration owned by another
+ * abstract syntax tree, such as a cached module
+ * 
+ * The declaration is copied, but its value is shared,
+ * so a declaration linked through several modules
+ * is only added once
+ * 
+ * @param[in] ast    Pointer to the AST
+ * @param[in] source The declaration to link
+ */
+void ast_link_declaration(ast_root* ast, declaration* source);
+
 /**
  * Looks up a declaration by its name
  * 
@@ -85,6 +130,27 @@ declaration* ast_declaration_lookup(ast_root* ast, char* name);
  */
 bool ast_declaration_merge(ast_root* ast, declaration* dc);
 
+/**
+ * Adds a generic implementation to a structure used by the tree,
+ * copying the structure first if it is owned by a cached module
+ * 
+ * @param[in]     ast       Pointer to the AST
+ * @param[in,out] structure The structure, replaced with its copy if needed
+ * @param[in]     impl      The list of types for the generic implementation
+ * 
+ * @return The index of the implementation
+ */
+index_t ast_structure_add_impl(ast_root* ast, dc_structure** structure, list(ast_type) impl);
+
+/**
+ * Restores the shared values completed by the tree,
+ * so that other trees linking the same modules do not
+ * see memory of this one
+ * 
+ * @param[in] ast Pointer to the AST
+ */
+void ast_restore_shared(ast_root* ast);
+
 /**
  * Alias for creating an AST declaration
  * and a lookup table entry
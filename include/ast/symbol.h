@@ -0,0 +1,109 @@
+/**
+ * @file symbol.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ *  Resizable symbol table which maps
+ *  interned identifiers to declarations
+ * 
+ *  The table uses open addressing with linear probing
+ *  and a power-of-two capacity. It grows once the load factor
+ *  exceeds AST_SYMBOL_TABLE_LOAD_FACTOR and removes entries by
+ *  shifting the following ones back, so no tombstones are left.
+ * 
+ *  Keys must be interned strings (see misc/intern.h),
+ *  they are compared by pointer and their cached hashes are used.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_AST_SYMBOL_H
+#define CARBONSTEEL_AST_SYMBOL_H
+
+    /* includes */
+#include <stdint.h>  /* fixed-size integers */
+#include <stdbool.h> /* boolean type */
+#include <stddef.h>  /* size type */
+
+#include "syntax/predeclaration.h" /* predeclarations */
+
+    /* defines */
+/**
+ * Default initial capacity of a symbol table
+ */
+#define AST_SYMBOL_TABLE_DEFAULT_CAPACITY 1024
+
+/**
+ * Maximum load factor in percent,
+ * after which the table doubles its capacity
+ */
+#define AST_SYMBOL_TABLE_LOAD_FACTOR 75
+
+    /* typedefs */
+/**
+ * Symbol table slot, empty if the key is NULL
+ */
+typedef struct ast_symbol {
+    uint64_t hash;
+    char* key;
+    declaration* value;
+} ast_symbol;
+
+/**
+ * Symbol table
+ */
+typedef struct ast_symbol_table {
+    ast_symbol* data;
+    size_t capacity; /* always a power of two */
+    size_t size;
+} ast_symbol_table;
+
+    /* functions */
+/**
+ * Initializes an empty symbol table
+ * 
+ * @param[out] table    Pointer to the table
+ * @param[in]  capacity Initial capacity, rounded up to a power of two
+ */
+void ast_symbol_table_init(ast_symbol_table* table, size_t capacity);
+
+/**
+ * Releases the memory of a symbol table
+ * 
+ * @param[in] table Pointer to the table
+ */
+void ast_symbol_table_free(ast_symbol_table* table);
+
+/**
+ * Looks up a symbol by its name
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] key   Interned name of the symbol
+ * 
+ * @return The declaration or NULL if not found
+ */
+declaration* ast_symbol_table_find(ast_symbol_table* table, char* key);
+
+/**
+ * Adds a new symbol to the table,
+ * growing it if needed
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] key   Interned name of the symbol
+ * @param[in] value The declaration
+ * 
+ * @return false if the symbol already exists (the table is unchanged),
+ *          true if it has been added
+ */
+bool ast_symbol_table_insert(ast_symbol_table* table, char* key, declaration* value);
+
+/**
+ * Removes a symbol from the table
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] key   Interned name of the symbol
+ * 
+ * @return false if the symbol has not been found
+ */
+bool ast_symbol_table_remove(ast_symbol_table* table, char* key);
+
+#endif /* CARBONSTEEL_AST_SYMBOL_H */
@@ -0,0 +1,84 @@
+/**
+ * @file layout.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Compile-time memory layout of types
+ *
+ *  Sizes and alignments follow the generated C code:
+ *  every array or pointer level is a pointer, primitives
+ *  are naturally aligned, enums are int-sized and structure
+ *  members are placed in declaration order with padding.
+ *
+ *  Structure layouts are computed once per generic
+ *  implementation and cached on the structure.
+ *  Native structures are translated without unions,
+ *  bit-fields and attributes, so their layout is left
+ *  to the C compiler and reported as unknown.
+ */
+    /* header guard */
+#ifndef AST_TYPE_LAYOUT_H
+#define AST_TYPE_LAYOUT_H
+
+    /* includes */
+#include "ast/type/type.h" /* lexical type */
+
+    /* typedefs */
+/**
+ * Computation state of a structure layout
+ */
+enum ast_layout_state {
+    AT_LAYOUT_PENDING, AT_LAYOUT_COMPUTING,
+    AT_LAYOUT_KNOWN, AT_LAYOUT_UNKNOWN
+};
+
+/**
+ * Layout of a structure, member
+ * offsets are in declaration order
+ */
+struct ast_layout {
+    ast_layout_state state;
+    size_t size;
+    size_t alignment;
+    size_t* offsets;
+};
+arraylist_declare_functions(ast_layout);
+
+    /* functions */
+/**
+ * Computes the size and the alignment of a type
+ *
+ * @param[in]  value     Pointer to the type
+ * @param[out] size      Size of the type in bytes
+ * @param[out] alignment Alignment of the type in bytes
+ *
+ * @return false if the layout is not known at compile time
+ */
+bool ast_layout_of_type(ast_type* value, size_t* size, size_t* alignment);
+
+/**
+ * Returns the cached layout of a structure,
+ * computing it on first use
+ *
+ * @param[in] structure  The structure
+ * @param[in] impl_index The generic implementation index,
+ *                       ignored for non-generic structures
+ *
+ * @return Pointer to the layout, or NULL if it is not known
+ *          at compile time
+ */
+ast_layout* ast_layout_of_structure(dc_structure* structure, index_t impl_index);
+
+/**
+ * Computes the offset of a structure member
+ *
+ * @param[in]  value  Pointer to the structure type
+ * @param[in]  member Index of the member
+ * @param[out] offset Offset of the member in bytes
+ *
+ * @return false if the layout is not known at compile time
+ */
+bool ast_layout_offset_of(ast_type* value, size_t member, size_t* offset);
+
+#endif /* AST_TYPE_LAYOUT_H */
\ No newline at end of file
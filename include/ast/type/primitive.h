@@ -79,12 +79,14 @@
  * generation.
  * 
  * Size is the size of the primitive type
- * in bytes.
+ * in bytes, alignment is the alignment of
+ * its code type, which may be smaller.
  */
 struct ast_type_primitive {
     char* name;
     char* code_name;
     size_t size;
+    size_t alignment;
     unsigned long long capacity;
     bool is_allowed_in_native;
 };
@@ -13,10 +13,9 @@
 #define CARBONSTEEL_CODEGEN_CODEGEN_H
 
     /* includes */
-#include <stdio.h> /* file functions */
-
 #include "ctool/macro.h" /* macro concatenation */
 #include "ast/root.h" /* ast root */
+#include "codegen/output.h" /* output buffer */
 
 
     /* defines */
@@ -26,7 +25,7 @@
  * 
  * @param[in] name Name of the element
  */
-#define cgd(name, argument) void macro_concatenate(codegen_, name)(argument, FILE* file, int tabs, int* tmp)
+#define cgd(name, argument) void macro_concatenate(codegen_, name)(argument, cg_output* output, int tabs, int* tmp)
 /* --- */
 #define cgd_ex(name)            cgd(macro_concatenate(ex_, name), macro_concatenate(ex_, name)* ex)
 /* --- */
@@ -46,30 +45,42 @@
  * @param[in] x The code generation function type
  */
 #define cg(x) macro_concatenate(codegen_, x) _codegen_call
-#define _codegen_call(x) (x, file, tabs, tmp)
+#define _codegen_call(x) (x, output, tabs, tmp)
 
 
 /**
  * Emits a specified (tabs/char/string/format)
- * data into the code generation function file
+ * data into the code generation function output
  * 
  * @param[in] x One of "tabs", "char", "string" or "format"
  */
 #define out(x) macro_concatenate(_codegen_out_, x)
 #define _codegen_out_tabs() iterate_array(t, tabs) { out(char)('\t'); }
-#define _codegen_out_char(character) fputc(character, file); fflush(file)
-#define _codegen_out_string(string) fputs(string, file); fflush(file)
-#define _codegen_out_format(string, ...) fprintf(file, string, __VA_ARGS__); fflush(file)
+#define _codegen_out_char(character) cg_output_char(output, character)
+#define _codegen_out_string(string) cg_output_string(output, string)
+#define _codegen_out_format(string, ...) cg_output_format(output, string, __VA_ARGS__)
 
 
     /* functions */
 /**
  * Does code generation into the
- * specified output file
+ * specified output buffer
  * 
  * @param ast The abstract syntax tree
- * @param output The output source code file
+ * @param output The output buffer
+ */
+void codegen(ast_root* ast, cg_output* output);
+
+/**
+ * Does code generation into memory,
+ * for use of the compiler as a library
+ * 
+ * @param[in]  ast    The abstract syntax tree
+ * @param[out] length Length of the generated code, may be NULL
+ * 
+ * @return The null-terminated generated code,
+ *         allocated by malloc
  */
-void codegen(ast_root* ast, FILE* output);
+char* codegen_to_string(ast_root* ast, size_t* length);
 
 #endif /* CARBONSTEEL_CODEGEN_CODEGEN_H */
\ No newline at end of file
@@ -0,0 +1,142 @@
+/**
+ * @file output.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Buffered code generation output
+ *
+ *  Generated code is accumulated in a growable
+ *  memory buffer. A file output writes the buffer
+ *  out once it exceeds the flush size and when it
+ *  is closed, a memory output keeps everything
+ *  until the buffer is released to the caller.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_CODEGEN_OUTPUT_H
+#define CARBONSTEEL_CODEGEN_OUTPUT_H
+
+    /* includes */
+#include <stdio.h> /* file functions */
+#include <stdbool.h> /* boolean */
+#include <stddef.h> /* size type */
+
+    /* defines */
+/**
+ * Initial capacity of the output buffer
+ */
+#define CG_OUTPUT_INITIAL_CAPACITY (64 * 1024)
+
+/**
+ * Default flush size of a file output,
+ * 0 means the buffer is only written when closed
+ */
+#define CG_OUTPUT_FLUSH_SIZE (1024 * 1024)
+
+    /* typedefs */
+/**
+ * Code generation output buffer
+ *
+ * If file is NULL, the output is kept in memory
+ */
+typedef struct cg_output {
+    char* data;
+    size_t size;
+    size_t capacity;
+    FILE* file;
+    size_t flush_size;
+    bool failed; /* a write to the file has failed */
+} cg_output;
+
+    /* functions */
+/**
+ * Initializes an output which writes into a file
+ *
+ * @param[out] output     Pointer to the output
+ * @param[in]  file       The output file
+ * @param[in]  flush_size Buffer size which triggers a write,
+ *                        or 0 to write only when closed
+ */
+void cg_output_init_file(cg_output* output, FILE* file, size_t flush_size);
+
+/**
+ * Initializes an output which
+ * is kept in memory
+ *
+ * @param[out] output Pointer to the output
+ */
+void cg_output_init_memory(cg_output* output);
+
+/**
+ * Appends raw data to the output
+ *
+ * @param[in] output Pointer to the output
+ * @param[in] data   The data
+ * @param[in] length Length of the data
+ */
+void cg_output_write(cg_output* output, const char* data, size_t length);
+
+/**
+ * Appends a string to the output
+ *
+ * @param[in] output Pointer to the output
+ * @param[in] string The string
+ */
+void cg_output_string(cg_output* output, const char* string);
+
+/**
+ * Appends a formatted string to the output
+ *
+ * @param[in] output Pointer to the output
+ * @param[in] format The format string
+ */
+void cg_output_format(cg_output* output, const char* format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * Writes the buffered data into the file,
+ * does nothing for a memory output
+ *
+ * @param[in] output Pointer to the output
+ *
+ * @return false if the write has failed
+ */
+bool cg_output_flush(cg_output* output);
+
+/**
+ * Flushes and releases a file output,
+ * the file itself is not closed
+ *
+ * @param[in] output Pointer to the output
+ *
+ * @return false if any write has failed
+ */
+bool cg_output_close(cg_output* output);
+
+/**
+ * Releases a memory output and passes
+ * its contents to the caller
+ *
+ * @param[in]  output Pointer to the output
+ * @param[out] length Length of the contents, may be NULL
+ *
+ * @return The null-terminated contents,
+ *         allocated by malloc
+ */
+char* cg_output_release(cg_output* output, size_t* length);
+
+/**
+ * Appends a character to the output
+ *
+ * @param[in] output    Pointer to the output
+ * @param[in] character The character
+ */
+static inline void cg_output_char(cg_output* output, char character) {
+    if (output->size == output->capacity) {
+        cg_output_write(output, &character, 1);
+    } else {
+        output->data[output->size++] = character;
+    }
+}
+
+#endif /* CARBONSTEEL_CODEGEN_OUTPUT_H */
\ No newline at end of file
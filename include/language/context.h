@@ -17,6 +17,10 @@
 
     /* includes */
 #include "ast/root.h" /* ast root type */
+#include "misc/arena.h" /* region allocation */
+#include "language/scope.h" /* local symbol table */
+#include "language/tokens.h" /* recorded token streams */
+#include "language/native/batch.h" /* batched native headers */
 
 #include "ctool/type/bitset.h" /* bitset type */
 
@@ -100,7 +104,7 @@ typedef enum se_context_level_kind {
 typedef struct se_context_level {
     se_context_level_kind kind;
     union {
-        arraylist(local_declaration) u_locals;     /* in SCTX_SCOPE      */
+        size_t u_scope_mark;                       /* in SCTX_SCOPE      */
         ex_block u_ex_block;                       /* in SCTX_EXPRESSION */
         enum_context u_enum_context;               /* in SCTX_ENUM       */
         flag_context u_flag_context;               /* in SCTX_FLAG       */
@@ -141,6 +145,10 @@ typedef struct se_context_import_file {
     char* filename;
     bool is_native;
     se_context_pass last; /* last pass done on the file */
+    bool is_linked; /* linked from a cached module, never parsed */
+    se_token_stream* tokens; /* recorded by the first pass, NULL for native and linked files */
+    char* native_unit; /* guards the native declarations, the filename unless batched */
+    native_batch* native_batch; /* preprocessed native imports during the first pass, or NULL */
 } se_context_import_file;
 
 
@@ -154,6 +162,13 @@ typedef struct se_context {
     se_context_pass pass;
     char* filename; /* the filename of the parser's origin file */
     arraylist(se_context_import_file_ptr) file_list; /* the list of imported files */
+    arraylist(dc_import_ptr) import_list; /* import declarations of the origin file in source order */
+    se_scope_table scope; /* local declarations of every open SCTX_SCOPE level */
+    size_t import_depth; /* number of open SCTX_IMPORT levels */
+
+    /* memory regions */
+    mem_arena arena; /* owns every node of the context's syntax tree */
+    mem_arena transient; /* scratch memory, reset before each pass */
 
     /* assistant fields for skipping tokens */
     int skip_pair_count; /* bracket pair counter */
@@ -166,11 +181,20 @@ typedef struct se_context {
     /* functions */
 /**
  * Allocates and initializes a new parser context
+ * and selects its arena for further allocations
  * 
  * @return Pointer to the new parser context
  */
 se_context* context_new();
 
+/**
+ * Releases the parser context together
+ * with everything allocated in its arena
+ * 
+ * @param context Pointer to the parser context
+ */
+void context_free(se_context* context);
+
 /**
  * Add a new context level
  * on top of the context stack
@@ -230,6 +254,24 @@ se_context_level* context_find(se_context* context, se_context_level_kind kind);
  */
 void context_exit(se_context* context);
 
+/**
+ * Declares a local symbol in the innermost
+ * SCTX_SCOPE level of the context
+ * 
+ * @param context Pointer to the parser context
+ * @param dc      The local declaration
+ */
+void context_declare_local(se_context* context, local_declaration dc);
+
+/**
+ * Translates an import statement into a relative filename
+ * 
+ * @param import The import statement
+ * 
+ * @return Relative path to the file, allocated in the current arena
+ */
+char* import_to_filename(dc_import* import);
+
 /**
  * Parses the given file and adds data from it (depending on the pass)
  * to the context's abstract syntax tree
@@ -0,0 +1,212 @@
+/**
+ * @file interface.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Precompiled module interfaces
+ *
+ *  A module interface is a binary file with the
+ *  header-level declarations of a module (structures,
+ *  enums, aliases, function signatures and global
+ *  variable types), its import list and the content
+ *  hashes of every module it depends on.
+ *
+ *  The file consists of a header and flat record
+ *  tables which refer to each other by indices and
+ *  to the string table by offsets, so it is used
+ *  directly from a read-only memory mapping.
+ *  Declarations of other modules are referred to by name
+ *  and looked up after the imports have been replayed.
+ *
+ *  Interfaces are kept in the "modules" directory
+ *  of the cache root (see misc/cache.h).
+ *
+ *  The same format holds the declaration snapshots of
+ *  native headers, which are kept next to the preprocessed
+ *  headers (see language/native/cache.h) and are valid as
+ *  long as the dependency manifest of the header is.
+ *  Snapshots have no imports, may hold constants and
+ *  refer to anonymous declarations as hidden ones,
+ *  which are not added to the symbol table.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_LANGUAGE_INTERFACE_H
+#define CARBONSTEEL_LANGUAGE_INTERFACE_H
+
+    /* includes */
+#include <stdint.h> /* integer types */
+
+#include "language/module.h" /* cached modules */
+
+    /* defines */
+/**
+ * Magic number and version of the interface format
+ */
+#define INTERFACE_MAGIC        0x49545343 /* "CSTI" */
+#define INTERFACE_NATIVE_MAGIC 0x53545343 /* "CSTS" */
+#define INTERFACE_VERSION      1
+
+/**
+ * Marks a missing table index
+ */
+#define INTERFACE_NONE UINT32_MAX
+
+    /* typedefs */
+/**
+ * Kind of a type reference
+ */
+typedef enum if_reference_kind {
+    IF_REF_PRIMITIVE, /* reference is the primitive name */
+    IF_REF_LOCAL,     /* reference is a declaration index */
+    IF_REF_EXTERNAL,  /* reference is the declaration name */
+    IF_REF_GENERIC    /* reference is a structure declaration index */
+} if_reference_kind;
+
+/**
+ * A contiguous range of a record table
+ */
+typedef struct if_range {
+    uint32_t first;
+    uint32_t count;
+} if_range;
+
+/**
+ * Interface file header
+ */
+typedef struct if_header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t hash; /* hash of the module source */
+    uint32_t file_size;
+    uint32_t string_size; /* the string table follows the header */
+    if_range imports;      /* if_import */
+    if_range dependencies; /* if_dependency */
+    if_range declarations; /* if_declaration */
+    if_range members;      /* if_member */
+    if_range enum_members; /* if_enum_member */
+    if_range types;        /* if_type */
+    if_range indices;      /* uint32_t */
+} if_header;
+
+/**
+ * Import declaration, the path is
+ * a range of string offsets in the index table
+ */
+typedef struct if_import {
+    uint32_t is_native;
+    if_range path;
+} if_import;
+
+/**
+ * Module dependency with its content hash
+ */
+typedef struct if_dependency {
+    uint32_t filename;
+    uint32_t reserved;
+    uint64_t hash;
+} if_dependency;
+
+/**
+ * Declaration flags
+ */
+#define IF_FLAG_FULL      (1 << 0)
+#define IF_FLAG_C         (1 << 1) /* is_c_struct or is_c_enum */
+#define IF_FLAG_EXTERN    (1 << 2)
+#define IF_FLAG_C_VARARG  (1 << 3)
+#define IF_FLAG_HIDDEN    (1 << 4) /* not in the symbol table, snapshots only */
+
+/**
+ * Declaration
+ *
+ *  - structure: members, generic names as string offsets in the index table
+ *  - enum:      enum members
+ *  - alias:     target type
+ *  - function:  return type, parameters as members
+ *  - variable:  type
+ *  - constant:  primitive type, the value as an enum member
+ */
+typedef struct if_declaration {
+    uint32_t kind;
+    uint32_t flags;
+    uint32_t name;
+    uint32_t type;
+    if_range members;
+    if_range generics;
+} if_declaration;
+
+/**
+ * Structure member or function parameter
+ */
+typedef struct if_member {
+    uint32_t name;
+    uint32_t type;
+} if_member;
+
+/**
+ * Enum member with its constant value
+ */
+typedef struct if_enum_member {
+    uint32_t name;
+    uint32_t kind;
+    uint64_t value;
+} if_enum_member;
+
+/**
+ * Type, the levels are level kinds and the generic
+ * implementation is a list of type indices, both in the index table
+ */
+typedef struct if_type {
+    uint32_t kind;
+    uint32_t reference_kind;
+    uint32_t reference;
+    uint32_t generic_index; /* for IF_REF_GENERIC */
+    if_range levels;
+    if_range generic_impl;
+} if_type;
+
+    /* functions */
+/**
+ * Loads the interface of a module into its module context,
+ * replaying the module imports first
+ *
+ * @param module Pointer to the module
+ * @param loader Pointer to the new module context
+ *
+ * @return false if there is no valid interface, in which
+ *         case the module context must be discarded
+ */
+bool interface_load(se_module* module, se_context* loader);
+
+/**
+ * Writes the interface of a parsed module,
+ * does nothing if the module cannot be represented
+ *
+ * @param module Pointer to the module
+ */
+void interface_save(se_module* module);
+
+/**
+ * Loads the declaration snapshot of a native header
+ * into the symbol table without parsing the header
+ *
+ * @param context     Pointer to the parser context
+ * @param header      The header name, as in #include <header>
+ * @param native_unit The native unit of the declarations
+ *
+ * @return false if there is no valid snapshot,
+ *         in which case the context is unchanged
+ */
+bool interface_load_native(se_context* context, char* header, char* native_unit);
+
+/**
+ * Writes the declaration snapshot of a parsed native header,
+ * does nothing if the declarations cannot be represented
+ *
+ * @param context     Pointer to the parser context
+ * @param header      The header name, as in #include <header>
+ * @param native_unit The native unit of the declarations
+ */
+void interface_save_native(se_context* context, char* header, char* native_unit);
+
+#endif /* CARBONSTEEL_LANGUAGE_INTERFACE_H */
\ No newline at end of file
@@ -13,11 +13,18 @@
     /* defines */
 #define YYSTYPE MYYSTYPE
 #define YYLTYPE MYYLTYPE
-#define YY_DECL int myylex(MYYSTYPE* yylval_param, MYYLTYPE* yylloc_param, void* yyscanner, se_context* context)
+#define YY_DECL int myylex_raw(MYYSTYPE* yylval_param, MYYLTYPE* yylloc_param, void* yyscanner)
 
     /* includes */
 #include "main_lexer.h"
 
+    /* functions */
+/**
+ * Returns the next token of the source file,
+ * identifiers are returned as TOKEN_IDENTIFIER
+ */
+YY_DECL;
+
     /* undefines */
 #undef YYSTYPE
 #undef YYLTYPE
@@ -0,0 +1,97 @@
+/**
+ * @file module.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Process-wide cache of imported modules
+ *
+ *  The header-level declarations of an imported file
+ *  (passes 1 and 2) are parsed once into a standalone
+ *  module context, and every later context which imports
+ *  the file links against them instead of parsing it again.
+ *
+ *  Modules are keyed by their interned filename, the
+ *  directory nested imports are resolved from, and
+ *  the hash of their contents. Modules taking part in
+ *  an import cycle depend on the importing context and
+ *  are never cached, those are parsed in place as usual.
+ *
+ *  Values of a cached module are shared by every linking
+ *  context and are never changed for good: a context adding
+ *  a generic implementation to a shared structure works on
+ *  its own copy of it, and partial shared values completed
+ *  by a context are restored when the context is released.
+ *  Modules doing either are not cached themselves.
+ *
+ *  A parsed module is also saved as a precompiled interface
+ *  (see language/interface.h), which later compiler runs
+ *  load instead of parsing the module.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_LANGUAGE_MODULE_H
+#define CARBONSTEEL_LANGUAGE_MODULE_H
+
+    /* includes */
+#include <stdint.h> /* integer types */
+
+#include "language/context.h" /* parser context */
+
+    /* typedefs */
+/**
+ * Module state
+ */
+typedef enum se_module_state {
+    SE_MODULE_LOADING,     /* the module is being parsed */
+    SE_MODULE_READY,       /* the module can be linked */
+    SE_MODULE_UNCACHEABLE  /* the module must be parsed in place */
+} se_module_state;
+
+/**
+ * Cached module structure
+ */
+struct se_module {
+    char* filename;  /* interned absolute filename */
+    char* directory; /* interned directory of nested imports */
+    uint64_t hash;   /* hash of the file contents */
+    long long file_size;  /* the file is hashed again only if its size */
+    long long file_mtime; /* or modification time in nanoseconds change */
+    se_module_state state;
+    bool is_cyclic;  /* an import cycle has been found while loading */
+    bool is_dependent; /* the module has copied or completed values of other modules */
+    se_context* context; /* the module context, owns the declarations */
+};
+
+    /* functions */
+/**
+ * Hashes the contents of a file
+ *
+ * @param[in]  filename Name of the file
+ * @param[out] hash     The content hash
+ *
+ * @return false if the file could not be read
+ */
+bool module_hash_file(char* filename, uint64_t* hash);
+
+/**
+ * Finds a cached module or loads it
+ *
+ * @param context   Pointer to the importing parser context
+ * @param filename  Interned absolute filename of the module
+ * @param directory Interned directory of nested imports
+ *
+ * @return Pointer to the ready module, or NULL if
+ *         the file has to be parsed in place
+ */
+se_module* module_get(se_context* context, char* filename, char* directory);
+
+/**
+ * Links the declarations of a cached module
+ * and all of its imports into a parser context
+ *
+ * @param context Pointer to the parser context
+ * @param module  Pointer to the module
+ */
+void module_link(se_context* context, se_module* module);
+
+#endif /* CARBONSTEEL_LANGUAGE_MODULE_H */
\ No newline at end of file
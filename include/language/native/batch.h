@@ -0,0 +1,103 @@
+/**
+ * @file batch.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Batched preprocessing of native headers
+ *
+ *  Every native header imported by a file is included
+ *  into one synthetic translation unit, which is
+ *  preprocessed once. The output is split back into
+ *  per-header regions by the line markers of <stdin>,
+ *  so a sub-header shared by several headers is only
+ *  present in the region of the first one.
+ *
+ *  Native declarations are guarded by the unit name of
+ *  the batch instead of the header name, which lets the
+ *  later regions use the declarations of the earlier ones.
+ *
+ *  The batch is preprocessed with -dD, so the macro
+ *  definitions stay in the output next to the declarations
+ *  (the native lexer skips them) and the macro constants
+ *  of every header come from the same preprocessor run.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_LANGUAGE_NATIVE_BATCH_H
+#define CARBONSTEEL_LANGUAGE_NATIVE_BATCH_H
+
+    /* includes */
+#include <stdbool.h> /* boolean */
+#include <stddef.h> /* size type */
+
+#include "misc/source.h" /* source buffers */
+
+    /* typedefs */
+/**
+ * Preprocessed region of a header
+ */
+typedef struct native_batch_region {
+    char* header; /* interned header name */
+    char* start; /* the region in the batch output */
+    size_t size;
+    bool is_parsed;
+} native_batch_region;
+
+/**
+ * Batch of preprocessed headers
+ */
+typedef struct native_batch {
+    char* unit; /* interned unit name of the batch */
+    char* output; /* the whole preprocessor output */
+    size_t size; /* size of the output */
+    struct native_macro_table* macros; /* macro definitions of the output, built on the first use */
+    size_t count;
+    native_batch_region* regions;
+} native_batch;
+
+    /* global variables */
+/**
+ * Enables batched preprocessing, set by --native-batch
+ */
+extern bool native_batch_mode;
+
+    /* functions */
+/**
+ * Preprocesses a list of headers at once
+ *
+ * @param[in] headers The interned header names, without duplicates
+ * @param[in] count   Number of headers
+ * @param[in] unit    The interned unit name
+ *
+ * @return The batch allocated by malloc, or NULL
+ *          if the preprocessor has failed
+ */
+native_batch* native_batch_new(char** headers, size_t count, char* unit);
+
+/**
+ * Finds the region of a header which may be parsed now,
+ * that is only after the regions of all previous headers
+ *
+ * @param[in] batch  The batch
+ * @param[in] header The interned header name
+ *
+ * @return The region, or NULL if the header has to be preprocessed alone
+ */
+native_batch_region* native_batch_find(native_batch* batch, char* header);
+
+/**
+ * Copies a region into a source buffer for scanning
+ *
+ * @param[in]  region The region
+ * @param[out] source The source buffer
+ */
+void native_batch_region_open(native_batch_region* region, source_buffer* source);
+
+/**
+ * Releases a batch
+ *
+ * @param[in] batch The batch
+ */
+void native_batch_free(native_batch* batch);
+
+#endif /* CARBONSTEEL_LANGUAGE_NATIVE_BATCH_H */
\ No newline at end of file
@@ -0,0 +1,121 @@
+/**
+ * @file cache.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Persistent cache of preprocessed native headers
+ *
+ *  The preprocessor output of "#include <header>" is stored
+ *  in a cache directory, keyed by the header name, the
+ *  preprocessor command, the identity of the preprocessor
+ *  executable and the include path variables.
+ *  The macro definitions printed with -dM are cached
+ *  the same way, under a separate key. Every entry has
+ *  a manifest with the modification time and size of
+ *  each file the preprocessor has read, which is checked
+ *  before the entry is used.
+ *
+ *  The translated declarations of a header are kept
+ *  in a binary snapshot next to its preprocessed text
+ *  (see language/interface.h), which is keyed by the
+ *  contents of the manifest of the text.
+ *
+ *  Entries are kept in the "native" directory
+ *  of the cache root (see misc/cache.h).
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_LANGUAGE_NATIVE_CACHE_H
+#define CARBONSTEEL_LANGUAGE_NATIVE_CACHE_H
+
+    /* includes */
+#include <stdbool.h> /* boolean */
+#include <stddef.h> /* size type */
+#include <stdint.h> /* integer types */
+
+#include "misc/source.h" /* source buffers */
+
+    /* defines */
+/**
+ * The C preprocessor executable
+ */
+#define NATIVE_PREPROCESSOR "gcc"
+
+/**
+ * Version of the cache entry format
+ */
+#define NATIVE_CACHE_VERSION 1
+
+/**
+ * Maximum number of concurrent preprocessors
+ * started by native_cache_prefetch
+ */
+#define NATIVE_PREFETCH_MAX_JOBS 16
+
+    /* functions */
+/**
+ * Determines the path of the declaration snapshot of a native
+ * header, which is kept next to its preprocessed text and is
+ * only valid together with the dependency manifest of the text
+ *
+ * @param[in]  header The header name, as in #include <header>
+ * @param[out] path   The path buffer of PATH_MAX characters
+ * @param[out] hash   Hash of the dependency manifest
+ *
+ * @return false if the cache is disabled or the
+ *          preprocessed text has no valid entry
+ */
+bool native_cache_snapshot(char* header, char* path, uint64_t* hash);
+
+/**
+ * Maps the preprocessed text of a native header,
+ * running the preprocessor only if there is no
+ * valid cache entry for it
+ *
+ * @param[in]  header The header name, as in #include <header>
+ * @param[out] source The preprocessed text
+ *
+ * @return false if the cache is disabled
+ *          or the header could not be cached
+ */
+bool native_cache_open(char* header, source_buffer* source);
+
+/**
+ * Maps the macro definitions of a native header,
+ * as printed by the preprocessor with -dM
+ *
+ * @param[in]  header The header name, as in #include <header>
+ * @param[out] source The macro definitions
+ *
+ * @return false if the cache is disabled
+ *          or the header could not be cached
+ */
+bool native_cache_open_macros(char* header, source_buffer* source);
+
+/**
+ * Runs the preprocessor concurrently on every header
+ * without valid cache entries, so that native_cache_open
+ * and native_cache_open_macros find the entries
+ * when the headers are imported
+ *
+ * @param[in] headers The header names
+ * @param[in] count   Number of headers
+ */
+void native_cache_prefetch(char** headers, size_t count);
+
+/**
+ * Runs the preprocessor on an include list without
+ * the cache and reads the whole output, header i
+ * is included on line i + 1 of <stdin>
+ *
+ * @param[in]  headers The header names
+ * @param[in]  count   Number of headers
+ * @param[in]  option  An extra preprocessor option such as -dM, or NULL
+ * @param[in]  name    Name of the run in the trace output
+ * @param[out] source  The preprocessor output
+ *
+ * @return false if the preprocessor has failed
+ */
+bool native_preprocess(char** headers, size_t count, char* option, char* name, source_buffer* source);
+
+#endif /* CARBONSTEEL_LANGUAGE_NATIVE_CACHE_H */
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include "syntax/declaration/declaration.h"
 #include "ast/type/primitive.h" /* primitives */
 #include "misc/string.h"
+#include "misc/intern.h"
 
     /* functions */
 /**
@@ -23,10 +24,10 @@
  * 
  * @param name The enum name
  * 
- * @return Carbonsteel-compatible enum name, allocated with malloc
+ * @return Carbonsteel-compatible enum name, interned
  */
 static inline char* cst_native_enum_name(char* name) {
-    return cst_strconcat(CST_NATIVE_ENUM_PREFIX, name);
+    return intern_string(cst_strconcat(CST_NATIVE_ENUM_PREFIX, name));
 }
 
 /**
@@ -34,10 +35,10 @@ static inline char* cst_native_enum_name(char* name) {
  * 
  * @param name The struct name
  * 
- * @return Carbonsteel-compatible struct name, allocated with malloc
+ * @return Carbonsteel-compatible struct name, interned
  */
 static inline char* cst_native_struct_name(char* name) {
-    return cst_strconcat(CST_NATIVE_STRUCT_PREFIX, name);
+    return intern_string(cst_strconcat(CST_NATIVE_STRUCT_PREFIX, name));
 }
 
 /**
@@ -47,11 +48,12 @@ static inline char* cst_native_struct_name(char* name) {
  * 
  * @param context The parser context
  * @param in The C-native declaration specifiers
+ * @param native_unit The native unit which contains the declaration
  * @param declarations The arraylist to append any inner declarations into
  * 
  * @return The type
  */
-ast_type cst_native_declspecs_translate(se_context* context, c_declaration_specifiers in, arraylist(declaration)* declarations);
+ast_type cst_native_declspecs_translate(se_context* context, c_declaration_specifiers in, char* native_unit, arraylist(declaration)* declarations);
 
 /**
  * Translates a C-native declaration into a list of
@@ -59,10 +61,45 @@ ast_type cst_native_declspecs_translate(se_context* context, c_declaration_speci
  * 
  * @param context The parser context
  * @param in The C-native declaration
+ * @param native_unit The native unit which contains the declaration
  * 
  * @return A list of processed declarations 
  */
-arraylist(declaration) cst_native_declaration_translate(se_context* context, c_declaration in);
+arraylist(declaration) cst_native_declaration_translate(se_context* context, c_declaration in, char* native_unit);
+
+/**
+ * Declares the names of a top-level C-native declaration,
+ * deferring the translation of its declarators until
+ * their first use
+ * 
+ * @param context The parser context
+ * @param in The C-native declaration
+ * @param native_unit The native unit the declaration belongs to
+ */
+void cst_native_declaration_declare(se_context* context, c_declaration in, char* native_unit);
+
+/**
+ * Translates a native declaration declared by
+ * cst_native_declaration_declare on its first use
+ * 
+ * @param pending The untranslated declaration
+ * 
+ * @return The value of the declaration
+ */
+void* cst_native_pending_translate(c_native_pending* pending);
+
+/**
+ * Ensures that the value of a declaration is translated,
+ * must be called before the value of a native declaration is used
+ * 
+ * @param dc The declaration
+ */
+static inline void cst_native_declaration_resolve(declaration* dc) {
+    if (dc->native_pending != NULL) {
+        dc->u__any = cst_native_pending_translate(dc->native_pending);
+        dc->native_pending = NULL;
+    }
+}
 
 /**
  * Translates a declaration into a type
@@ -90,6 +127,10 @@ static inline ast_type cst_declaration_to_type(declaration dc) {
             ast_type_init(&type, AST_TYPE_PRIMITIVE, dc.u_primitive);
             break;
 
+        case DC_CONSTANT:
+            ast_type_init(&type, AST_TYPE_PRIMITIVE, dc.u_constant->type);
+            break;
+
         case DC_FUNCTION:
             ast_type_init(&type, AST_TYPE_PRIMITIVE, &primitive_list.data[PRIMITIVE_INDEX_VOID]);
             ast_type_pointer_wrap(&type);
@@ -109,11 +150,12 @@ static inline ast_type cst_declaration_to_type(declaration dc) {
  * 
  * @param context The parser context
  * @param in The C-native declaration
+ * @param native_unit The native unit which contains the declaration
  * 
  * @return A function parameter
  */
-static inline dc_function_parameter cst_native_declaration_to_function_parameter(se_context* context, c_declaration in) {
-    arraylist(declaration) decls = cst_native_declaration_translate(context, in);
+static inline dc_function_parameter cst_native_declaration_to_function_parameter(se_context* context, c_declaration in, char* native_unit) {
+    arraylist(declaration) decls = cst_native_declaration_translate(context, in, native_unit);
 
     if (decls.size != 1) {
         logfe("expected 1 declaration inside a function parameter, got %zu", decls.size);
@@ -131,11 +173,12 @@ static inline dc_function_parameter cst_native_declaration_to_function_parameter
  * 
  * @param context The parser context
  * @param in The C-native declaration
+ * @param native_unit The native unit which contains the declaration
  * 
  * @return A structure member
  */
-static inline dc_structure_member cst_native_declaration_to_structure_member(se_context* context, c_declaration in) {
-    arraylist(declaration) decls = cst_native_declaration_translate(context, in);
+static inline dc_structure_member cst_native_declaration_to_structure_member(se_context* context, c_declaration in, char* native_unit) {
+    arraylist(declaration) decls = cst_native_declaration_translate(context, in, native_unit);
 
     if (decls.size != 1) {
         logfe("expected 1 declaration inside a structure member, got %zu", decls.size);
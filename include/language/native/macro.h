@@ -0,0 +1,72 @@
+/**
+ * @file macro.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Native macro constants
+ *
+ *  The macro definitions of a native header are
+ *  printed by the preprocessor with -dM. Object-like
+ *  macros with a number literal body, or a body which
+ *  folds into a constant from number literals, other
+ *  macros and arithmetic operators, are declared as
+ *  constants with a value known at compile time.
+ *
+ *  Only names without lowercase letters which do not
+ *  start with a double underscore are declared, so that
+ *  predefined and internal macros of the C library do
+ *  not shadow identifiers of Carbonsteel code.
+ *
+ *  Headers of a batch (see language/native/batch.h) take
+ *  their macro definitions from the batch output instead.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_LANGUAGE_NATIVE_MACRO_H
+#define CARBONSTEEL_LANGUAGE_NATIVE_MACRO_H
+
+    /* includes */
+#include "language/context.h" /* parser context */
+#include "language/native/batch.h" /* batched native headers */
+
+    /* defines */
+/**
+ * Maximum nesting of macro references in a folded body
+ */
+#define NATIVE_MACRO_MAX_DEPTH 64
+
+    /* typedefs */
+/**
+ * Macro definitions of a preprocessor output
+ */
+typedef struct native_macro_table native_macro_table;
+
+    /* functions */
+/**
+ * Declares the macro constants of a native header
+ *
+ * @param[in] context     Pointer to the parser context
+ * @param[in] header      The header name, as in #include <header>
+ * @param[in] native_unit The native unit the constants belong to
+ */
+void native_macro_import(se_context* context, char* header, char* native_unit);
+
+/**
+ * Declares the macro constants defined in the region
+ * of a header in a batch, the macros are folded as they
+ * are defined at the end of the batch
+ *
+ * @param[in] context Pointer to the parser context
+ * @param[in] batch   The batch
+ * @param[in] region  The region of the header
+ */
+void native_macro_import_batch(se_context* context, native_batch* batch, native_batch_region* region);
+
+/**
+ * Releases a macro table
+ *
+ * @param[in] table The macro table
+ */
+void native_macro_table_free(native_macro_table* table);
+
+#endif /* CARBONSTEEL_LANGUAGE_NATIVE_MACRO_H */
\ No newline at end of file
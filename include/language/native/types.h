@@ -68,11 +68,16 @@ static void c_declaration_specifier_init(c_declaration_specifiers* this) {
 
 
     /* declarators */
+struct c_function_parameters {
+    arraylist(c_declaration) value; /* translated with the function */
+    bool is_c_vararg;
+};
+
 struct c_declarator {
     char* name;
     arraylist(ast_type_level) level_list;
     bool is_function;
-    dc_function_parameters u_parameters;
+    c_function_parameters u_parameters;
 };
 arraylist_declare_functions(c_declarator);
 
@@ -86,4 +91,16 @@ struct c_declaration {
 };
 arraylist_declare_functions(c_declaration);
 
+
+
+    /* lazily translated declarations */
+struct c_native_pending {
+    ast_type raw_type; /* translated declaration specifiers */
+    c_declarator declarator;
+    bool is_typedef;
+    se_context* context; /* the context which has parsed the declaration, owns the value */
+    char* native_unit; /* the unit which has declared it, the last file changes until the first use */
+    void* value; /* NULL until the first use */
+};
+
 #endif /* CARBONSTEEL_LANGUAGE_NATIVE_TYPES_H */
\ No newline at end of file
@@ -0,0 +1,104 @@
+/**
+ * @file scope.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ *  Scoped symbol table for local declarations
+ * 
+ *  Every local declaration is appended to a binding log
+ *  and the hash map points each name to its most recent binding.
+ *  A binding remembers the one it shadows, so leaving a scope
+ *  only walks the bindings declared in that scope
+ *  and restores the shadowed ones.
+ * 
+ *  Names must be interned strings (see misc/intern.h).
+ *  The binding structure is defined along with local declarations.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_LANGUAGE_SCOPE_H
+#define CARBONSTEEL_LANGUAGE_SCOPE_H
+
+    /* includes */
+#include "syntax/predeclaration.h" /* predeclarations */
+
+    /* defines */
+/**
+ * Marks a binding which does not shadow any other binding
+ */
+#define SCOPE_BINDING_NONE ((size_t) -1)
+
+    /* typedefs */
+/**
+ * Hash map slot, empty if the key is NULL
+ */
+typedef struct se_scope_slot {
+    char* key;
+    size_t binding; /* index of the most recent binding */
+} se_scope_slot;
+
+/**
+ * Scoped symbol table
+ */
+typedef struct se_scope_table {
+    arraylist(se_scope_binding) bindings; /* the binding log */
+    se_scope_slot* slots;
+    size_t capacity; /* always a power of two */
+    size_t size;
+} se_scope_table;
+
+    /* functions */
+/**
+ * Initializes an empty scoped symbol table
+ * 
+ * @param[out] table Pointer to the table
+ */
+void scope_table_init(se_scope_table* table);
+
+/**
+ * Releases the memory of a scoped symbol table
+ * 
+ * @param[in] table Pointer to the table
+ */
+void scope_table_free(se_scope_table* table);
+
+/**
+ * Returns the current position in the binding log,
+ * which should be stored when entering a scope
+ * 
+ * @param[in] table Pointer to the table
+ */
+static inline size_t scope_table_mark(se_scope_table* table) {
+    return table->bindings.size;
+}
+
+/**
+ * Declares a local symbol in the innermost scope,
+ * shadowing any outer symbol with the same name
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] dc    The local declaration with an interned name
+ */
+void scope_table_declare(se_scope_table* table, local_declaration dc);
+
+/**
+ * Looks up the innermost local symbol with specified name
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] name  Interned name of the symbol
+ * 
+ * @return Pointer to the local declaration, valid until the next declaration,
+ *          or NULL if not found
+ */
+local_declaration* scope_table_lookup(se_scope_table* table, char* name);
+
+/**
+ * Removes every symbol declared after the mark
+ * and restores the symbols shadowed by them
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] mark  The binding log position returned by scope_table_mark
+ */
+void scope_table_unwind(se_scope_table* table, size_t mark);
+
+#endif /* CARBONSTEEL_LANGUAGE_SCOPE_H */
\ No newline at end of file
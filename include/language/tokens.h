@@ -0,0 +1,82 @@
+/**
+ * @file tokens.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Recorded token streams
+ *
+ *  A source file is lexed once, the first time it is
+ *  parsed in a context, into a flat array of tokens with
+ *  interned identifiers and line numbers. Every parse pass
+ *  then replays the array through myylex, which classifies
+ *  identifiers against the current symbol table and applies
+ *  the skip mode of the pass by counting bracket tokens.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_LANGUAGE_TOKENS_H
+#define CARBONSTEEL_LANGUAGE_TOKENS_H
+
+    /* includes */
+#include <stdbool.h> /* boolean */
+#include <stddef.h> /* size type */
+
+#include "misc/source.h" /* source buffers */
+
+    /* typedefs */
+/**
+ * Recorded token, the value depends on the token kind
+ */
+typedef struct se_token {
+    int kind;
+    int line;
+    union {
+        long long u_long;   /* TOKEN_LONG_CONSTANT */
+        double u_double;    /* TOKEN_DOUBLE_CONSTANT */
+        char u_char;        /* TOKEN_CHAR_CONSTANT */
+        bool u_boolean;     /* TOKEN_TRUE, TOKEN_FALSE */
+        int u_op_assign;    /* TOKEN_OP_ASSIGN */
+        char* u_string;     /* TOKEN_IDENTIFIER (interned), TOKEN_STRING_LITERAL, TOKEN_CODE_LITERAL */
+    };
+} se_token;
+
+/**
+ * Token stream of a source file
+ */
+typedef struct se_token_stream {
+    se_token* data;
+    size_t size;
+    size_t capacity;
+} se_token_stream;
+
+/**
+ * Position of a parser in a token stream,
+ * passed to the parser as the scanner
+ */
+typedef struct se_token_reader {
+    se_token_stream* stream;
+    size_t position;
+} se_token_reader;
+
+    /* functions */
+/**
+ * Lexes a whole source file into a new token stream,
+ * scanning the source buffer in place
+ *
+ * String literals are allocated in the current arena
+ *
+ * @param[in] source   The source buffer
+ * @param[in] filename Name of the file for error messages
+ *
+ * @return The token stream allocated by malloc
+ */
+se_token_stream* token_stream_lex(source_buffer* source, char* filename);
+
+/**
+ * Releases a token stream
+ *
+ * @param[in] stream The token stream
+ */
+void token_stream_free(se_token_stream* stream);
+
+#endif /* CARBONSTEEL_LANGUAGE_TOKENS_H */
\ No newline at end of file
@@ -0,0 +1,120 @@
+/**
+ * @file arena.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Region (bump) allocator used for
+ *  all syntax tree, type and expression nodes
+ *
+ *  An arena hands out memory from a list of
+ *  large chunks and never frees individual
+ *  allocations. The whole region is released
+ *  at once by arena_free or recycled by arena_reset.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_MISC_ARENA_H
+#define CARBONSTEEL_MISC_ARENA_H
+
+    /* includes */
+#include <stddef.h> /* size type */
+
+    /* defines */
+/**
+ * Size of the first chunk of an arena,
+ * every next chunk doubles it up to ARENA_CHUNK_SIZE_MAX
+ */
+#define ARENA_CHUNK_SIZE     (64 * 1024)
+#define ARENA_CHUNK_SIZE_MAX (16 * 1024 * 1024)
+
+/**
+ * Alignment of every arena allocation
+ */
+#define ARENA_ALIGNMENT (_Alignof(max_align_t))
+
+    /* typedefs */
+/**
+ * Arena chunk, a single large memory region
+ * with a bump pointer
+ */
+typedef struct mem_arena_chunk {
+    struct mem_arena_chunk* next;
+    size_t size;
+    size_t used;
+    _Alignas(max_align_t) char data[];
+} mem_arena_chunk;
+
+/**
+ * Arena, a list of chunks where
+ * the head is the chunk currently allocated from
+ *
+ * A zero-initialized arena is valid and empty
+ */
+typedef struct mem_arena {
+    mem_arena_chunk* head;
+    size_t total; /* total bytes handed out */
+} mem_arena;
+
+    /* global variables */
+/**
+ * The arena used by allocate(), allocate_array() and copy_string()
+ *
+ * Defaults to a process-wide arena which is never released
+ */
+extern mem_arena* arena_current;
+
+    /* functions */
+/**
+ * Initializes an empty arena
+ *
+ * @param[out] arena Pointer to the arena
+ */
+void arena_init(mem_arena* arena);
+
+/**
+ * Allocates an aligned memory region from the arena
+ * or throws an internal error on failure
+ *
+ * @param[in] arena Pointer to the arena
+ * @param[in] size  The size of memory region
+ *
+ * @return The allocated memory region
+ */
+void* arena_allocate(mem_arena* arena, size_t size);
+
+/**
+ * Duplicates a string into the arena
+ *
+ * @param[in] arena  Pointer to the arena
+ * @param[in] string The string
+ *
+ * @return Copy of the string
+ */
+char* arena_copy_string(mem_arena* arena, const char* string);
+
+/**
+ * Discards all allocations, but keeps the
+ * most recent chunk for reuse
+ *
+ * @param[in] arena Pointer to the arena
+ */
+void arena_reset(mem_arena* arena);
+
+/**
+ * Releases all chunks of the arena
+ *
+ * @param[in] arena Pointer to the arena
+ */
+void arena_free(mem_arena* arena);
+
+/**
+ * Makes the specified arena current,
+ * or restores the process-wide arena if NULL is given
+ *
+ * @param[in] arena Pointer to the arena or NULL
+ *
+ * @return The previously selected arena
+ */
+mem_arena* arena_select(mem_arena* arena);
+
+#endif /* CARBONSTEEL_MISC_ARENA_H */
\ No newline at end of file
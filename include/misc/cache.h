@@ -0,0 +1,28 @@
+/**
+ * @file cache.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Location of the persistent compiler caches
+ *
+ *  The cache root is $CARBONSTEEL_CACHE_DIR, or
+ *  carbonsteel in $XDG_CACHE_HOME or ~/.cache.
+ *  An empty $CARBONSTEEL_CACHE_DIR disables every cache.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_MISC_CACHE_H
+#define CARBONSTEEL_MISC_CACHE_H
+
+    /* functions */
+/**
+ * Creates a named cache directory inside the cache root
+ *
+ * @param[in] name Name of the cache
+ *
+ * @return Path to the directory allocated by malloc,
+ *         or NULL if the cache is disabled or unavailable
+ */
+char* cache_directory(const char* name);
+
+#endif /* CARBONSTEEL_MISC_CACHE_H */
\ No newline at end of file
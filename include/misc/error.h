@@ -11,7 +11,7 @@
 #define CARBONSTEEL_MISC_ERROR_H
 
     /* includes */
-#include "ctool/log.h" /* logging */
+#include "misc/log.h" /* logging */
 
     /* defines */
 /**
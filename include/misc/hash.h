@@ -0,0 +1,124 @@
+/**
+ * @file hash.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ *  Fast 64-bit hash function for byte strings
+ * 
+ *  It follows the structure of wyhash:
+ *  input is consumed in 16-byte blocks which are
+ *  folded with a 64x64->128 multiply-xor mix.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_MISC_HASH_H
+#define CARBONSTEEL_MISC_HASH_H
+
+    /* includes */
+#include <stdint.h> /* fixed-size integers */
+#include <string.h> /* memory copying */
+
+    /* defines */
+/**
+ * Hash mixing constants
+ */
+#define HASH_SECRET_0 0xa0761d6478bd642full
+#define HASH_SECRET_1 0xe7037ed1a0b428dbull
+#define HASH_SECRET_2 0x8ebc6af09c88c6e3ull
+
+    /* functions */
+/**
+ * Multiplies two 64-bit values into a 128-bit
+ * product and folds it back with xor
+ * 
+ * @param[in] a The first value
+ * @param[in] b The second value
+ * 
+ * @return The mixed value
+ */
+static inline uint64_t hash_mix(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    __uint128_t r = (__uint128_t) a * b;
+    return (uint64_t) r ^ (uint64_t) (r >> 64);
+#else
+    uint64_t ha = a >> 32, hb = b >> 32;
+    uint64_t la = (uint32_t) a, lb = (uint32_t) b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+    return lo ^ hi;
+#endif
+}
+
+/**
+ * Unaligned little-endian reads
+ */
+static inline uint64_t hash_read8(const unsigned char* p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint64_t hash_read4(const unsigned char* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint64_t hash_read3(const unsigned char* p, size_t length) {
+    return ((uint64_t) p[0] << 16) | ((uint64_t) p[length >> 1] << 8) | p[length - 1];
+}
+
+/**
+ * Hashes a byte string
+ * 
+ * @param[in] data   Pointer to the bytes
+ * @param[in] length Number of bytes
+ * 
+ * @return The 64-bit hash value
+ */
+static inline uint64_t hash_bytes(const void* data, size_t length) {
+    const unsigned char* p = data;
+    uint64_t seed = HASH_SECRET_0 ^ hash_mix(HASH_SECRET_0 ^ HASH_SECRET_2, HASH_SECRET_1);
+    uint64_t a, b;
+
+    if (length <= 16) {
+        if (length >= 4) {
+            size_t shift = (length >> 3) << 2;
+            a = (hash_read4(p) << 32) | hash_read4(p + shift);
+            b = (hash_read4(p + length - 4) << 32) | hash_read4(p + length - 4 - shift);
+        } else if (length > 0) {
+            a = hash_read3(p, length);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t remaining = length;
+        while (remaining > 16) {
+            seed = hash_mix(hash_read8(p) ^ HASH_SECRET_1, hash_read8(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        a = hash_read8(p + remaining - 16);
+        b = hash_read8(p + remaining - 8);
+    }
+
+    return hash_mix(HASH_SECRET_1 ^ length, hash_mix(a ^ HASH_SECRET_1, b ^ seed));
+}
+
+/**
+ * Hashes a null-terminated string
+ * 
+ * @param[in] string The string
+ * 
+ * @return The 64-bit hash value
+ */
+static inline uint64_t hash_string(const char* string) {
+    return hash_bytes(string, strlen(string));
+}
+
+#endif /* CARBONSTEEL_MISC_HASH_H */
\ No newline at end of file
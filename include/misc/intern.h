@@ -0,0 +1,86 @@
+/**
+ * @file intern.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ *  Global string interning table
+ * 
+ *  Every distinct string is stored exactly once,
+ *  so interned strings can be compared by pointer.
+ *  The hash and the length of an interned string are
+ *  stored right before its first character and
+ *  are never recomputed.
+ * 
+ *  Interned strings are immutable and live
+ *  until the end of the process.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_MISC_INTERN_H
+#define CARBONSTEEL_MISC_INTERN_H
+
+    /* includes */
+#include <stdint.h> /* fixed-size integers */
+#include <stddef.h> /* size type */
+
+    /* typedefs */
+/**
+ * Header placed in front of every interned string
+ */
+typedef struct intern_header {
+    uint64_t hash;
+    size_t length;
+} intern_header;
+
+    /* functions */
+/**
+ * Returns the unique copy of a string
+ * with specified length, adding it
+ * to the table if needed
+ * 
+ * @param[in] string The string, not necessarily null-terminated
+ * @param[in] length Length of the string
+ * 
+ * @return The interned string
+ */
+char* intern_string_length(const char* string, size_t length);
+
+/**
+ * Returns the unique copy of a string,
+ * adding it to the table if needed
+ * 
+ * @param[in] string The string
+ * 
+ * @return The interned string
+ */
+char* intern_string(const char* string);
+
+/**
+ * Finds the unique copy of a string
+ * without adding it to the table
+ * 
+ * @param[in] string The string
+ * 
+ * @return The interned string or NULL if it has never been interned
+ */
+char* intern_find(const char* string);
+
+/**
+ * Returns the cached hash of an interned string
+ * 
+ * @param[in] string The interned string
+ */
+static inline uint64_t intern_hash(const char* string) {
+    return ((const intern_header*) string)[-1].hash;
+}
+
+/**
+ * Returns the cached length of an interned string
+ * 
+ * @param[in] string The interned string
+ */
+static inline size_t intern_length(const char* string) {
+    return ((const intern_header*) string)[-1].length;
+}
+
+#endif /* CARBONSTEEL_MISC_INTERN_H */
\ No newline at end of file
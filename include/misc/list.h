@@ -80,7 +80,7 @@
 
 /**
  * Finds a first arraylist element
- * that matches a given name and then
+ * that matches a given interned name and then
  * assigns it to the specified variable
  * or throws the specified syntax error error
  * 
@@ -100,7 +100,7 @@
 #define arl_find_by_name_(type, list, expected_name, result, error) \
     result = NULL;                                                  \
     iterate_array(i, list.size) {                                   \
-        if (strcmp(list.data[i].name, expected_name) == 0) {        \
+        if (list.data[i].name == expected_name) {                   \
             result = &list.data[i];                                 \
             break;                                                  \
         }                                                           \
@@ -0,0 +1,105 @@
+/**
+ * @file log.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Filtered diagnostic logging
+ *
+ *  Debug and info messages belong to a category and are
+ *  printed only if the category has been enabled with --log.
+ *  A disabled category costs a single branch which is
+ *  predicted as not taken, the message arguments are
+ *  not evaluated then.
+ *
+ *  Messages below CARBONSTEEL_LOG_LEVEL are removed at compile
+ *  time, release builds are built without the debug messages.
+ *  Warnings and errors are always printed.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_MISC_LOG_H
+#define CARBONSTEEL_MISC_LOG_H
+
+    /* includes */
+#include <stdbool.h> /* boolean */
+
+#include "ctool/log.h" /* logging */
+
+    /* defines */
+/**
+ * Message levels
+ */
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO  1
+#define LOG_LEVEL_NONE  2
+
+/**
+ * Lowest level of the messages which are compiled in
+ */
+#ifndef CARBONSTEEL_LOG_LEVEL
+#define CARBONSTEEL_LOG_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+/**
+ * Message categories
+ */
+#define LOG_LEXER   (1u << 0) /* skip mode and token streams */
+#define LOG_PARSER  (1u << 1) /* context levels and declarations */
+#define LOG_IMPORT  (1u << 2) /* imports, modules and interfaces */
+#define LOG_NATIVE  (1u << 3) /* native headers, caches and snapshots */
+#define LOG_CODEGEN (1u << 4) /* code generation */
+#define LOG_ALL     (LOG_LEXER | LOG_PARSER | LOG_IMPORT | LOG_NATIVE | LOG_CODEGEN)
+
+/**
+ * Checks if the messages of a level and a category are printed
+ *
+ * @param[in] level    The message level
+ * @param[in] category The message category
+ */
+#define log_enabled(level, category) \
+    ((level) >= CARBONSTEEL_LOG_LEVEL && __builtin_expect((log_categories & (category)) != 0, 0))
+
+/**
+ * Prints a debug message of a category
+ *
+ * @param[in] category    The message category
+ * @param[in] message     The message string
+ * @param[in] __VA_ARGS__ The message format
+ */
+#define log_debug(category, message, ...) { \
+    if (log_enabled(LOG_LEVEL_DEBUG, category)) { \
+        logd(message, ##__VA_ARGS__) \
+    } \
+}
+
+/**
+ * Prints an info message of a category
+ *
+ * @param[in] category    The message category
+ * @param[in] message     The message string
+ * @param[in] __VA_ARGS__ The message format
+ */
+#define log_info(category, message, ...) { \
+    if (log_enabled(LOG_LEVEL_INFO, category)) { \
+        logi(message, ##__VA_ARGS__) \
+    } \
+}
+
+    /* global variables */
+/**
+ * Enabled message categories, set by --log
+ */
+extern unsigned log_categories;
+
+    /* functions */
+/**
+ * Enables the message categories of a comma-separated
+ * list, such as "lexer,native" or "all"
+ *
+ * @param[in] list The category list
+ *
+ * @return false if a category is unknown
+ */
+bool log_enable(const char* list);
+
+#endif /* CARBONSTEEL_MISC_LOG_H */
\ No newline at end of file
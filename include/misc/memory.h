@@ -1,10 +1,14 @@
 /**
  * @file memory.h
  * @author andersonarc (e.andersonarc@gmail.com)
- * @version 0.2
+ * @version 0.3
  * @date 2021-07-28
  * 
  *  Memory allocation and duplication functions
+ * 
+ *  Syntax tree memory is allocated from
+ *  the current arena (see misc/arena.h) and
+ *  must never be passed to free()
  */
     /* header guard */
 #ifndef CARBONSTEEL_MISC_MEMORY_H
@@ -15,45 +19,62 @@
 #include <stdlib.h> /* memory allocation */
 
 #include "misc/error.h" /* error throw */
+#include "misc/arena.h" /* region allocation */
+#include "misc/memstat.h" /* allocation statistics */
 
     /* defines */
 /**
  * Allocates memory for
  * a structure of specified type
- * and throws an internal error if
- * the allocation fails
+ * from the current arena
  * 
  * @param[in] type The type
  */
-#define allocate(type) checked_malloc(sizeof(type))
+#define allocate(type) allocate_counted(sizeof(type), #type, MEMSTAT_SITE)
 
 /**
  * Allocates memory for
  * an array of specified type
- * and throws an internal error if
- * the allocation fails
+ * from the current arena
  * 
  * @param[in] type  The type
  * @param[in] count Number of elements
  */
-#define allocate_array(type, count) checked_malloc(sizeof(type) * count)
+#define allocate_array(type, count) allocate_counted(sizeof(type) * (count), #type, MEMSTAT_SITE)
 
 
     /* functions */
 /**
- * Duplicates a string or throws 
- * an internal error on failure
+ * Allocates memory from the current arena,
+ * counting the allocation if --mem-report is enabled
+ * 
+ * @param[in] size The size of memory region
+ * @param[in] type Name of the allocated type
+ * @param[in] file Source file of the call site or NULL
+ * @param[in] line Source line of the call site
+ * 
+ * @return The allocated memory region
+ */
+static inline void* allocate_counted(size_t size, const char* type, const char* file, int line) {
+    if (memstat_mode) {
+        memstat_count(type, size, file, line);
+    }
+    return arena_allocate(arena_current, size);
+}
+
+/**
+ * Duplicates a string into
+ * the current arena
  * 
  * @param[in] string The string
  * 
  * @return Copy of the string
  */
 static inline char* copy_string(const char* string) {
-    char* result = strdup(string);
-    if (result == NULL) {
-        error_internal("failed to duplicate a string \"%s\"", string);
+    if (memstat_mode) {
+        memstat_count("char", strlen(string) + 1, MEMSTAT_SITE);
     }
-    return result;
+    return arena_copy_string(arena_current, string);
 }
 
 /**
@@ -74,4 +95,23 @@ static inline void* checked_malloc(size_t size) {
     return result;
 }
 
+/**
+ * Resizes a memory region
+ * allocated by checked_malloc and
+ * throws an internal error if
+ * the allocation fails
+ * 
+ * @param[in] pointer The memory region
+ * @param[in] size    The new size of memory region
+ * 
+ * @return The resized memory region
+ */
+static inline void* checked_realloc(void* pointer, size_t size) {
+    void* result = realloc(pointer, size);
+    if (result == NULL) {
+        error_internal("failed to reallocate a memory region to size %zu bytes", size);
+    }
+    return result;
+}
+
 #endif /* CARBONSTEEL_MISC_MEMORY_H */
\ No newline at end of file
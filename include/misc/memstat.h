@@ -0,0 +1,143 @@
+/**
+ * @file memstat.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Allocation statistics
+ *
+ *  With --mem-report, every arena allocation made through
+ *  allocate(), allocate_array() or copy_string() and every
+ *  interned string is counted by category, by compilation
+ *  phase and by the file being parsed. The category follows
+ *  from the allocated type name (dc_, ex_, ast_type and so on),
+ *  except that everything allocated while a native header is
+ *  parsed or while code is generated has a category of its own.
+ *  Level lists are grown by ctool and counted by their elements.
+ *
+ *  The peak of a phase is the peak of the memory held by arena
+ *  chunks, the report also includes the peak resident set size.
+ *
+ *  Builds with CARBONSTEEL_MEMSTAT_SITES defined (the debug
+ *  builds) also attribute the allocations to their call sites.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_MISC_MEMSTAT_H
+#define CARBONSTEEL_MISC_MEMSTAT_H
+
+    /* includes */
+#include <stdbool.h> /* boolean */
+#include <stddef.h> /* size type */
+#include <stdio.h> /* file functions */
+
+    /* defines */
+/**
+ * Call site arguments of the counted allocations
+ */
+#ifdef CARBONSTEEL_MEMSTAT_SITES
+    #define MEMSTAT_SITE __FILE__, __LINE__
+#else
+    #define MEMSTAT_SITE NULL, 0
+#endif
+
+    /* typedefs */
+/**
+ * Allocation category
+ */
+typedef enum memstat_category {
+    MEMSTAT_DECLARATION,
+    MEMSTAT_TYPE,
+    MEMSTAT_LEVEL_LIST,
+    MEMSTAT_EXPRESSION,
+    MEMSTAT_STATEMENT,
+    MEMSTAT_STRING,
+    MEMSTAT_NATIVE,
+    MEMSTAT_CODEGEN,
+    MEMSTAT_OTHER,
+    MEMSTAT_CATEGORY_COUNT
+} memstat_category;
+
+/**
+ * Compilation phase
+ */
+typedef enum memstat_phase {
+    MEMSTAT_PHASE_SETUP,
+    MEMSTAT_PHASE_PASS_1,
+    MEMSTAT_PHASE_PASS_2,
+    MEMSTAT_PHASE_PASS_3,
+    MEMSTAT_PHASE_CODEGEN,
+    MEMSTAT_PHASE_COUNT
+} memstat_phase;
+
+/**
+ * The file allocations are attributed to,
+ * restored when its parsing has finished
+ */
+typedef struct memstat_scope {
+    size_t file;
+    bool is_native;
+} memstat_scope;
+
+    /* global variables */
+/**
+ * Enables the allocation statistics, set by --mem-report
+ */
+extern bool memstat_mode;
+
+    /* functions */
+/**
+ * Counts an allocation
+ *
+ * @param[in] type Name of the allocated type
+ * @param[in] size Size of the allocation
+ * @param[in] file Source file of the call site or NULL
+ * @param[in] line Source line of the call site
+ */
+void memstat_count(const char* type, size_t size, const char* file, int line);
+
+/**
+ * Counts the memory of a new arena chunk,
+ * or of a released one if the size is negative
+ *
+ * @param[in] size Size of the chunk
+ */
+void memstat_chunk(long long size);
+
+/**
+ * Starts a compilation phase
+ *
+ * @param[in] phase The phase
+ */
+void memstat_enter_phase(memstat_phase phase);
+
+/**
+ * Attributes the next allocations to a file
+ *
+ * @param[in] filename  Interned name of the file
+ * @param[in] is_native Marks native headers
+ *
+ * @return The previous scope
+ */
+memstat_scope memstat_enter_file(char* filename, bool is_native);
+
+/**
+ * Restores the scope replaced by memstat_enter_file
+ *
+ * @param[in] scope The previous scope
+ */
+void memstat_exit_file(memstat_scope scope);
+
+/**
+ * Discards the statistics of the previous compilation
+ */
+void memstat_reset();
+
+/**
+ * Prints the allocation report
+ *
+ * @param[in] output The output file
+ * @param[in] title  Title of the report, such as the input filename
+ */
+void memstat_print(FILE* output, const char* title);
+
+#endif /* CARBONSTEEL_MISC_MEMSTAT_H */
\ No newline at end of file
@@ -0,0 +1,56 @@
+/**
+ * @file scan.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Vectorized byte search for the lexer fast paths
+ *
+ *  The search compares 32 (AVX2) or 16 (SSE2) bytes at
+ *  a time with aligned loads, which never cross into the
+ *  next page, so it is safe to run up to the null terminator
+ *  of a mapped source buffer. Processors without SSE2
+ *  and other targets use a scalar loop.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_MISC_SCAN_H
+#define CARBONSTEEL_MISC_SCAN_H
+
+    /* defines */
+/**
+ * Maximum number of bytes in a search set
+ */
+#define SCAN_SET_MAX 8
+
+    /* typedefs */
+/**
+ * Set of bytes to search for, the
+ * null character is always included
+ */
+typedef struct scan_set {
+    char bytes[SCAN_SET_MAX];
+    int count;
+    unsigned char is_member[256];
+} scan_set;
+
+    /* functions */
+/**
+ * Initializes a search set
+ *
+ * @param[out] set   Pointer to the set
+ * @param[in]  bytes The bytes, at most SCAN_SET_MAX
+ */
+void scan_set_init(scan_set* set, const char* bytes);
+
+/**
+ * Finds the first byte of a null-terminated
+ * buffer which belongs to a search set
+ *
+ * @param[in] data The buffer
+ * @param[in] set  Pointer to the search set
+ *
+ * @return Pointer to the byte, or to the null terminator
+ */
+char* scan_find(char* data, const scan_set* set);
+
+#endif /* CARBONSTEEL_MISC_SCAN_H */
\ No newline at end of file
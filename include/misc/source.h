@@ -0,0 +1,63 @@
+/**
+ * @file source.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Memory-mapped source files
+ *
+ *  A source buffer holds the whole contents of a file
+ *  followed by two null characters, as required by
+ *  yy_scan_buffer, so that a scanner can work on it in place.
+ *  The file is mapped privately, since flex writes into its
+ *  buffer, unless the sentinel would not fit into the last
+ *  page of the mapping, in which case the file is read.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_MISC_SOURCE_H
+#define CARBONSTEEL_MISC_SOURCE_H
+
+    /* includes */
+#include <stdbool.h> /* boolean */
+#include <stddef.h> /* size type */
+
+    /* defines */
+/**
+ * Number of null characters after the contents
+ */
+#define SOURCE_BUFFER_SENTINEL 2
+
+    /* typedefs */
+/**
+ * Source buffer structure
+ */
+typedef struct source_buffer {
+    char* data; /* the contents followed by the sentinel */
+    size_t size; /* size of the contents */
+    size_t mapped_size; /* size of the mapping, 0 if the file has been read */
+} source_buffer;
+
+    /* functions */
+/**
+ * Maps a file into a source buffer
+ *
+ * @param[out] source   Pointer to the source buffer
+ * @param[in]  filename Name of the file
+ *
+ * @return false if the file could not be opened
+ */
+bool source_buffer_open(source_buffer* source, const char* filename);
+
+/**
+ * Releases a source buffer
+ *
+ * @param[in] source Pointer to the source buffer
+ */
+void source_buffer_close(source_buffer* source);
+
+/**
+ * Returns the size to pass to yy_scan_buffer
+ */
+#define source_buffer_scan_size(source) ((source)->size + SOURCE_BUFFER_SENTINEL)
+
+#endif /* CARBONSTEEL_MISC_SOURCE_H */
\ No newline at end of file
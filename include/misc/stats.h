@@ -0,0 +1,99 @@
+/**
+ * @file stats.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Symbol table and lookup statistics
+ *
+ *  With --stats, the compiler counts the recorded tokens
+ *  by kind, the identifier lookups with the table which
+ *  has resolved them, the imports and the declaration merges
+ *  of a compilation. The report also describes the load and
+ *  probe lengths of the global symbol table and the generic
+ *  implementations of every generic structure, which are
+ *  taken from the syntax tree once it has been parsed.
+ *
+ *  Counters are a single branch when the report is disabled.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_MISC_STATS_H
+#define CARBONSTEEL_MISC_STATS_H
+
+    /* includes */
+#include <stdbool.h> /* boolean */
+#include <stdint.h> /* integer types */
+#include <stdio.h> /* file functions */
+
+#include "ast/root.h" /* syntax tree */
+
+    /* defines */
+/**
+ * Number of counted token kinds, characters
+ * and the named tokens of the main parser
+ */
+#define STATS_TOKEN_KINDS 512
+
+/**
+ * Increments a counter of the current compilation
+ *
+ * @param[in] counter Name of the counter
+ */
+#define stats_count(counter) { \
+    if (__builtin_expect(stats_mode, 0)) { \
+        stats_current.counter++; \
+    } \
+}
+
+    /* typedefs */
+/**
+ * Counters of a compilation
+ */
+typedef struct stats_report {
+    uint64_t tokens[STATS_TOKEN_KINDS]; /* recorded tokens by kind */
+    uint64_t lookups;        /* identifiers of the main language */
+    uint64_t local_hits;     /* resolved by the scope table */
+    uint64_t global_hits;    /* resolved by the symbol table */
+    uint64_t native_lookups; /* identifiers of native headers */
+    uint64_t native_hits;
+    uint64_t imports;
+    uint64_t native_imports;
+    uint64_t linked_imports; /* already linked from a cached module */
+    uint64_t repeat_imports; /* rejected, already parsed on the pass */
+    uint64_t merges;         /* declarations merged into an existing one */
+    uint64_t symbol_grows;   /* symbol table resizes */
+} stats_report;
+
+    /* global variables */
+/**
+ * Enables the statistics, set by --stats
+ */
+extern bool stats_mode;
+
+/**
+ * Counters of the current compilation
+ */
+extern stats_report stats_current;
+
+    /* functions */
+/**
+ * Counts a recorded token
+ *
+ * @param[in] kind Kind of the token
+ */
+static inline void stats_count_token(int kind) {
+    if (__builtin_expect(stats_mode, 0) && kind >= 0 && kind < STATS_TOKEN_KINDS) {
+        stats_current.tokens[kind]++;
+    }
+}
+
+/**
+ * Prints the statistics of a compilation
+ *
+ * @param[in] file  The output file
+ * @param[in] title Title of the report, such as the input filename
+ * @param[in] ast   Pointer to the parsed syntax tree
+ */
+void stats_print(FILE* file, const char* title, ast_root* ast);
+
+#endif /* CARBONSTEEL_MISC_STATS_H */
\ No newline at end of file
@@ -14,7 +14,7 @@
 /**
  * Concatenates two strings
  * 
- * @return The result string allocated by malloc
+ * @return The result string allocated in the current arena
  */
 char* cst_strconcat(const char* a, const char* b);
 
@@ -0,0 +1,149 @@
+/**
+ * @file timer.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Compilation phase timers
+ *
+ *  With --time-report, the time spent in every phase of
+ *  a compilation is accumulated from a monotonic clock
+ *  and reported per input file and for the whole run.
+ *  The passes contain the imports parsed during them,
+ *  so the native and symbol table phases are also
+ *  included in the pass times.
+ *
+ *  Timers are a single branch when the report is disabled.
+ *  Phases made of many short operations, such as symbol
+ *  table lookups, count every operation but only read
+ *  the clock for one in TIMER_SAMPLE_PERIOD of them.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_MISC_TIMER_H
+#define CARBONSTEEL_MISC_TIMER_H
+
+    /* includes */
+#include <stdbool.h> /* boolean */
+#include <stdint.h> /* integer types */
+#include <stdio.h> /* file functions */
+
+    /* defines */
+/**
+ * Sampled phases time one operation in this many
+ */
+#define TIMER_SAMPLE_PERIOD 64
+
+    /* typedefs */
+/**
+ * Timed phase of a compilation
+ */
+typedef enum timer_phase {
+    TIMER_LEX,
+    TIMER_PASS_1,
+    TIMER_PASS_2,
+    TIMER_PASS_3,
+    TIMER_NATIVE_PREPROCESS, /* forking the preprocessor and waiting for its output */
+    TIMER_NATIVE_PARSE,      /* cyyparse, including the reads of a preprocessor pipe */
+    TIMER_NATIVE_MACROS,
+    TIMER_NATIVE_SNAPSHOT,
+    TIMER_SYMBOL_TABLE,
+    TIMER_CODEGEN_HEADER,
+    TIMER_CODEGEN_DEFINITIONS,
+    TIMER_PHASE_COUNT
+} timer_phase;
+
+/**
+ * Accumulated phase times
+ */
+typedef struct timer_report {
+    uint64_t total; /* the whole compilation in nanoseconds */
+    uint64_t time[TIMER_PHASE_COUNT]; /* nanoseconds */
+    uint64_t count[TIMER_PHASE_COUNT];
+} timer_report;
+
+    /* global variables */
+/**
+ * Enables the phase timers, set by --time-report
+ */
+extern bool timer_mode;
+
+/**
+ * Phase times of the current compilation
+ */
+extern timer_report timer_current;
+
+    /* functions */
+/**
+ * Reads the monotonic clock
+ *
+ * @return The time in nanoseconds
+ */
+uint64_t timer_now();
+
+/**
+ * Starts timing a phase
+ *
+ * @return The start time or 0 if the timers are disabled
+ */
+static inline uint64_t timer_start() {
+    return timer_mode ? timer_now() : 0;
+}
+
+/**
+ * Adds the time since timer_start to a phase
+ *
+ * @param[in] phase The phase
+ * @param[in] start The start time
+ */
+static inline void timer_stop(timer_phase phase, uint64_t start) {
+    if (timer_mode) {
+        timer_current.time[phase] += timer_now() - start;
+        timer_current.count[phase]++;
+    }
+}
+
+/**
+ * Starts timing an operation of a sampled phase
+ *
+ * @param[in] phase The phase
+ *
+ * @return The start time or 0 if the operation is not timed
+ */
+static inline uint64_t timer_start_sampled(timer_phase phase) {
+    return timer_mode && timer_current.count[phase] % TIMER_SAMPLE_PERIOD == 0 ? timer_now() : 0;
+}
+
+/**
+ * Counts an operation of a sampled phase, adding
+ * the time of a timed one for the whole period
+ *
+ * @param[in] phase The phase
+ * @param[in] start The start time
+ */
+static inline void timer_stop_sampled(timer_phase phase, uint64_t start) {
+    if (timer_mode) {
+        if (start != 0) {
+            timer_current.time[phase] += (timer_now() - start) * TIMER_SAMPLE_PERIOD;
+        }
+        timer_current.count[phase]++;
+    }
+}
+
+/**
+ * Adds the phase times of a report to another one
+ *
+ * @param[in] report Pointer to the resulting report
+ * @param[in] source Pointer to the added report
+ */
+void timer_report_add(timer_report* report, const timer_report* source);
+
+/**
+ * Prints a phase time report
+ *
+ * @param[in] file   The output file
+ * @param[in] title  Title of the report, such as the input filename
+ * @param[in] report Pointer to the report
+ */
+void timer_report_print(FILE* file, const char* title, const timer_report* report);
+
+#endif /* CARBONSTEEL_MISC_TIMER_H */
\ No newline at end of file
@@ -0,0 +1,80 @@
+/**
+ * @file trace.h
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Trace Event Format output
+ *
+ *  With --trace, the compiler writes spans of the compiled
+ *  files, passes, imports, native preprocessor processes,
+ *  native parser runs and codegen tasks into a JSON file
+ *  which can be loaded into Perfetto or chrome://tracing.
+ *
+ *  Spans of a process are nested, so an import is shown
+ *  inside the import which has triggered it. Every worker
+ *  process is a process of the trace, and preprocessor
+ *  processes are shown as threads of the process which
+ *  has started them.
+ *
+ *  Every event is a single append to the file, so the workers
+ *  share it. The closing bracket of the event array is
+ *  optional in the format and is never written.
+ */
+    /* header guard */
+#ifndef CARBONSTEEL_MISC_TRACE_H
+#define CARBONSTEEL_MISC_TRACE_H
+
+    /* includes */
+#include <stdbool.h> /* boolean */
+#include <stdint.h> /* integer types */
+#include <sys/types.h> /* process id */
+
+    /* global variables */
+/**
+ * Enables the trace output, set by --trace
+ */
+extern bool trace_mode;
+
+    /* functions */
+/**
+ * Creates the trace file and enables the trace output
+ *
+ * @param[in] filename Name of the trace file
+ *
+ * @return false if the file could not be created
+ */
+bool trace_open(const char* filename);
+
+/**
+ * Names the current process in the trace
+ *
+ * @param[in] name The name
+ */
+void trace_name_process(const char* name);
+
+/**
+ * Begins a span of the current process,
+ * spans must be ended in the reverse order
+ *
+ * @param[in] category Category of the span
+ * @param[in] name     Name of the span
+ */
+void trace_begin(const char* category, const char* name);
+
+/**
+ * Ends the last span of the current process
+ */
+void trace_end();
+
+/**
+ * Adds a finished span of a child process
+ *
+ * @param[in] category Category of the span
+ * @param[in] name     Name of the span
+ * @param[in] start    Start time from timer_now
+ * @param[in] child    The child process id
+ */
+void trace_process(const char* category, const char* name, uint64_t start, pid_t child);
+
+#endif /* CARBONSTEEL_MISC_TRACE_H */
\ No newline at end of file
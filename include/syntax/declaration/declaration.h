@@ -28,6 +28,7 @@
 #include "syntax/predeclaration.h"       /* predeclarations */
 #include "language/context.h"            /* parser context */
 #include "ast/type/type.h"               /* lexical type */
+#include "ast/type/layout.h"             /* type layouts */
 
     /* definitions */
 #define CST_GENERIC_PREFIX "__cst_generic_of_"
@@ -48,7 +49,10 @@ struct dc_structure {
     bool is_c_struct;
     list(dc_generic_ptr) generics;
     arraylist(list(ast_type)) _generic_impls;
+    arraylist(ast_layout) _layouts; /* by generic implementation index, see ast/type/layout.h */
     list(dc_structure_member) member_list;
+    dc_structure* _origin; /* the structure this one is a copy of, or NULL */
+    bool _is_sealed; /* owned by a cached module, implementations are added to a copy */
 };
 
 struct dc_structure_member {
@@ -67,6 +71,7 @@ struct dc_enum {
     bool is_c_enum;
     char* name;
     list(dc_enum_member) member_list;
+    dc_enum* _origin; /* the enumeration this one is a copy of, or NULL */
 };
 
 struct dc_enum_member {
@@ -88,6 +93,17 @@ struct dc_alias {
 };
 
 
+/**
+ * Constant is a native object-like macro
+ * with a value known at compile time
+ */
+struct dc_constant {
+    char* name;
+    ast_type_primitive* type;
+    ex_constant value;
+};
+
+
 /**
  * Function has a name, a return type,
  * a parameter list an a compound statement body
@@ -150,13 +166,16 @@ struct dc_generic {
 enum declaration_kind {
     DC_IMPORT, DC_ALIAS, DC_STRUCTURE,
     DC_ENUM, DC_FUNCTION, DC_ST_VARIABLE,
-    DC_PRIMITIVE
+    DC_PRIMITIVE, DC_CONSTANT
 };
 
 struct declaration {
     bool is_full; /* marks partial declarations */
     bool is_native; /* native declarations are not generated in code */
+    bool is_shared; /* the value is owned by a cached module and must not be modified */
+    void* shared_origin; /* the value of a cached module this one is a copy or a completion of, or NULL */
     arraylist(char_ptr) native_filename_list; /* a fix for header guard absence in native files */
+    c_native_pending* native_pending; /* untranslated native declaration, NULL once translated */
     char* name; /* may be null */
     int token;
     int ctoken;
@@ -171,6 +190,7 @@ struct declaration {
         dc_function* u_function;
         dc_st_variable* u_variable;
         ast_type_primitive* u_primitive;
+        dc_constant* u_constant;
     };
 };
 arraylist_declare_functions(declaration);
@@ -199,6 +219,16 @@ struct local_declaration {
 };
 arraylist_declare_functions(local_declaration);
 
+/**
+ * Binding of a local declaration in the scoped symbol table
+ * (see language/scope.h)
+ */
+struct se_scope_binding {
+    local_declaration value;
+    size_t shadowed; /* index of the shadowed binding or SCOPE_BINDING_NONE */
+};
+arraylist_declare_functions(se_scope_binding);
+
 
     /* functions */
 /**
@@ -211,6 +241,47 @@ arraylist_declare_functions(local_declaration);
  */
 index_t dc_structure_generic_add_impl(dc_structure* this, list(ast_type) impl);
 
+/**
+ * Finds an existing generic implementation of a structure
+ * 
+ * @param[in]  this  The structure
+ * @param[in]  impl  The list of types for the generic implementation
+ * @param[out] index The index of the implementation
+ * 
+ * @return false if the structure has no such implementation
+ */
+bool dc_structure_generic_find_impl(dc_structure* this, list(ast_type) impl, index_t* index);
+
+/**
+ * Copies a structure into the current arena, so that
+ * implementations can be added to the copy without
+ * changing the original
+ * 
+ * @param this The structure
+ * 
+ * @return The copy, which keeps the implementation indices of the original
+ */
+dc_structure* dc_structure_copy(dc_structure* this);
+
+/**
+ * Returns the structure a copy has been made from,
+ * types of both refer to the same structure
+ * 
+ * @param this The structure
+ */
+static inline dc_structure* dc_structure_origin(dc_structure* this) {
+    return this->_origin != NULL ? this->_origin : this;
+}
+
+/**
+ * Returns the enumeration a copy has been made from
+ * 
+ * @param this The enumeration
+ */
+static inline dc_enum* dc_enum_origin(dc_enum* this) {
+    return this->_origin != NULL ? this->_origin : this;
+}
+
 /**
  * Applies a generic implementation to the structure's generics
  * for type checking or code generation purposes
@@ -234,7 +305,7 @@ ast_type* dc_generic_get_impl(ast_type* this);
  * 
  * @param[in] this The structure
  * 
- * @return The string, allocated by malloc
+ * @return The string, allocated in the current arena
  */
 char* dc_structure_contents_to_string(dc_structure* this);
 
@@ -245,7 +316,7 @@ char* dc_structure_contents_to_string(dc_structure* this);
  * @param this The structure
  * @param index The generic impl index to use
  * 
- * @return Display name, allocated by a malloc,
+ * @return Display name, allocated in the current arena,
  *          or the structure's actual name
  */
 char* dc_structure_display_name(dc_structure* this, index_t impl_index);
@@ -257,7 +328,7 @@ char* dc_structure_display_name(dc_structure* this, index_t impl_index);
  * @param this The enum
  * @param index The generic impl index to use
  * 
- * @return Display name, allocated by a malloc,
+ * @return Display name, allocated in the current arena,
  *          or the enum's actual name
  */
 char* dc_enum_display_name(dc_enum* this, index_t impl_index);
@@ -269,7 +340,7 @@ char* dc_enum_display_name(dc_enum* this, index_t impl_index);
  * @param this The function
  * @param index The generic impl index to use
  * 
- * @return Display name, allocated by a malloc,
+ * @return Display name, allocated in the current arena,
  *          or the function's actual name
  */
 char* dc_function_display_name(dc_function* this, index_t impl_index);
@@ -281,7 +352,7 @@ char* dc_function_display_name(dc_function* this, index_t impl_index);
  * @param this The structure
  * @param index The generic impl index to use
  * 
- * @return Mangled name, allocated by a malloc,
+ * @return Mangled name, allocated in the current arena,
  *          or the structure's actual name
  */
 char* dc_structure_mangled_name(dc_structure* this, index_t impl_index);
@@ -293,7 +364,7 @@ char* dc_structure_mangled_name(dc_structure* this, index_t impl_index);
  * @param this The enum
  * @param index The generic impl index to use
  * 
- * @return Mangled name, allocated by a malloc,
+ * @return Mangled name, allocated in the current arena,
  *          or the enum's actual name
  */
 char* dc_enum_mangled_name(dc_enum* this, index_t impl_index);
@@ -305,7 +376,7 @@ char* dc_enum_mangled_name(dc_enum* this, index_t impl_index);
  * @param this The function
  * @param index The generic impl index to use
  * 
- * @return Mangled name, allocated by a malloc,
+ * @return Mangled name, allocated in the current arena,
  *          or the function's actual name
  */
 char* dc_function_mangled_name(dc_function* this, index_t impl_index);
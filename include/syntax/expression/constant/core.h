@@ -26,7 +26,6 @@
 #include "syntax/expression/constant/size.h" /* constant expression size */
 #include "syntax/expression/constant/transform.h" /* constant expression transformations */
 #include "misc/list.h" /* list utilities */
-#include "ast/search.h" /* hash table */
 
 #include <stdint.h> /* integer types */
 #include <assert.h> /* assertions */
@@ -74,7 +73,7 @@ struct ex_constant {
 
         /* containers of primitive values */
         list(ex_constant) u_array;
-        struct hsearch_data u_structure;
+        list(ex_constant) u_structure; /* member values in declaration order */
 
         /* dynamic has no value */
     };
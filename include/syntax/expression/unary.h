@@ -8,6 +8,7 @@
  * 
  *  Unary expressions include:
  *   - ex_constructor, constructor expression
+ *   - ex_layout, type layout expression
  *   - ex_basic, basic expression
  *   - ex_postfix, postfix unary operation expression
  *   - ex_unary, prefix unary operation expression
@@ -47,13 +48,36 @@ struct ex_constructor {
 void ex_constructor_type_check(ex_constructor* this);
 
 
+/**
+ * Layout expression is the size or the alignment
+ * of a type, or the offset of a structure member
+ *
+ * The value is folded at compile time if the
+ * layout of the type is known (see ast/type/layout.h),
+ * otherwise it is computed by the C compiler.
+ */
+enum ex_layout_kind {
+    EX_L_SIZEOF, EX_L_ALIGNOF, EX_L_OFFSETOF
+};
+
+struct ex_layout {
+    ex_layout_kind kind;
+    ast_type* type;
+    dc_structure_member* u_member;
+    bool is_known;
+    size_t value;
+};
+
+ex_layout* ex_layout_new(ex_layout_kind kind, ast_type type, char* member);
+
+
 
 /**
  * Basic expression could be
  * a variable or a function reference,
  * a numerical or a boolean expression,
  * a string literal, a code literal, a constructor expression,
- * an enum member expression,
+ * a layout expression, an enum member expression, a native constant reference,
  * a function parameter reference or another
  * expression enclosed in brackets
  */
@@ -61,7 +85,7 @@ enum ex_basic_kind {
     EX_B_VARIABLE, EX_B_FUNCTION,
     EX_B_NUMBER, EX_B_BOOLEAN, EX_B_CHARACTER,
     EX_B_STRING, EX_B_CODE, EX_B_EX_CONSTRUCTOR, 
-    EX_B_ENUM_MEMBER,
+    EX_B_LAYOUT, EX_B_ENUM_MEMBER, EX_B_CONSTANT,
     EX_B_FUNCTION_PARAMETER, EX_B_EXPRESSION
 };
 
@@ -74,9 +98,11 @@ struct ex_basic_data {
         bool u_boolean;
         ex_character u_character;
         ex_enum_member* u_enum_member;
+        dc_constant* u_constant;
         char* u_string;
         char* u_code;
         ex_constructor* u_ex_constructor;
+        ex_layout* u_layout;
         dc_function_parameter* u_function_parameter;
         expression_data* u_expression;
     };
@@ -89,9 +115,11 @@ expression_inheritance(basic, number);
 extern_inheritance(basic, boolean, bool);
 extern_inheritance(basic, character, ex_character);
 extern_inheritance(basic, enum_member, ex_enum_member*);
+extern_inheritance(basic, constant, dc_constant*);
 extern_inheritance(basic, string, char*);
 extern_inheritance(basic, code, char*);
 extern_inheritance(basic, ex_constructor, ex_constructor*);
+extern_inheritance(basic, layout, ex_layout*);
 extern_inheritance(basic, function_parameter, dc_function_parameter*);
 expression_inheritance(basic, expression);
 
@@ -58,6 +58,9 @@
             /* typedefs */
 d_struct(se_context_import_file);
     da_pointer(se_context_import_file);
+d_struct(se_module);
+    da_pointer(se_module);
+da_struct(se_scope_binding);
 
 da_pointer(char);
 
@@ -66,6 +69,8 @@ da_pointer(char);
     /* native types */
 da_struct(c_declarator);
 da_struct(c_declaration);
+d_struct(c_function_parameters);
+d_struct(c_native_pending);
 
 da_enum(c_storage_class_specifier);
 da_enum(c_function_specifier);
@@ -82,6 +87,8 @@ arraylist_declare(list(ast_type));
     d_enum(ast_type_kind);
     da_struct(ast_type_level);
     d_enum(ast_type_level_kind);
+    da_struct(ast_layout);
+    d_enum(ast_layout_state);
 
     /* primitive type */
 dl_struct(ast_type_primitive);
@@ -96,6 +103,9 @@ da_pointer(dc_generic);
     /* alias */
 d_struct(dc_alias);
 
+    /* constant */
+d_struct(dc_constant);
+
     /* enum */
 d_struct(dc_enum);
     da_struct(dc_enum_member);
@@ -114,6 +124,7 @@ d_struct(dc_function);
 da_alias(dc_import_node, char*);
 arraylist_declare_functions(dc_import_node);
     d_struct(dc_import);
+    da_pointer(dc_import);
 
     /* declaration */
 da_struct(declaration);
@@ -149,6 +160,10 @@ d_alias(ex_enum_member, dc_enum_member);
 d_struct(ex_constructor);
     da_pointer(ex_constructor);
 
+    /* layout */
+d_struct(ex_layout);
+    d_enum(ex_layout_kind);
+
     /* basic */
 d_struct(ex_basic);
     d_struct(ex_basic_data);
@@ -14,7 +14,9 @@
 
 #include <string.h> /* string functions */
 
-#include "misc/memory.h" /* memory copying */
+#include "misc/intern.h" /* interned strings */
+#include "misc/stats.h" /* lookup statistics */
+#include "language/native/declaration.h" /* lazy native declarations */
 
     /* functions */
 /**
@@ -24,7 +26,7 @@
  * 
  * @param[in]  context The parser context
  * @param[out] yylval  Sematic value of the token
- * @param[in]  token   The token string
+ * @param[in]  token   The token string, interned
  * 
  * @return Type of the token, or IDENTIFIER
  */
@@ -43,18 +45,20 @@ myytoken_kind_t ast_lex_token(se_context* context, MYYSTYPE* yylval, char* token
     /**
      * Context-aware lookup
      */
+    stats_count(lookups);
     int context_result = context_lex_token(context, yylval, token);
     if (context_result > 0) {
+        stats_count(local_hits);
         return context_result;
     }
 
     /**
      * Global declarations lookup
      */
-    ENTRY* result;
-    ENTRY request = { .key = token };
-    if (hsearch_r(request, FIND, &result, context->ast.hash_table) != 0) {
-        declaration* dc = (declaration*) result->data;
+    declaration* dc = ast_symbol_table_find(&context->ast.symbol_table, token);
+    if (dc != NULL) {
+        stats_count(global_hits);
+        cst_native_declaration_resolve(dc);
         yylval->TOKEN_ANY_NAME = dc->u__any;
 
         /**
@@ -75,24 +79,32 @@ myytoken_kind_t ast_lex_token(se_context* context, MYYSTYPE* yylval, char* token
     /**
      * If the token does not match, return IDENTIFIER
      */
-    yylval->TOKEN_IDENTIFIER = copy_string(token);
+    yylval->TOKEN_IDENTIFIER = token;
     return TOKEN_IDENTIFIER;
 }
 cyytoken_kind_t ast_lex_token_native(se_context* context, CYYSTYPE* yylval, char* token) {
     /**
      * Global declarations lookup
      */
-    ENTRY* result;
-    ENTRY request = { .key = token };
-    if (hsearch_r(request, FIND, &result, context->ast.hash_table) != 0) {
-        declaration* dc = (declaration*) result->data;
-        yylval->CTOKEN_ANY_NAME = dc->u__any;
+    stats_count(native_lookups);
+    declaration* dc = ast_symbol_table_find(&context->ast.symbol_table, token);
+    if (dc != NULL) {
+        stats_count(native_hits);
 
         /**
          * Some primitives are not primitives in C
          */
         if (dc->kind == DC_PRIMITIVE && !dc->u_primitive->is_allowed_in_native) {
-            yylval->CTOKEN_IDENTIFIER = copy_string(token);
+            yylval->CTOKEN_IDENTIFIER = token;
+            return CTOKEN_IDENTIFIER;
+        }
+
+        /**
+         * Macros are expanded by the preprocessor, so a constant
+         * name in the native code is an unrelated identifier
+         */
+        if (dc->kind == DC_CONSTANT) {
+            yylval->CTOKEN_IDENTIFIER = token;
             return CTOKEN_IDENTIFIER;
         }
 
@@ -101,71 +113,55 @@ cyytoken_kind_t ast_lex_token_native(se_context* context, CYYSTYPE* yylval, char
          */
         if (dc->is_native) {
             bool declared_locally = false;
-            char* this_filename = arraylist_last(context->file_list)->filename;
-            size_t this_filename_length = strlen(this_filename);
+            char* this_filename = arraylist_last(context->file_list)->native_unit;
             for (int i = 0; i < dc->native_filename_list.size; i++) {
-                if (strncmp(dc->native_filename_list.data[i], this_filename, this_filename_length) == 0) {
+                if (dc->native_filename_list.data[i] == this_filename) {
                     declared_locally = true;
                 }
             }
             if (!declared_locally) {
-                logd("ImportGuard: %s has not been declared in %s yet, setting as identifier",
+                log_debug(LOG_NATIVE, "ImportGuard: %s has not been declared in %s yet, setting as identifier",
                         token, this_filename);
-                yylval->CTOKEN_IDENTIFIER = copy_string(token);
+                yylval->CTOKEN_IDENTIFIER = token;
                 return CTOKEN_IDENTIFIER;
             }
         }
         
+        cst_native_declaration_resolve(dc);
+        yylval->CTOKEN_ANY_NAME = dc->u__any;
         return dc->ctoken;
     }
 
     /**
      * If the token does not match, return IDENTIFIER
      */
-    yylval->CTOKEN_IDENTIFIER = copy_string(token);
+    yylval->CTOKEN_IDENTIFIER = token;
     return CTOKEN_IDENTIFIER;
 }
 
 /**
- * Iterates the context stack to
+ * Looks up the local symbol table of the context to
  * determine the kind of an identifier
  * and assign its value to the yylval parameter
  * 
  * @param[in]  context Pointer to the parser context
  * @param[out] yylval  Sematic value of the token
- * @param[in]  token   The identifier
+ * @param[in]  token   The identifier, interned
  * 
  * @return Token kind, or -1 if not found
  */
 myytoken_kind_t context_lex_token(se_context* context, MYYSTYPE* yylval, char* token) {
-    for (int i = context->stack.size - 1; i >= 0; i--) {
-        se_context_level* current = &context->stack.data[i];
-        switch (current->kind) {
-            case SCTX_SCOPE:
-                /* check local declarations */
-                iterate_array(i, current->u_locals.size) {
-                    local_declaration dc = current->u_locals.data[i];
-                    if (strcmp(token, dc.name) == 0) {
-                        yylval->TOKEN_ANY_NAME = dc.u__any;
-                        return dc.token;
-                    }
-                }
-                break;
-
-            case SCTX_IMPORT:
-                /* imports are identifiers */
-                yylval->TOKEN_IDENTIFIER = copy_string(token);
-                return TOKEN_IDENTIFIER;
-
-            case SCTX_GLOBAL:
-                return -1;
-
-            case SCTX_ENUM:
-            case SCTX_EXPRESSION:
-                break;
+    /* imports are identifiers, they are never nested in a scope */
+    if (context->import_depth > 0) {
+        yylval->TOKEN_IDENTIFIER = token;
+        return TOKEN_IDENTIFIER;
+    }
 
-            otherwise_error
-        }
+    /* check local declarations */
+    local_declaration* dc = scope_table_lookup(&context->scope, token);
+    if (dc != NULL) {
+        yylval->TOKEN_ANY_NAME = dc->u__any;
+        return dc->token;
     }
     return -1;
 }
\ No newline at end of file
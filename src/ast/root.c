@@ -13,17 +13,94 @@
 #include "ast/type/primitive.h" /* primitives */
 #include "syntax/declaration/declaration.h" /* declarations */
 #include "misc/memory.h"     /* memory allocation */
+#include "misc/intern.h"     /* interned strings */
+#include "misc/stats.h"      /* merge statistics */
 #include "language/parser.h" /* parser */
 #include "language/native/parser.h" /* native parser */
 #include "language/native/declaration.h"
 #include "ast/type/check.h"
 
+#include <stdlib.h> /* memory release */
+#include <string.h> /* memory copying */
+
+    /* global variables */
+/**
+ * Number of shared values completed by
+ * all trees that have not been restored yet
+ */
+size_t ast_shared_count = 0;
+
 /**
  * @todo
  * "Precompiled headers" - Serialize processed files' AST's into cache files
  * (De)serialize pointers first (use a "pointer table"), then allocated and resolve them
  */
 
+    /* internal functions */
+/**
+ * Returns the size of a declaration value
+ * 
+ * @param[in] kind Kind of the declaration
+ */
+static size_t ast_value_size(int kind) {
+    switch (kind) {
+        case DC_STRUCTURE:   return sizeof(dc_structure);
+        case DC_ALIAS:       return sizeof(dc_alias);
+        case DC_ENUM:        return sizeof(dc_enum);
+        case DC_FUNCTION:    return sizeof(dc_function);
+        case DC_ST_VARIABLE: return sizeof(dc_st_variable);
+        otherwise_error
+    }
+    return 0;
+}
+
+/**
+ * Saves the contents of a shared value
+ * before the tree completes it in place
+ * 
+ * @param[in] ast Pointer to the AST
+ * @param[in] dc  The shared declaration
+ */
+static void ast_save_shared(ast_root* ast, declaration* dc) {
+    log_debug(LOG_PARSER, "completing shared value %s in place", dc->name);
+    ast_shared_value shared = {
+        .kind = dc->kind,
+        .value = dc->u__any,
+        .saved = checked_malloc(ast_value_size(dc->kind))
+    };
+    memcpy(shared.saved, shared.value, ast_value_size(dc->kind));
+    arl_add(ast_shared_value, ast->shared_list, shared);
+    ast_shared_count++;
+    ast->is_dependent = true;
+}
+
+/**
+ * Completes a partial structure in place, keeping its generic
+ * implementations, as existing types refer to them by index
+ * 
+ * @param[in] this      The partial structure
+ * @param[in] full      The full structure
+ * @param[in] is_shared Whether the full structure is owned by a cached module
+ */
+static void ast_structure_complete(dc_structure* this, dc_structure* full, bool is_shared) {
+    dc_structure saved = *this;
+    *this = *full;
+    this->_generic_impls = saved._generic_impls;
+    this->_layouts = saved._layouts;
+    this->_is_sealed = saved._is_sealed;
+    this->_origin = saved._origin;
+
+    /* types of both values refer to the same structure */
+    if (is_shared) {
+        this->_origin = dc_structure_origin(full);
+        if (!this->_is_sealed) {
+            iterate_array(i, full->_generic_impls.size) {
+                dc_structure_generic_add_impl(this, full->_generic_impls.data[i]);
+            }
+        }
+    }
+}
+
     /* functions */
 /**
  * Initializes an abstract syntax tree instance
@@ -33,13 +110,12 @@
  */
 void ast_init(ast_root* ast) {
     arl_init(declaration_ptr, ast->declaration_list);
-    ast->hash_table = calloc(1, sizeof(struct hsearch_data));
-    hcreate_r(32768, ast->hash_table);
+    ast_symbol_table_init(&ast->symbol_table, AST_SYMBOL_TABLE_DEFAULT_CAPACITY);
+    arl_init(ast_shared_value, ast->shared_list);
+    ast->is_dependent = false;
     /**
      * @todo
      * Arraylist and HashTable addAll functions
-     * Resizable HashTable
-     * Use declaration instead of void*
      */
     iterate_array(i, primitive_list.size) {
         ast_declare(ast, DC_PRIMITIVE, TOKEN_PRIMITIVE_NAME, CTOKEN_PRIMITIVE_NAME, 
@@ -66,6 +142,9 @@ declaration* ast_add_declaration(ast_root* ast, int kind, void* value, bool is_n
     dc->kind = kind;
     dc->u__any = value;
     dc->is_native = is_native;
+    dc->is_shared = false;
+    dc->shared_origin = NULL;
+    dc->native_pending = NULL;
     if (is_native) {
         arraylist_init_with(char_ptr)(&dc->native_filename_list, native_filename);   
     }
@@ -106,11 +185,21 @@ declaration* ast_add_declaration(ast_root* ast, int kind, void* value, bool is_n
             dc->is_full = true;
             break;
 
+        case DC_CONSTANT:
+            dc->name = dc->u_constant->name;
+            dc->is_full = true;
+            break;
+
         otherwise_error
     }
 
+    /* symbol names are always interned */
+    if (dc->name != NULL) {
+        dc->name = intern_string(dc->name);
+    }
+
     if (is_native) {
-        logd("adding new native declaration %s", dc->name);
+        log_debug(LOG_NATIVE, "adding new native declaration %s", dc->name);
         // arl_add(declaration_ptr, ast->declaration_list, dc);
         /* todo should native declarations be added to the ast or no? */
         return dc; /* allow duplicates for native declarations */
@@ -143,43 +232,38 @@ void ast_add_identifier(ast_root* ast, int token, int ctoken, declaration* dc) {
     dc->token = token;
     dc->ctoken = ctoken;
 
-    ENTRY entry = {
-        .data = (void*) dc,
-        .key = dc->name
-    };
-
     /* check if the identifier is already declared */
-    ENTRY* existing;
-    if (hsearch_r(entry, FIND, &existing, ast->hash_table) != 0) {
-        declaration* dc_ex = (declaration*) existing->data;
-
+    declaration* dc_ex = ast_symbol_table_find(&ast->symbol_table, dc->name);
+    if (dc_ex != NULL) {
         /* case 1: necessary merge */
         if (!dc_ex->is_full && dc->is_full) {
-            logd("ImportGuard: redefining %s with a full structure",
+            cst_native_declaration_resolve(dc);
+            log_debug(LOG_NATIVE, "ImportGuard: redefining %s with a full structure",
                 dc->name);
             ast_declaration_merge(ast, dc);
+            if (dc->is_native && dc->native_filename_list.size != 0) {
+                ast_add_native_filename(dc_ex, dc->native_filename_list.data[0]);
+            }
             return;
         }
 
         /* case 2: usual for CST primitives like uchar, ushort, etc. */
         if (!dc_ex->is_native && dc->is_native) {
+            cst_native_declaration_resolve(dc);
             ast_type ex = cst_declaration_to_type(*dc_ex);
             ast_type par = cst_declaration_to_type(*dc);
-            char *exstr, *parstr;
-            logd("ImportGuard: attempt to redefine a non-native type from native code, actual type: original <%s> new <%s>",
-                exstr = ast_type_display_name(&ex), parstr = ast_type_display_name(&par));
-            free(exstr);
-            free(parstr);
+            log_debug(LOG_NATIVE, "ImportGuard: attempt to redefine a non-native type from native code, actual type: original <%s> new <%s>",
+                ast_type_display_name(&ex), ast_type_display_name(&par));
 
             if (ast_type_is_equal(&ex, &par)) {
-                logd("ImportGuard: allowing this, because types are equal");
+                log_debug(LOG_NATIVE, "ImportGuard: allowing this, because types are equal");
                 return;
             }
         }
 
         /* case 3: non-native identifier conflict */
         if (!dc_ex->is_native || !dc->is_native) {
-            error_syntax("identifier \"%s\" already exists", entry.key)
+            error_syntax("identifier \"%s\" already exists", dc->name)
             return;
         }
 
@@ -189,15 +273,77 @@ void ast_add_identifier(ast_root* ast, int token, int ctoken, declaration* dc) {
                     dc->native_filename_list.size);
         }
         char* this_filename = dc->native_filename_list.data[0];
-        logd("ImportGuard: adding %s to list of declarations for %s instead of redefinition",
+        log_debug(LOG_NATIVE, "ImportGuard: adding %s to list of declarations for %s instead of redefinition",
             dc->name, this_filename);
-        arraylist_add(char_ptr)(&dc_ex->native_filename_list, this_filename);
+        ast_add_native_filename(dc_ex, this_filename);
         return;
     }
     
     /* if it is not declared, add the entry */
-    if (hsearch_r(entry, ENTER, &existing, ast->hash_table) == 0) {
-        error_internal("unable to add new symbol to the symbol table");
+    ast_symbol_table_insert(&ast->symbol_table, dc->name, dc);
+}
+
+
+/**
+ * Adds a native file to the files which declare
+ * a native declaration, if it is not listed yet
+ * 
+ * @param[in] dc              Pointer to the declaration
+ * @param[in] native_filename The native file
+ */
+void ast_add_native_filename(declaration* dc, char* native_filename) {
+    if (!dc->is_native) {
+        return;
+    }
+    iterate_array(i, dc->native_filename_list.size) {
+        if (dc->native_filename_list.data[i] == native_filename) {
+            return;
+        }
+    }
+    arraylist_add(char_ptr)(&dc->native_filename_list, native_filename);
+}
+
+
+/**
+ * Adds a declaration owned by another
+ * abstract syntax tree, such as a cached module
+ * 
+ * The declaration is copied, but its value is shared,
+ * so a declaration linked through several modules
+ * is only added once
+ * 
+ * @param[in] ast    Pointer to the AST
+ * @param[in] source The declaration to link
+ */
+void ast_link_declaration(ast_root* ast, declaration* source) {
+    declaration* dc_ex = ast_symbol_table_find(&ast->symbol_table, source->name);
+    if (dc_ex != NULL) {
+        if (dc_ex->u__any == source->u__any || dc_ex->shared_origin == source->u__any) {
+            return; /* already linked */
+        }
+        if (dc_ex->is_native && source->is_native) {
+            return; /* the same native file parsed by another module */
+        }
+    }
+
+    declaration* dc = allocate(declaration);
+    *dc = *source;
+    dc->is_shared = true;
+
+    /* native declarations are only added to the lookup table */
+    if (dc->is_native) {
+        arraylist_init_empty(char_ptr)(&dc->native_filename_list);
+        iterate_array(i, source->native_filename_list.size) {
+            arraylist_add(char_ptr)(&dc->native_filename_list, source->native_filename_list.data[i]);
+        }
+        ast_add_identifier(ast, dc->token, dc->ctoken, dc);
+        return;
+    }
+
+    /* conflicts are resolved as if the declaration was parsed in place */
+    if (!ast_declaration_merge(ast, dc)) {
+        arl_add(declaration_ptr, ast->declaration_list, dc);
+        ast_symbol_table_insert(&ast->symbol_table, dc->name, dc);
     }
 }
 
@@ -211,17 +357,13 @@ void ast_add_identifier(ast_root* ast, int token, int ctoken, declaration* dc) {
  * @return Pointer to the declaration structure or NULL
  */
 declaration* ast_declaration_lookup(ast_root* ast, char* name) {
-    ENTRY entry = {
-        .data = NULL,
-        .key = name
-    };
-
-    ENTRY* existing;
-    if (hsearch_r(entry, FIND, &existing, ast->hash_table) != 0) {
-        return (declaration*) existing->data;
-    } else {
+    /* a string that has never been interned cannot be a symbol */
+    char* key = intern_find(name);
+    if (key == NULL) {
         return NULL;
     }
+
+    return ast_symbol_table_find(&ast->symbol_table, key);
 }
 
 
@@ -239,7 +381,7 @@ declaration* ast_declaration_lookup(ast_root* ast, char* name) {
 bool ast_declaration_merge(ast_root* ast, declaration* dc) {
     declaration* dc_parent = ast_declaration_lookup(ast, dc->name);
     if (dc_parent == NULL && dc->name != NULL) {
-        logd("adding new declaration %s", dc->name);
+        log_debug(LOG_PARSER, "adding new declaration %s", dc->name);
         return false;
     }
 
@@ -252,15 +394,33 @@ bool ast_declaration_merge(ast_root* ast, declaration* dc) {
         return true;
     }
 
-    logd("merging %s and %s", dc->name, dc_parent->name)
+    stats_count(merges);
+
+    /* values owned by a cached module are completed in place and restored later */
+    if (dc_parent->is_shared) {
+        ast_save_shared(ast, dc_parent);
+    }
+    /* only the lists of values owned by this tree are released */
+    bool is_owned = !dc_parent->is_shared && dc_parent->shared_origin == NULL;
+
+    log_debug(LOG_PARSER, "merging %s and %s", dc->name, dc_parent->name)
     switch (dc->kind) {
         case DC_STRUCTURE:
             dc_structure* sparent = dc_parent->u_structure;
             dc_structure* sthis = dc->u_structure;
 
-            list_free(dc_structure_member)(&sparent->member_list);
-            
-            memcpy(sparent, sthis, sizeof(dc_structure));
+            if (is_owned) {
+                list_free(dc_structure_member)(&sparent->member_list);
+            }
+
+            if (dc_parent->is_shared || dc->is_shared) {
+                ast_structure_complete(sparent, sthis, dc->is_shared);
+                if (dc_parent->is_shared) {
+                    arraylist_init_empty(ast_layout)(&sparent->_layouts);
+                }
+            } else {
+                memcpy(sparent, sthis, sizeof(dc_structure));
+            }
             dc_parent->is_full = sparent->is_full;
             break;
 
@@ -275,14 +435,23 @@ bool ast_declaration_merge(ast_root* ast, declaration* dc) {
         case DC_ENUM:
             dc_enum* eparent = dc_parent->u_enum;
             dc_enum* ethis = dc->u_enum;
+            dc_enum* eorigin = dc->is_shared ? dc_enum_origin(ethis) : eparent->_origin;
 
-            list_free(dc_enum_member)(&eparent->member_list);
-
-            for (int i = 0; i < ethis->member_list.size; i++) {
-                ethis->member_list.data[i].parent = eparent;
+            if (is_owned) {
+                list_free(dc_enum_member)(&eparent->member_list);
             }
 
             memcpy(eparent, ethis, sizeof(dc_enum));
+            eparent->_origin = eorigin;
+            if (dc->is_shared) {
+                /* the members of a shared value are copied */
+                li_init(dc_enum_member, eparent->member_list, ethis->member_list.size);
+                memcpy(eparent->member_list.data, ethis->member_list.data,
+                    ethis->member_list.size * sizeof(dc_enum_member));
+            }
+            for (int i = 0; i < eparent->member_list.size; i++) {
+                eparent->member_list.data[i].parent = eparent;
+            }
             dc_parent->is_full = eparent->is_full;
             break;
 
@@ -290,7 +459,9 @@ bool ast_declaration_merge(ast_root* ast, declaration* dc) {
             dc_function* fparent = dc_parent->u_function;
             dc_function* fthis = dc->u_function;
 
-            list_free(dc_function_parameter)(&fparent->parameters.value);
+            if (is_owned) {
+                list_free(dc_function_parameter)(&fparent->parameters.value);
+            }
             
             memcpy(fparent, fthis, sizeof(dc_function));
             dc_parent->is_full = fparent->is_full;
@@ -306,8 +477,76 @@ bool ast_declaration_merge(ast_root* ast, declaration* dc) {
 
         otherwise_error
     }
-    
-    //dc_parent->u__any = dc->u__any;
-    //free(dc->name);
+
+    /* the shared value is linked already */
+    if (dc->is_shared) {
+        dc_parent->shared_origin = dc->u__any;
+    }
     return true;
+}
+
+/**
+ * Adds a generic implementation to a structure used by the tree,
+ * copying the structure first if it is owned by a cached module
+ * 
+ * @param[in]     ast       Pointer to the AST
+ * @param[in,out] structure The structure, replaced with its copy if needed
+ * @param[in]     impl      The list of types for the generic implementation
+ * 
+ * @return The index of the implementation
+ */
+index_t ast_structure_add_impl(ast_root* ast, dc_structure** structure, list(ast_type) impl) {
+    dc_structure* value = *structure;
+    if (value->_is_sealed && value->generics.size != 0 && impl.size == value->generics.size) {
+        index_t index;
+        if (dc_structure_generic_find_impl(value, impl, &index)) {
+            return index;
+        }
+
+        /* the copy is owned by this tree and keeps the indices of the original */
+        declaration* dc = ast_declaration_lookup(ast, value->name);
+        if (dc == NULL || dc->kind != DC_STRUCTURE
+            || dc_structure_origin(dc->u_structure) != dc_structure_origin(value)) {
+            logfe("generic structure %s is not declared", value->name);
+        }
+        if (dc->u_structure->_is_sealed) {
+            log_debug(LOG_PARSER, "copying shared structure %s to add an implementation", value->name);
+            dc->shared_origin = dc->u_structure;
+            dc->u_structure = dc_structure_copy(dc->u_structure);
+            dc->is_shared = false;
+            ast->is_dependent = true;
+        }
+        value = dc->u_structure;
+        *structure = value;
+    }
+    return dc_structure_generic_add_impl(value, impl);
+}
+
+/**
+ * Restores the shared values completed by the tree,
+ * so that other trees linking the same modules do not
+ * see memory of this one
+ * 
+ * @param[in] ast Pointer to the AST
+ */
+void ast_restore_shared(ast_root* ast) {
+    while (ast->shared_list.size != 0) {
+        ast_shared_value shared = arraylist_last(ast->shared_list);
+        arl_pop(ast_shared_value, ast->shared_list);
+
+        /* layouts computed from the completed value are dropped */
+        if (shared.kind == DC_STRUCTURE) {
+            dc_structure* structure = shared.value;
+            iterate_array(i, structure->_layouts.size) {
+                if (structure->_layouts.data[i].state == AT_LAYOUT_KNOWN) {
+                    free(structure->_layouts.data[i].offsets);
+                }
+            }
+            arraylist_free(ast_layout)(&structure->_layouts);
+        }
+
+        memcpy(shared.value, shared.saved, ast_value_size(shared.kind));
+        free(shared.saved);
+        ast_shared_count--;
+    }
 }
\ No newline at end of file
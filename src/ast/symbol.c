@@ -0,0 +1,181 @@
+/**
+ * @file symbol.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ *  Resizable symbol table implementation
+ */
+    /* includes */
+#include "ast/symbol.h" /* this */
+
+#include <stdlib.h> /* memory allocation */
+
+#include "misc/intern.h" /* interned keys */
+#include "misc/error.h"  /* error throw */
+#include "misc/timer.h"  /* phase timers */
+#include "misc/stats.h"  /* table statistics */
+
+    /* internal functions */
+/**
+ * Finds the slot of a key, or the
+ * empty slot where it should be inserted
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] key   The interned key
+ * @param[in] hash  Hash of the key
+ * 
+ * @return Index of the slot
+ */
+static inline size_t ast_symbol_table_probe(ast_symbol_table* table, char* key, uint64_t hash) {
+    size_t mask = table->capacity - 1;
+    size_t index = hash & mask;
+    while (table->data[index].key != NULL && table->data[index].key != key) {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+/**
+ * Allocates the slot array of a table
+ * 
+ * @param[out] table    Pointer to the table
+ * @param[in]  capacity The capacity, a power of two
+ */
+static void ast_symbol_table_allocate(ast_symbol_table* table, size_t capacity) {
+    table->data = calloc(capacity, sizeof(ast_symbol));
+    if (table->data == NULL) {
+        error_internal("failed to allocate a symbol table of %zu entries", capacity);
+    }
+    table->capacity = capacity;
+}
+
+/**
+ * Doubles the capacity of a table
+ * and reinserts every symbol
+ * 
+ * @param[in] table Pointer to the table
+ */
+static void ast_symbol_table_grow(ast_symbol_table* table) {
+    ast_symbol* old_data = table->data;
+    size_t old_capacity = table->capacity;
+
+    stats_count(symbol_grows);
+    ast_symbol_table_allocate(table, old_capacity * 2);
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_data[i].key != NULL) {
+            size_t index = ast_symbol_table_probe(table, old_data[i].key, old_data[i].hash);
+            table->data[index] = old_data[i];
+        }
+    }
+    free(old_data);
+}
+
+    /* functions */
+/**
+ * Initializes an empty symbol table
+ * 
+ * @param[out] table    Pointer to the table
+ * @param[in]  capacity Initial capacity, rounded up to a power of two
+ */
+void ast_symbol_table_init(ast_symbol_table* table, size_t capacity) {
+    size_t actual = 16;
+    while (actual < capacity) {
+        actual *= 2;
+    }
+    ast_symbol_table_allocate(table, actual);
+    table->size = 0;
+}
+
+/**
+ * Releases the memory of a symbol table
+ * 
+ * @param[in] table Pointer to the table
+ */
+void ast_symbol_table_free(ast_symbol_table* table) {
+    free(table->data);
+    table->data = NULL;
+    table->capacity = 0;
+    table->size = 0;
+}
+
+/**
+ * Looks up a symbol by its name
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] key   Interned name of the symbol
+ * 
+ * @return The declaration or NULL if not found
+ */
+declaration* ast_symbol_table_find(ast_symbol_table* table, char* key) {
+    uint64_t start = timer_start_sampled(TIMER_SYMBOL_TABLE);
+    size_t index = ast_symbol_table_probe(table, key, intern_hash(key));
+    timer_stop_sampled(TIMER_SYMBOL_TABLE, start);
+    return table->data[index].value;
+}
+
+/**
+ * Adds a new symbol to the table,
+ * growing it if needed
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] key   Interned name of the symbol
+ * @param[in] value The declaration
+ * 
+ * @return false if the symbol already exists (the table is unchanged),
+ *          true if it has been added
+ */
+bool ast_symbol_table_insert(ast_symbol_table* table, char* key, declaration* value) {
+    uint64_t start = timer_start_sampled(TIMER_SYMBOL_TABLE);
+    if ((table->size + 1) * 100 > table->capacity * AST_SYMBOL_TABLE_LOAD_FACTOR) {
+        ast_symbol_table_grow(table);
+    }
+
+    uint64_t hash = intern_hash(key);
+    size_t index = ast_symbol_table_probe(table, key, hash);
+    if (table->data[index].key != NULL) {
+        timer_stop_sampled(TIMER_SYMBOL_TABLE, start);
+        return false;
+    }
+
+    table->data[index].hash = hash;
+    table->data[index].key = key;
+    table->data[index].value = value;
+    table->size++;
+    timer_stop_sampled(TIMER_SYMBOL_TABLE, start);
+    return true;
+}
+
+/**
+ * Removes a symbol from the table
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] key   Interned name of the symbol
+ * 
+ * @return false if the symbol has not been found
+ */
+bool ast_symbol_table_remove(ast_symbol_table* table, char* key) {
+    size_t mask = table->capacity - 1;
+    size_t index = ast_symbol_table_probe(table, key, intern_hash(key));
+    if (table->data[index].key == NULL) {
+        return false;
+    }
+
+    /* shift back every following entry which is allowed to move into the hole */
+    size_t hole = index;
+    size_t next = (hole + 1) & mask;
+    while (table->data[next].key != NULL) {
+        size_t home = table->data[next].hash & mask;
+        /* distance from home to next must cover the hole */
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            table->data[hole] = table->data[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    table->data[hole].key = NULL;
+    table->data[hole].value = NULL;
+
+    table->size--;
+    return true;
+}
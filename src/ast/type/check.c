@@ -234,7 +234,6 @@ bool ast_type_is_equal(ast_type* a, ast_type* b) {
         bool result = ast_type_is_equal(a, b);
 
         arraylist_free(ast_type_level)(&a->level_list);
-        free(a);
         return result;
     }
     if (b->kind == AST_TYPE_GENERIC) {
@@ -242,7 +241,6 @@ bool ast_type_is_equal(ast_type* a, ast_type* b) {
         bool result = ast_type_is_equal(a, b);
 
         arraylist_free(ast_type_level)(&b->level_list);
-        free(b);
         return result;
     }
 
@@ -281,6 +279,13 @@ bool ast_type_is_equal(ast_type* a, ast_type* b) {
         }
     }
 
+    /* copies of a structure or an enumeration are the same type */
+    if (a->kind == AST_TYPE_STRUCTURE) {
+        return dc_structure_origin(a->u_structure) == dc_structure_origin(b->u_structure);
+    }
+    if (a->kind == AST_TYPE_ENUM) {
+        return dc_enum_origin(a->u_enum) == dc_enum_origin(b->u_enum);
+    }
     if (a->u__any != b->u__any) return false;
 
     return true;
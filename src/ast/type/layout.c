@@ -0,0 +1,307 @@
+/**
+ * @file layout.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Compile-time memory layout implementation
+ */
+    /* includes */
+#include "ast/type/layout.h" /* this */
+
+#include <stdint.h> /* integer limits */
+#include <stdlib.h> /* memory release */
+#include <string.h> /* memory copying */
+
+#include "syntax/declaration/declaration.h" /* declarations */
+#include "ast/type/primitive.h" /* primitives */
+#include "misc/memory.h" /* memory allocation */
+
+    /* global variables */
+/**
+ * Number of structure layouts being computed, generic
+ * types only have a known implementation inside of them
+ */
+static int layout_depth = 0;
+
+    /* internal functions */
+/**
+ * Aligns an offset up to an alignment
+ *
+ * @param[in] offset    The offset
+ * @param[in] alignment The alignment, a power of two
+ *
+ * @return The aligned offset
+ */
+static inline size_t ast_layout_align(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * Checks whether a generic implementation
+ * refers to no generic types, so that its
+ * layout does not depend on the outer structure
+ *
+ * @param[in] impl The generic implementation
+ *
+ * @return true if the layout may be cached
+ */
+static bool ast_layout_impl_is_concrete(list(ast_type) impl) {
+    iterate_array(i, impl.size) {
+        if (impl.data[i].kind == AST_TYPE_GENERIC) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Checks whether every member of an enum fits
+ * into an int, which is the size of an enum in C
+ *
+ * @param[in] value The enum
+ *
+ * @return false if the enum is partial or has larger members
+ */
+static bool ast_layout_enum_is_int(dc_enum* value) {
+    if (!value->is_full) {
+        return false;
+    }
+    iterate_array(i, value->member_list.size) {
+        ex_constant* constant = &value->member_list.data[i].value;
+        switch (constant->kind) {
+            case EX_C_BYTE:
+            case EX_C_SHORT:
+            case EX_C_INT:
+            case EX_C_UBYTE:
+            case EX_C_USHORT:
+                break;
+
+            case EX_C_LONG:
+                if (constant->u_long < INT32_MIN || constant->u_long > INT32_MAX) {
+                    return false;
+                }
+                break;
+
+            case EX_C_UINT:
+                if (constant->u_uint > INT32_MAX) {
+                    return false;
+                }
+                break;
+
+            case EX_C_ULONG:
+                if (constant->u_ulong > INT32_MAX) {
+                    return false;
+                }
+                break;
+
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Computes the layout of a structure with
+ * the generic implementation applied
+ *
+ * @param[in]  structure The structure
+ * @param[out] layout    The layout
+ */
+static void ast_layout_compute(dc_structure* structure, ast_layout* layout) {
+    layout->size = 0;
+    layout->alignment = 1;
+    layout->offsets = checked_malloc(sizeof(size_t) * (structure->member_list.size + 1));
+
+    iterate_array(i, structure->member_list.size) {
+        size_t size, alignment;
+        if (!ast_layout_of_type(&structure->member_list.data[i].type, &size, &alignment)) {
+            free(layout->offsets);
+            layout->offsets = NULL;
+            layout->state = AT_LAYOUT_UNKNOWN;
+            return;
+        }
+
+        layout->size = ast_layout_align(layout->size, alignment);
+        layout->offsets[i] = layout->size;
+        layout->size += size;
+        if (alignment > layout->alignment) {
+            layout->alignment = alignment;
+        }
+    }
+
+    /* trailing padding, an empty structure has the size of zero in GNU C */
+    layout->size = ast_layout_align(layout->size, layout->alignment);
+    layout->state = AT_LAYOUT_KNOWN;
+}
+
+    /* functions */
+/**
+ * Computes the size and the alignment of a type
+ *
+ * @param[in]  value     Pointer to the type
+ * @param[out] size      Size of the type in bytes
+ * @param[out] alignment Alignment of the type in bytes
+ *
+ * @return false if the layout is not known at compile time
+ */
+bool ast_layout_of_type(ast_type* value, size_t* size, size_t* alignment) {
+    /* every level is generated as a pointer */
+    if (value->level_list.size != 0) {
+        *size = sizeof(void*);
+        *alignment = _Alignof(void*);
+        return true;
+    }
+
+    switch (value->kind) {
+        case AST_TYPE_PRIMITIVE:
+            if (value->u_primitive->size == 0) {
+                return false; /* void and the internal any type */
+            }
+            *size = value->u_primitive->size;
+            *alignment = value->u_primitive->alignment;
+            return true;
+
+        case AST_TYPE_STRUCTURE: {
+            ast_layout* layout = ast_layout_of_structure(value->u_structure, value->_generic_impl_index);
+            if (layout == NULL) {
+                return false;
+            }
+            *size = layout->size;
+            *alignment = layout->alignment;
+            return true;
+        }
+
+        case AST_TYPE_ENUM:
+            if (!ast_layout_enum_is_int(value->u_enum)) {
+                return false;
+            }
+            *size = sizeof(int32_t);
+            *alignment = _Alignof(int32_t);
+            return true;
+
+        case AST_TYPE_GENERIC: {
+            if (layout_depth == 0) {
+                return false;
+            }
+            ast_type* impl = dc_generic_get_impl(value);
+            bool result = ast_layout_of_type(impl, size, alignment);
+            arraylist_free(ast_type_level)(&impl->level_list);
+            return result;
+        }
+
+        case AST_TYPE_FUNCTION:
+            return false;
+
+        otherwise_error
+    }
+    return false;
+}
+
+/**
+ * Returns the cached layout of a structure,
+ * computing it on first use
+ *
+ * @param[in] structure  The structure
+ * @param[in] impl_index The generic implementation index,
+ *                       ignored for non-generic structures
+ *
+ * @return Pointer to the layout, or NULL if it is not known
+ *          at compile time
+ */
+ast_layout* ast_layout_of_structure(dc_structure* structure, index_t impl_index) {
+    if (structure->is_c_struct || !structure->is_full) {
+        return NULL;
+    }
+    bool is_generic = structure->generics.size != 0;
+    if (!is_generic) {
+        impl_index = 0;
+    } else if (impl_index >= structure->_generic_impls.size) {
+        return NULL;
+    }
+
+    /* cached layouts */
+    while (structure->_layouts.size <= impl_index) {
+        ast_layout pending = { .state = AT_LAYOUT_PENDING };
+        arl_add(ast_layout, structure->_layouts, pending);
+    }
+    switch (structure->_layouts.data[impl_index].state) {
+        case AT_LAYOUT_KNOWN:
+            return &structure->_layouts.data[impl_index];
+
+        case AT_LAYOUT_COMPUTING: /* the structure contains itself */
+        case AT_LAYOUT_UNKNOWN:
+            return NULL;
+
+        case AT_LAYOUT_PENDING:
+            break;
+
+        otherwise_error
+    }
+
+    /* apply the generic implementation, keeping the current one */
+    list(ast_type) impl;
+    ast_type* saved = NULL;
+    bool is_cached = true;
+    if (is_generic) {
+        impl = structure->_generic_impls.data[impl_index];
+        is_cached = ast_layout_impl_is_concrete(impl);
+        saved = allocate_array(ast_type, structure->generics.size);
+        iterate_array(i, structure->generics.size) {
+            saved[i] = structure->generics.data[i]->_impl;
+        }
+        dc_structure_generic_apply_impl(structure, impl);
+    }
+
+    /* the list may grow while the members are computed */
+    ast_layout layout;
+    structure->_layouts.data[impl_index].state = AT_LAYOUT_COMPUTING;
+    layout_depth++;
+    ast_layout_compute(structure, &layout);
+    layout_depth--;
+
+    if (is_generic) {
+        iterate_array(i, structure->generics.size) {
+            structure->generics.data[i]->_impl = saved[i];
+        }
+    }
+
+    /* the layout of an implementation with generic types depends on the outer structure */
+    if (!is_cached) {
+        structure->_layouts.data[impl_index].state = AT_LAYOUT_PENDING;
+        if (layout.state != AT_LAYOUT_KNOWN) {
+            return NULL;
+        }
+        /* the uncached copy is owned by the current arena */
+        ast_layout* result = allocate(ast_layout);
+        *result = layout;
+        result->offsets = allocate_array(size_t, structure->member_list.size + 1);
+        memcpy(result->offsets, layout.offsets, sizeof(size_t) * (structure->member_list.size + 1));
+        free(layout.offsets);
+        return result;
+    }
+    structure->_layouts.data[impl_index] = layout;
+    return layout.state == AT_LAYOUT_KNOWN ? &structure->_layouts.data[impl_index] : NULL;
+}
+
+/**
+ * Computes the offset of a structure member
+ *
+ * @param[in]  value  Pointer to the structure type
+ * @param[in]  member Index of the member
+ * @param[out] offset Offset of the member in bytes
+ *
+ * @return false if the layout is not known at compile time
+ */
+bool ast_layout_offset_of(ast_type* value, size_t member, size_t* offset) {
+    if (value->kind != AST_TYPE_STRUCTURE || value->level_list.size != 0) {
+        return false;
+    }
+    ast_layout* layout = ast_layout_of_structure(value->u_structure, value->_generic_impl_index);
+    if (layout == NULL) {
+        return false;
+    }
+    *offset = layout->offsets[member];
+    return true;
+}
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "ast/type/primitive.h" /* this */
 
 #include <float.h> /* maximum float values */
+#include <stdint.h> /* alignment of code types */
 
     /* global variables */
 /**
@@ -26,14 +27,16 @@ list(ast_type_primitive) primitive_list;
  * @param[in] _name       Primitive type name
  * @param[in] _code_name  Primitive type actual (code) name
  * @param[in] _size       Primitive type size
+ * @param[in] _alignment  Primitive type alignment, as of its code type
  * @param[in] _capacity   Maximum numerical value of the type
  *                          or 0 if inappicable
  * @param[in] _is_allowed_in_native Some primitives are not primitives in C
  */
-#define ast_declare_primitive(_index_name, _name, _code_name, _size, _capacity, _is_allowed_in_native) \
+#define ast_declare_primitive(_index_name, _name, _code_name, _size, _alignment, _capacity, _is_allowed_in_native) \
     primitive_list.data[PRIMITIVE_INDEX_##_index_name].name = _name;            \
     primitive_list.data[PRIMITIVE_INDEX_##_index_name].code_name = _code_name;  \
     primitive_list.data[PRIMITIVE_INDEX_##_index_name].size = _size;            \
+    primitive_list.data[PRIMITIVE_INDEX_##_index_name].alignment = _alignment;  \
     primitive_list.data[PRIMITIVE_INDEX_##_index_name].capacity = _capacity;    \
     primitive_list.data[PRIMITIVE_INDEX_##_index_name].is_allowed_in_native = _is_allowed_in_native;
 
@@ -46,25 +49,25 @@ void primitive_list_init() {
     /* ! DO NOT CHANGE THE ORDER, PRIMITIVE LOOKUP DEPENDS ON IT ! */
     //todo - add "c" primitive types that codegen to native C types
     li_init(ast_type_primitive, primitive_list, _PRIMITIVE_INDEX_MAX + 1);
-    ast_declare_primitive(VOID,   "void",   "void",     0, 0, true);
-    ast_declare_primitive(BOOLEAN,   "bool",   "int8_t",   1, 0, false);
+    ast_declare_primitive(VOID,   "void",   "void",     0, 0, 0, true);
+    ast_declare_primitive(BOOLEAN,   "bool",   "int8_t",   1, _Alignof(int8_t), 0, false);
 
-    ast_declare_primitive(CHAR,   "char",   "int8_t",   1, __INT8_MAX__, true);
-    ast_declare_primitive(BYTE,   "byte",   "int8_t",   1, __INT8_MAX__, false);
-    ast_declare_primitive(SHORT,  "short",  "int16_t",  2, __INT16_MAX__, true);
-    ast_declare_primitive(INT,    "int",    "int32_t",  4, __INT32_MAX__, true);
-    ast_declare_primitive(LONG,   "long",   "int64_t",  8, __INT64_MAX__, true);
+    ast_declare_primitive(CHAR,   "char",   "int8_t",   1, _Alignof(int8_t), __INT8_MAX__, true);
+    ast_declare_primitive(BYTE,   "byte",   "int8_t",   1, _Alignof(int8_t), __INT8_MAX__, false);
+    ast_declare_primitive(SHORT,  "short",  "int16_t",  2, _Alignof(int16_t), __INT16_MAX__, true);
+    ast_declare_primitive(INT,    "int",    "int32_t",  4, _Alignof(int32_t), __INT32_MAX__, true);
+    ast_declare_primitive(LONG,   "long",   "int64_t",  8, _Alignof(int64_t), __INT64_MAX__, true);
 
-    ast_declare_primitive(UCHAR,  "uchar",   "uint8_t",  1, __UINT8_MAX__, false);
-    ast_declare_primitive(UBYTE,  "ubyte",   "uint8_t",  1, __UINT8_MAX__, false);
-    ast_declare_primitive(USHORT, "ushort",  "uint16_t", 2, __UINT16_MAX__, false);
-    ast_declare_primitive(UINT,   "uint",    "uint32_t", 4, __UINT32_MAX__, false);
-    ast_declare_primitive(ULONG,  "ulong",   "uint64_t", 8, __UINT64_MAX__, false);
+    ast_declare_primitive(UCHAR,  "uchar",   "uint8_t",  1, _Alignof(uint8_t), __UINT8_MAX__, false);
+    ast_declare_primitive(UBYTE,  "ubyte",   "uint8_t",  1, _Alignof(uint8_t), __UINT8_MAX__, false);
+    ast_declare_primitive(USHORT, "ushort",  "uint16_t", 2, _Alignof(uint16_t), __UINT16_MAX__, false);
+    ast_declare_primitive(UINT,   "uint",    "uint32_t", 4, _Alignof(uint32_t), __UINT32_MAX__, false);
+    ast_declare_primitive(ULONG,  "ulong",   "uint64_t", 8, _Alignof(uint64_t), __UINT64_MAX__, false);
 
-    ast_declare_primitive(FLOAT,  "float",  "float",    4, 16777216UL /* 2 ^ 24 (mantissa bits) */, true);
-    ast_declare_primitive(DOUBLE, "double", "double",   8, 9007199254740992UL /* 2 ^ 53 (mantissa bits) */, true);
+    ast_declare_primitive(FLOAT,  "float",  "float",    4, _Alignof(float), 16777216UL /* 2 ^ 24 (mantissa bits) */, true);
+    ast_declare_primitive(DOUBLE, "double", "double",   8, _Alignof(double), 9007199254740992UL /* 2 ^ 53 (mantissa bits) */, true);
 
-    ast_declare_primitive(ANY, "<__cst_any>", "<__cst_any>", 0, 0, false);
+    ast_declare_primitive(ANY, "<__cst_any>", "<__cst_any>", 0, 0, 0, false);
 }
 
 /**
@@ -62,6 +62,9 @@ void ast_type_clone_to(ast_type* dest, ast_type src) {
     iterate_array(i, src.level_list.size) {
         arl_add(ast_type_level, dest->level_list, src.level_list.data[i]);
     }
+    if (memstat_mode && src.level_list.size != 0) {
+        memstat_count("ast_type_level", sizeof(ast_type_level) * src.level_list.size, MEMSTAT_SITE);
+    }
 }
 
 /**
@@ -99,6 +102,9 @@ ast_type* ast_type_clone(ast_type value) {
 void ast_type_array_wrap(ast_type* value) {
     ast_type_level level = { .kind = AT_LEVEL_ARRAY, .u_array_size = NULL };
     arl_add(ast_type_level, value->level_list, level);
+    if (memstat_mode) {
+        memstat_count("ast_type_level", sizeof(ast_type_level), MEMSTAT_SITE);
+    }
 }
 
 void ast_type_constant_array_wrap(ast_type* value, expression_data* size) {
@@ -108,11 +114,17 @@ void ast_type_constant_array_wrap(ast_type* value, expression_data* size) {
 
     ast_type_level level = { .kind = AT_LEVEL_ARRAY, .u_array_size = size };
     arl_add(ast_type_level, value->level_list, level);
+    if (memstat_mode) {
+        memstat_count("ast_type_level", sizeof(ast_type_level), MEMSTAT_SITE);
+    }
 }
 
 void ast_type_pointer_wrap(ast_type* value) {
     ast_type_level level = { .kind = AT_LEVEL_POINTER, .u_array_size = NULL };
     arl_add(ast_type_level, value->level_list, level);
+    if (memstat_mode) {
+        memstat_count("ast_type_level", sizeof(ast_type_level), MEMSTAT_SITE);
+    }
 }
 
 /**
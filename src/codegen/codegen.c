@@ -13,19 +13,22 @@
 
 #include "ast/root.h" /* abstract syntax tree */
 #include "ast/type/primitive.h" /* primitives */
+#include "ast/type/layout.h" /* type layouts */
 #include "syntax/statement/statement.h" /* statements */
 #include "syntax/declaration/declaration.h" /* declarations */
 #include "misc/memory.h" /* memory allocation */
+#include "misc/timer.h" /* phase timers */
+#include "misc/trace.h" /* trace output */
 
     /* defines */
 /**
  * Code generation task (for structures, functions, etc.)
  * declaration and invocation macro
  */
-#define cgtask_declare_ast(name) void macro_concatenate(codegen_task_, name)(FILE* file, ast_root* ast)
-#define cgtask_declare(name) void macro_concatenate(codegen_task_, name)(FILE* file)
-#define cgtask_ast(name) macro_concatenate(codegen_task_, name)(file, ast)
-#define cgtask(name) macro_concatenate(codegen_task_, name)(file)
+#define cgtask_declare_ast(name) void macro_concatenate(codegen_task_, name)(cg_output* output, ast_root* ast)
+#define cgtask_declare(name) void macro_concatenate(codegen_task_, name)(cg_output* output)
+#define cgtask_ast(name) macro_concatenate(codegen_task_, name)(output, ast)
+#define cgtask(name) macro_concatenate(codegen_task_, name)(output)
 
     /* forward declarations */
 cgd_type();
@@ -55,6 +58,19 @@ char* get_tmp_name_from(int* tmp) {
 
         /* code generation functions */
 
+    /** TYPE SIZE **/
+
+cgd(type_size, ast_type* type) {
+    size_t size, alignment;
+    if (ast_layout_of_type(type, &size, &alignment)) {
+        out(format)("%zu", size);
+    } else {
+        out(string)("sizeof(");
+        cg(type)(type);
+        out(char)(')');
+    }
+}
+
     /** CONSTRUCTOR EXPRESSION **/
 
 cgd_ex(constructor) {
@@ -70,13 +86,18 @@ cgd_ex(constructor) {
 
     if (ex->is_array) {
         if (ex->is_new) {
-            out(string)(" = malloc(sizeof(");
-            cg(type)(ex->type);
-            out(string)(") * ");
-            if (ex->u_array_size != NULL) {
-                cg(ex_expression_data)(ex->u_array_size);
+            size_t size, alignment;
+            out(string)(" = malloc(");
+            if (ex->u_array_size == NULL && ast_layout_of_type(ex->type, &size, &alignment)) {
+                out(format)("%zu", size * ex->argument_list.size);
             } else {
-                out(format)("%zu", ex->argument_list.size);
+                cg(type_size)(ex->type);
+                out(string)(" * ");
+                if (ex->u_array_size != NULL) {
+                    cg(ex_expression_data)(ex->u_array_size);
+                } else {
+                    out(format)("%zu", ex->argument_list.size);
+                }
             }
             out(string)(");\n");
 
@@ -110,9 +131,9 @@ cgd_ex(constructor) {
         switch (ex->type->kind) {
             case AST_TYPE_STRUCTURE:
                 if (ex->is_new) {
-                    out(string)(" = malloc(sizeof(");
-                    cg(type)(ex->type);
-                    out(string)("));\n");
+                    out(string)(" = malloc(");
+                    cg(type_size)(ex->type);
+                    out(string)(");\n");
 
                     iterate_array(i, ex->type->u_structure->member_list.size) {
                         out(tabs)();
@@ -136,9 +157,9 @@ cgd_ex(constructor) {
 
             case AST_TYPE_PRIMITIVE:
                 if (ex->is_new) {
-                    out(string)(" = malloc(sizeof(");
-                    cg(type)(ex->type);
-                    out(string)("));\n");
+                    out(string)(" = malloc(");
+                    cg(type_size)(ex->type);
+                    out(string)(");\n");
 
                     out(tabs)();
                     out(format)("*%s = ", ex->u_variable_name);
@@ -207,7 +228,6 @@ cgd_type() {
             cg(type)(impl);
 
             arraylist_free(ast_type_level)(&impl->level_list);
-            free(impl);
             return; /* ! */
 
         case AST_TYPE_STRUCTURE:
@@ -359,6 +379,36 @@ cgd_ex(constant) {
 }
 
 
+    /** LAYOUT EXPRESSION **/
+
+cgd_ex(layout) {
+    if (ex->is_known) {
+        out(format)("%zuUL", ex->value);
+        return;
+    }
+
+    switch (ex->kind) {
+        case EX_L_SIZEOF:
+            out(string)("sizeof(");
+            cg(type)(ex->type);
+            break;
+
+        case EX_L_ALIGNOF:
+            out(string)("_Alignof(");
+            cg(type)(ex->type);
+            break;
+
+        case EX_L_OFFSETOF:
+            out(string)("offsetof(");
+            cg(type)(ex->type);
+            out(format)(", %s", ex->u_member->name);
+            break;
+
+        otherwise_error
+    }
+    out(char)(')');
+}
+
     /** BASIC EXPRESSION **/
 
 cgd_ex(basic_data) {
@@ -389,10 +439,18 @@ cgd_ex(basic_data) {
             out(string)(ex->u_ex_constructor->u_variable_name);
             break;
 
+        case EX_B_LAYOUT:
+            cg(ex_layout)(ex->u_layout);
+            break;
+
         case EX_B_ENUM_MEMBER:
             cg(enum_member)(ex->u_enum_member);
             break;
 
+        case EX_B_CONSTANT:
+            out(string)(ex->u_constant->name);
+            break;
+
         case EX_B_STRING:
             out(string)(ex->u_string);
             break;
@@ -790,7 +848,7 @@ cgd_dc(import) {
 }
 
     /* code generation tasks */
-void codegen_task_source_prefix(FILE* file) {
+cgtask_declare(source_prefix) {
     out(string)("/* This source file was generated by the CARBONSTEEL compiler */\n");
     out(string)("/* Prefix end */\n\n");
 }
@@ -798,6 +856,7 @@ void codegen_task_source_prefix(FILE* file) {
 cgtask_declare(header_prefix) {
     out(string)("/* This header was generated by the CARBONSTEEL compiler */\n");
     out(string)("#include <stdint.h>\n");
+    out(string)("#include <stddef.h>\n");
     out(string)("#include <stdbool.h>\n");
     out(string)("#include <stdlib.h>\n");
     out(string)("/* Prefix end */\n\n");
@@ -896,15 +955,42 @@ cgtask_declare_ast(declarations) {
     /* functions */
 /**
  * Does code generation into the
- * specified output file
+ * specified output buffer
  * 
  * @param ast The abstract syntax tree
- * @param output The output source code file
+ * @param output The output buffer
  */
-void codegen(ast_root* ast, FILE* file) {
+void codegen(ast_root* ast, cg_output* output) {
+    memstat_enter_phase(MEMSTAT_PHASE_CODEGEN);
+    log_debug(LOG_CODEGEN, "generating code for %zu declarations", ast->declaration_list.size);
+    uint64_t start = timer_start();
+    trace_begin("codegen", "header");
     cgtask(header_prefix);
     cgtask_ast(declarations);
+    trace_end();
+    timer_stop(TIMER_CODEGEN_HEADER, start);
 
-    codegen_task_source_prefix(file);
+    start = timer_start();
+    trace_begin("codegen", "definitions");
+    cgtask(source_prefix);
     cgtask_ast(definitions);
+    trace_end();
+    timer_stop(TIMER_CODEGEN_DEFINITIONS, start);
+}
+
+/**
+ * Does code generation into memory,
+ * for use of the compiler as a library
+ * 
+ * @param[in]  ast    The abstract syntax tree
+ * @param[out] length Length of the generated code, may be NULL
+ * 
+ * @return The null-terminated generated code,
+ *         allocated by malloc
+ */
+char* codegen_to_string(ast_root* ast, size_t* length) {
+    cg_output output;
+    cg_output_init_memory(&output);
+    codegen(ast, &output);
+    return cg_output_release(&output, length);
 }
\ No newline at end of file
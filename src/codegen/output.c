@@ -0,0 +1,203 @@
+/**
+ * @file output.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Buffered code generation output implementation
+ */
+    /* includes */
+#include "codegen/output.h" /* this */
+
+#include <stdarg.h> /* variadic arguments */
+#include <string.h> /* string functions */
+
+#include "misc/memory.h" /* memory allocation */
+
+    /* internal functions */
+/**
+ * Makes sure the buffer is able
+ * to hold the specified amount of extra data
+ *
+ * @param[in] output Pointer to the output
+ * @param[in] length Length of the extra data
+ */
+static void cg_output_reserve(cg_output* output, size_t length) {
+    if (output->capacity - output->size >= length) {
+        return;
+    }
+
+    size_t capacity = output->capacity;
+    if (capacity == 0) {
+        capacity = CG_OUTPUT_INITIAL_CAPACITY;
+    }
+    while (capacity - output->size < length) {
+        capacity *= 2;
+    }
+    output->data = checked_realloc(output->data, capacity);
+    output->capacity = capacity;
+}
+
+/**
+ * Flushes a file output if
+ * the buffer exceeds the flush size
+ *
+ * @param[in] output Pointer to the output
+ */
+static inline void cg_output_check_flush(cg_output* output) {
+    if (output->file != NULL && output->flush_size != 0
+            && output->size >= output->flush_size) {
+        cg_output_flush(output);
+    }
+}
+
+    /* functions */
+/**
+ * Initializes an output which writes into a file
+ *
+ * @param[out] output     Pointer to the output
+ * @param[in]  file       The output file
+ * @param[in]  flush_size Buffer size which triggers a write,
+ *                        or 0 to write only when closed
+ */
+void cg_output_init_file(cg_output* output, FILE* file, size_t flush_size) {
+    cg_output_init_memory(output);
+    output->file = file;
+    output->flush_size = flush_size;
+}
+
+/**
+ * Initializes an output which
+ * is kept in memory
+ *
+ * @param[out] output Pointer to the output
+ */
+void cg_output_init_memory(cg_output* output) {
+    output->data = checked_malloc(CG_OUTPUT_INITIAL_CAPACITY);
+    output->size = 0;
+    output->capacity = CG_OUTPUT_INITIAL_CAPACITY;
+    output->file = NULL;
+    output->flush_size = 0;
+    output->failed = false;
+}
+
+/**
+ * Appends raw data to the output
+ *
+ * @param[in] output Pointer to the output
+ * @param[in] data   The data
+ * @param[in] length Length of the data
+ */
+void cg_output_write(cg_output* output, const char* data, size_t length) {
+    cg_output_reserve(output, length);
+    memcpy(output->data + output->size, data, length);
+    output->size += length;
+    cg_output_check_flush(output);
+}
+
+/**
+ * Appends a string to the output
+ *
+ * @param[in] output Pointer to the output
+ * @param[in] string The string
+ */
+void cg_output_string(cg_output* output, const char* string) {
+    cg_output_write(output, string, strlen(string));
+}
+
+/**
+ * Appends a formatted string to the output
+ *
+ * @param[in] output Pointer to the output
+ * @param[in] format The format string
+ */
+void cg_output_format(cg_output* output, const char* format, ...) {
+    va_list args;
+
+    /* try to format directly into the free space */
+    va_start(args, format);
+    size_t available = output->capacity - output->size;
+    int length = vsnprintf(output->data + output->size, available, format, args);
+    va_end(args);
+    if (length < 0) {
+        error_internal("failed to format the code generation output \"%s\"", format);
+    }
+
+    /* the terminating null character must fit as well */
+    if ((size_t) length >= available) {
+        cg_output_reserve(output, (size_t) length + 1);
+        va_start(args, format);
+        vsnprintf(output->data + output->size, length + 1, format, args);
+        va_end(args);
+    }
+    output->size += length;
+    cg_output_check_flush(output);
+}
+
+/**
+ * Writes the buffered data into the file,
+ * does nothing for a memory output
+ *
+ * @param[in] output Pointer to the output
+ *
+ * @return false if the write has failed
+ */
+bool cg_output_flush(cg_output* output) {
+    if (output->file == NULL) {
+        return true;
+    }
+
+    if (output->size != 0) {
+        if (fwrite(output->data, 1, output->size, output->file) != output->size) {
+            output->failed = true;
+        }
+        output->size = 0;
+    }
+    if (fflush(output->file) != 0) {
+        output->failed = true;
+    }
+    return !output->failed;
+}
+
+/**
+ * Flushes and releases a file output,
+ * the file itself is not closed
+ *
+ * @param[in] output Pointer to the output
+ *
+ * @return false if any write has failed
+ */
+bool cg_output_close(cg_output* output) {
+    bool result = cg_output_flush(output);
+    free(output->data);
+    output->data = NULL;
+    output->size = output->capacity = 0;
+    return result;
+}
+
+/**
+ * Releases a memory output and passes
+ * its contents to the caller
+ *
+ * @param[in]  output Pointer to the output
+ * @param[out] length Length of the contents, may be NULL
+ *
+ * @return The null-terminated contents,
+ *         allocated by malloc
+ */
+char* cg_output_release(cg_output* output, size_t* length) {
+    if (output->file != NULL) {
+        error_internal("attempted to release the buffer of a file output");
+    }
+
+    cg_output_reserve(output, 1);
+    output->data[output->size] = '\0';
+
+    char* result = output->data;
+    if (length != NULL) {
+        *length = output->size;
+    }
+    output->data = NULL;
+    output->size = output->capacity = 0;
+    return result;
+}
\ No newline at end of file
@@ -18,10 +18,17 @@
 #include "syntax/declaration/declaration.h" /* declarations */
 #include "misc/memory.h" /* memory allocation */
 #include "misc/string.h"
+#include "misc/intern.h" /* interned filenames */
+#include "language/module.h" /* module cache */
+#include "language/native/cache.h" /* preprocessed header cache */
+#include "language/native/macro.h" /* native macro constants */
+#include "language/interface.h" /* native snapshots */
+#include "misc/timer.h" /* phase timers */
+#include "misc/trace.h" /* trace output */
+#include "misc/stats.h" /* import statistics */
 #include "language/native/parser.h"
 #include "language/native/lexer.h"
 #include "language/parser.h" /* parser */
-#include "language/lexer.h" /* lexer */
 
     /* global variables */
 /**
@@ -45,11 +52,16 @@ char se_context_skip_data[4][3] = {
     /* functions */
 /**
  * Allocates and initializes a new parser context
+ * and selects its arena for further allocations
  * 
  * @return Pointer to the new parser context
  */
 se_context* context_new() {
-    se_context* context = allocate(se_context);
+    se_context* context = checked_malloc(sizeof(se_context));
+    arena_init(&context->arena);
+    arena_init(&context->transient);
+    arena_select(&context->arena);
+
     arl_init(se_context_level, context->stack);
     context->skip_pair_count = 0;
     context->skip_until = 0;
@@ -60,6 +72,11 @@ se_context* context_new() {
 
     /* initialize the file list */
     arl_init(se_context_import_file_ptr, context->file_list);
+    arl_init(dc_import_ptr, context->import_list);
+
+    /* initialize the local symbol table */
+    scope_table_init(&context->scope);
+    context->import_depth = 0;
 
     /* add a global level */
     se_context_level global;
@@ -73,6 +90,43 @@ se_context* context_new() {
 }
 
 
+/**
+ * Releases the parser context together
+ * with everything allocated in its arena
+ * 
+ * @param context Pointer to the parser context
+ */
+void context_free(se_context* context) {
+    if (arena_current == &context->arena) {
+        arena_select(NULL);
+    }
+
+    /* release the lists owned by the context itself */
+    iterate_array(i, context->file_list.size) {
+        se_context_import_file* file = context->file_list.data[i];
+        if (file->tokens != NULL) {
+            token_stream_free(file->tokens);
+        }
+        if (file->native_batch != NULL) {
+            native_batch_free(file->native_batch);
+        }
+    }
+    arraylist_free(se_context_level)(&context->stack);
+    arraylist_free(se_context_import_file_ptr)(&context->file_list);
+    arraylist_free(dc_import_ptr)(&context->import_list);
+    scope_table_free(&context->scope);
+    arraylist_free(declaration_ptr)(&context->ast.declaration_list);
+    ast_symbol_table_free(&context->ast.symbol_table);
+    ast_restore_shared(&context->ast);
+    arraylist_free(ast_shared_value)(&context->ast.shared_list);
+
+    /* release the syntax tree */
+    arena_free(&context->arena);
+    arena_free(&context->transient);
+    free(context);
+}
+
+
 /**
  * Add a new context level
  * on top of the context stack
@@ -81,7 +135,7 @@ se_context* context_new() {
  * @param kind    Kind of the context level
  */
 void context_enter(se_context* context, se_context_level_kind kind) {
-    logd("entering %s", se_context_level_kind_strings[kind]);
+    log_debug(LOG_PARSER, "entering %s", se_context_level_kind_strings[kind]);
     se_context_level level = { .kind = kind };
 
     /* initialize the level value */
@@ -91,11 +145,12 @@ void context_enter(se_context* context, se_context_level_kind kind) {
             break;
 
         case SCTX_SCOPE:
-            arl_init(local_declaration, level.u_locals);
+            level.u_scope_mark = scope_table_mark(&context->scope);
             break;
 
         case SCTX_ENUM:
             level.u_enum_context.value = allocate(dc_enum);
+            level.u_enum_context.value->_origin = NULL;
             level.u_enum_context.member_index = 0;
             level.u_enum_context.kind = ENUM_KIND_UNKNOWN;
             break;
@@ -105,6 +160,9 @@ void context_enter(se_context* context, se_context_level_kind kind) {
             break;
 
         case SCTX_IMPORT:
+            context->import_depth++;
+            break;
+
         case SCTX_GLOBAL:
             break;
 
@@ -164,21 +222,50 @@ se_context_level* context_get(se_context* context, se_context_level_kind kind) {
  * @param context Pointer to the parser context
  */
 void context_exit(se_context* context) {
-    logd("leaving %s", se_context_level_kind_strings[arraylist_last(context->stack).kind]);
-    if (arraylist_last(context->stack).kind == SCTX_GLOBAL) {
-        error_internal("attempted to exit from the global context");
+    log_debug(LOG_PARSER, "leaving %s", se_context_level_kind_strings[arraylist_last(context->stack).kind]);
+    se_context_level* level = &arraylist_last(context->stack);
+    switch (level->kind) {
+        case SCTX_GLOBAL:
+            error_internal("attempted to exit from the global context");
+            break;
+
+        case SCTX_SCOPE:
+            scope_table_unwind(&context->scope, level->u_scope_mark);
+            break;
+
+        case SCTX_IMPORT:
+            context->import_depth--;
+            break;
+
+        default:
+            break;
     }
     
     arl_pop(se_context_level, context->stack);
 }
 
 
+/**
+ * Declares a local symbol in the innermost
+ * SCTX_SCOPE level of the context
+ * 
+ * @param context Pointer to the parser context
+ * @param dc      The local declaration
+ */
+void context_declare_local(se_context* context, local_declaration dc) {
+    if (context_find(context, SCTX_SCOPE) == NULL) {
+        error_internal("attempted to declare a local symbol %s outside of a scope", dc.name);
+    }
+    scope_table_declare(&context->scope, dc);
+}
+
+
 /**
  * Translates an import statement into a relative filename
  * 
  * @param import The import statement
  * 
- * @return Relative path to the file, allocated with malloc
+ * @return Relative path to the file, allocated in the current arena
  */
 char* import_to_filename(dc_import* import) {
     char* extension;
@@ -200,7 +287,7 @@ char* import_to_filename(dc_import* import) {
     total_length += extension_length;
 
     /* start merging the segments into an allocated buffer */
-    char* filename = malloc(sizeof(char) * total_length);
+    char* filename = allocate_array(char, total_length);
     size_t offset = 0;
     for (int i = 0; i < import->path.size; i++) {
         /* append the path element*/
@@ -229,47 +316,32 @@ char* import_to_filename(dc_import* import) {
  * @param filename Path to the file
  */
 void context_parse_native(se_context* context, char* filename) {
-    logd("native parsing %s on pass %d", filename, context->pass + 1);
-
-    /* create the pipes */
-    int pd_in[2];
-    int pd_out[2];
-    if (pipe(pd_in) != 0 || pipe(pd_out) != 0) {
-        logfe("import: unable to create a pipe");
-    }
-    
-    /* start the gcc preprocessor */
-    pid_t child = fork();
-    if (child < 0) {
-        logfe("import: unable to create a child process");
-    }
-    if (child == 0) {
-        logd("forked successfully");
-        close(pd_in[1]);
-        dup2(pd_in[0], 0);
-
-        close(pd_out[0]);
-        dup2(pd_out[1], 1);
-        
-        if (execlp("gcc", "gcc", "-E", "-", NULL) != 0) {
-            logfe("failed to start gcc preprocessor")
+    log_debug(LOG_NATIVE, "native parsing %s on pass %d", filename, context->pass + 1);
+    memstat_scope scope = memstat_enter_file(filename, true);
+    trace_begin("native", filename);
+
+    /* scan the batch region or the cached preprocessor output if possible */
+    source_buffer source;
+    native_batch* batch = NULL;
+    native_batch_region* region = NULL;
+    iterate_array(i, context->file_list.size) {
+        batch = context->file_list.data[i]->native_batch;
+        if (batch != NULL && (region = native_batch_find(batch, filename)) != NULL) {
+            arraylist_last(context->file_list)->native_unit = batch->unit;
+            break;
         }
-
-        exit(0);
     }
-    close(pd_in[0]);
-    close(pd_out[1]);
 
-    /* write to gcc input */
-    write(pd_in[1], "#include <", strlen("#include <"));
-    write(pd_in[1], filename, strlen(filename));
-    write(pd_in[1], ">", strlen(">"));
-    close(pd_in[1]);
-    
-    /* read the preprocessed output */
-    FILE* input = fdopen(pd_out[0], "r");
-    if (input == NULL) {
-        error_internal("import: unable to open the preprocessor output");
+    /* a batch region is parsed anyway, otherwise the snapshot is enough */
+    uint64_t start = timer_start();
+    trace_begin("snapshot", "load");
+    bool is_loaded = region == NULL && interface_load_native(context, filename, arraylist_last(context->file_list)->native_unit);
+    trace_end();
+    timer_stop(TIMER_NATIVE_SNAPSHOT, start);
+    if (is_loaded) {
+        memstat_exit_file(scope);
+        trace_end();
+        return;
     }
 
     /* initialize the scanner */
@@ -277,18 +349,127 @@ void context_parse_native(se_context* context, char* filename) {
     if (cyylex_init(&scanner) != 0) {
         error_internal("import: unable to initizize the yacc scanner");
     }
-    cyyset_in(input, scanner);
+
+    bool is_cached = false;
+    start = timer_start();
+    trace_begin("preprocess", filename);
+    if (region != NULL) {
+        native_batch_region_open(region, &source);
+        region->is_parsed = true;
+    } else if (native_cache_open(filename, &source)) {
+        is_cached = true;
+    } else if (!native_preprocess(&filename, 1, NULL, filename, &source)) {
+        logfe("import: unable to preprocess native header %s", filename);
+    }
+    if (cyy_scan_buffer(source.data, source_buffer_scan_size(&source), scanner) == NULL) {
+        error_internal("import: unable to scan the preprocessor output");
+    }
+    trace_end();
+    timer_stop(TIMER_NATIVE_PREPROCESS, start);
 
     /* parse */
+    uint64_t parse_start = timer_start();
+    trace_begin("cyyparse", filename);
     if (cyyparse(scanner, context) != 0) {
         error_internal("import: parsing file %s failed", filename);
     }
+    trace_end();
+    timer_stop(TIMER_NATIVE_PARSE, parse_start);
+
+    /* numeric macros are not seen by the parser */
+    start = timer_start();
+    trace_begin("macros", filename);
+    if (region != NULL) {
+        native_macro_import_batch(context, batch, region);
+    } else {
+        native_macro_import(context, filename, arraylist_last(context->file_list)->native_unit);
+    }
+    trace_end();
+    timer_stop(TIMER_NATIVE_MACROS, start);
+
+    /* the next compilation loads the declarations without parsing */
+    if (is_cached) {
+        start = timer_start();
+        trace_begin("snapshot", "save");
+        interface_save_native(context, filename, arraylist_last(context->file_list)->native_unit);
+        trace_end();
+        timer_stop(TIMER_NATIVE_SNAPSHOT, start);
+    }
 
     /* free */
     cyylex_destroy(scanner);
-    fclose(input);
+    source_buffer_close(&source);
+
+    memstat_exit_file(scope);
+    trace_end();
+    log_debug(LOG_NATIVE, "successful");
+}
+
+
+/**
+ * Finds the native imports of a token stream and
+ * preprocesses the headers which have not been
+ * imported yet before they are parsed, either
+ * concurrently or in a single batch of the file
+ * 
+ * @param context Pointer to the parser context
+ * @param file    The file entry or NULL
+ * @param tokens  The token stream
+ */
+static void context_prefetch_native(se_context* context, se_context_import_file* file, se_token_stream* tokens) {
+    arraylist(char_ptr) headers;
+    arl_init(char_ptr, headers);
+
+    /* import native a.b.c; is the header a/b/c.h */
+    se_token* data = tokens->data;
+    for (size_t i = 0; i + 3 < tokens->size; i++) {
+        if (data[i].kind != TOKEN_IMPORT || data[i + 1].kind != TOKEN_NATIVE) {
+            continue;
+        }
+
+        size_t end = i + 2;
+        size_t length = 0;
+        while (end < tokens->size && data[end].kind == TOKEN_IDENTIFIER) {
+            length += strlen(data[end].u_string) + 1;
+            if (end + 1 < tokens->size && data[end + 1].kind == '.') {
+                end += 2;
+            } else {
+                end++;
+                break;
+            }
+        }
+        if (end >= tokens->size || data[end].kind != ';' || length == 0) {
+            continue;
+        }
+
+        char* header = arena_allocate(&context->transient, length + strlen(".h"));
+        header[0] = '\0';
+        for (size_t j = i + 2; j < end; j += 2) {
+            strcat(header, data[j].u_string);
+            strcat(header, j + 2 < end ? "/" : ".h");
+        }
+        header = intern_string(header);
+
+        /* headers which have been imported already are skipped */
+        bool is_imported = false;
+        iterate_array(j, context->file_list.size) {
+            se_context_import_file* file = context->file_list.data[j];
+            if (file->is_native && file->filename == header) {
+                is_imported = true;
+            }
+        }
+        if (!is_imported) {
+            arl_add(char_ptr, headers, header);
+        }
+    }
 
-    logd("successful");
+    if (native_batch_mode && file != NULL && headers.size != 0) {
+        char* unit = intern_string(cst_strconcat(file->filename, " (native batch)"));
+        file->native_batch = native_batch_new(headers.data, headers.size, unit);
+    } else {
+        native_cache_prefetch(headers.data, headers.size);
+    }
+    arraylist_free(char_ptr)(&headers);
 }
 
 
@@ -300,31 +481,62 @@ void context_parse_native(se_context* context, char* filename) {
  * @param filename Path to the file
  */
 void context_parse(se_context* context, char* filename) {
-    logd("parsing %s on pass %d", filename, context->pass + 1);
-
-    /* open the file */
-    FILE* input = fopen(filename, "r");
-    if (input == NULL) {
-        error_internal("import: unable to open file %s", filename);
+    log_debug(LOG_IMPORT, "parsing %s on pass %d", filename, context->pass + 1);
+    memstat_scope scope = memstat_enter_file(filename, false);
+    trace_begin("import", filename);
+
+    /* find the file entry, which keeps the tokens between passes */
+    se_context_import_file* file = NULL;
+    iterate_array(i, context->file_list.size) {
+        se_context_import_file* current = context->file_list.data[i];
+        if (current->filename == filename && !current->is_native) {
+            file = current;
+            break;
+        }
     }
 
-    /* initialize the scanner */
-    yyscan_t scanner;
-    if (myylex_init(&scanner) != 0) {
-        error_internal("import: unable to initizize the yacc scanner");
+    /* lex the file on the first pass */
+    se_token_stream* tokens = file != NULL ? file->tokens : NULL;
+    if (tokens == NULL) {
+        source_buffer source;
+        if (!source_buffer_open(&source, filename)) {
+            error_internal("import: unable to open file %s", filename);
+        }
+        uint64_t start = timer_start();
+        trace_begin("lex", filename);
+        tokens = token_stream_lex(&source, filename);
+        source_buffer_close(&source);
+        trace_end();
+        timer_stop(TIMER_LEX, start);
+
+        start = timer_start();
+        trace_begin("prefetch", filename);
+        context_prefetch_native(context, file, tokens);
+        trace_end();
+        timer_stop(TIMER_NATIVE_PREPROCESS, start);
+
+        if (file != NULL) {
+            file->tokens = tokens;
+        }
     }
-    myyset_in(input, scanner);
 
     /* parse */
-    if (myyparse(scanner, context) != 0) {
+    se_token_reader reader = { tokens, 0 };
+    if (myyparse(&reader, context) != 0) {
         error_internal("import: parsing file %s failed", filename);
     }
 
     /* free */
-    myylex_destroy(scanner);
-    fclose(input);
+    if (file == NULL) {
+        token_stream_free(tokens);
+    } else if (file->native_batch != NULL) {
+        native_batch_free(file->native_batch);
+        file->native_batch = NULL;
+    }
 
-    logd("successful");
+    memstat_exit_file(scope);
+    trace_end();
+    log_debug(LOG_IMPORT, "successful");
 }
 
 
@@ -342,35 +554,62 @@ void context_parse_origin(se_context* context, char* filename_) {
     }
 
     /* ensure the path is absolute */
-    char* filename = realpath(filename_, NULL);
-    if (filename == NULL) {
+    char* absolute = realpath(filename_, NULL);
+    if (absolute == NULL) {
         logfe("failed to determine the absolute path to %s", filename_);
     }
-    logd("starting the parser at %s", filename);
+    char* filename = intern_string(absolute);
+    free(absolute);
+    log_debug(LOG_IMPORT, "starting the parser at %s", filename);
 
     /* mark the file as imported to prevent self-imports */
     se_context_import_file* import_file = allocate(se_context_import_file);
     import_file->filename = filename;
     import_file->is_native = false;
+    import_file->is_linked = false;
+    import_file->tokens = NULL;
+    import_file->native_unit = filename;
+    import_file->native_batch = NULL;
     // import_file->last = -1;
     arl_add(se_context_import_file_ptr, context->file_list, import_file);
     context->filename = filename;
 
     /* do three passes on the file */
+    uint64_t start = timer_start();
+    memstat_enter_phase(MEMSTAT_PHASE_PASS_1);
+    trace_begin("pass", "pass 1");
     context->pass = SCTX_PASS_1;
     import_file->last = context->pass;
+    arena_reset(&context->transient);
     context_parse(context, filename);
+    trace_end();
+    timer_stop(TIMER_PASS_1, start);
+
+    start = timer_start();
+    memstat_enter_phase(MEMSTAT_PHASE_PASS_2);
+    trace_begin("pass", "pass 2");
     context->pass = SCTX_PASS_2;
     import_file->last = context->pass;
+    arena_reset(&context->transient);
     context_parse(context, filename);
+    trace_end();
+    timer_stop(TIMER_PASS_2, start);
+
+    start = timer_start();
+    memstat_enter_phase(MEMSTAT_PHASE_PASS_3);
+    trace_begin("pass", "pass 3");
     context->pass = SCTX_PASS_3;
     import_file->last = context->pass;
+    arena_reset(&context->transient);
     context_parse(context, filename);
+    trace_end();
+    timer_stop(TIMER_PASS_3, start);
 
-    /* free */
-    free(filename);
+    /* the origin file is not parsed again */
+    token_stream_free(import_file->tokens);
+    import_file->tokens = NULL;
 
-    logd("successful");
+    log_debug(LOG_IMPORT, "successful");
 }
 
 
@@ -382,18 +621,21 @@ void context_parse_origin(se_context* context, char* filename_) {
  * @param import The import declaration
  */
 void context_import(se_context* context, dc_import* import) {
+    /* remember the imports for module interfaces */
+    if (context->pass == SCTX_PASS_1) {
+        arl_add(dc_import_ptr, context->import_list, import);
+    }
+
     /* resolve the path */
     char* relative_name = import_to_filename(import);
-    size_t relative_length = strlen(relative_name);
 
     char* filename;
-    size_t filename_length;
+    char* directory = NULL;
     
     if (import->is_native) {
-        filename = relative_name;
-        filename_length = relative_length;
+        filename = intern_string(relative_name);
     } else {
-        char* parent_name = copy_string(context->filename);
+        char* parent_name = arena_copy_string(&context->transient, context->filename);
         ssize_t parent_length = strlen(parent_name);
 
         /* a workaround to find the parent directory of the origin file */
@@ -413,25 +655,33 @@ void context_import(se_context* context, dc_import* import) {
         }
 
         /* merge the file and directory paths */
-        filename = cst_strconcat(parent_name, relative_name);
-        filename_length = strlen(filename);
-        free(parent_name);
+        directory = intern_string(parent_name);
+        filename = intern_string(cst_strconcat(parent_name, relative_name));
     }
 
-    /* handle repeating (circular/self) imports */
+    stats_count(imports);
+    if (import->is_native) {
+        stats_count(native_imports);
+    }
+
+    /* handle repeating (circular/self) imports, filenames are interned */
     se_context_import_file* current_file = NULL;
     for (int i = 0; i < context->file_list.size; i++) {
         current_file = context->file_list.data[i];
-        if (strncmp(filename, current_file->filename, filename_length) == 0) {
+        if (filename == current_file->filename) {
+            if (current_file->is_linked && current_file->is_native == import->is_native) {
+                log_debug(LOG_IMPORT, "%s is already linked from a cached module", filename);
+                stats_count(linked_imports);
+                return;
+            }
             if (current_file->is_native != import->is_native) {
                 logw("name conflict for native and non-native import! allowing, but that could be a bug")
             } else if (current_file->last == context->pass) {
-                logd("rejected repeat import of %s", filename);
-                if (!import->is_native) {
-                    free(filename);
-                }
+                log_debug(LOG_IMPORT, "rejected repeat import of %s", filename);
+                stats_count(repeat_imports);
                 return;
             }
+            break;
         } else {
             current_file = NULL;
         }
@@ -440,6 +690,10 @@ void context_import(se_context* context, dc_import* import) {
         current_file = allocate(se_context_import_file);
         current_file->filename = filename;
         current_file->is_native = import->is_native;
+        current_file->is_linked = false;
+        current_file->tokens = NULL;
+        current_file->native_unit = filename;
+        current_file->native_batch = NULL;
         arl_add(se_context_import_file_ptr, context->file_list, current_file);
     }
     current_file->last = context->pass;
@@ -451,6 +705,16 @@ void context_import(se_context* context, dc_import* import) {
             context_parse_native(context, filename);
         }
     } else {
+        /* link the cached header-level declarations if possible */
+        if (context->pass == SCTX_PASS_1) {
+            se_module* module = module_get(context, filename, directory);
+            if (module != NULL) {
+                module_link(context, module);
+                current_file->is_linked = true;
+                return;
+            }
+        }
+
         if (context->pass != SCTX_PASS_3) {
             context_parse(context, filename);
         }
@@ -500,7 +764,7 @@ void context_skip_specific_unless(se_context* context, se_context_pass pass, cha
 se_context_skip_action context_should_skip(se_context* context, char c) {
     /* handle no-skip conditions */
     if (context->expect_skip_from == SCTX_SKIP_NONE) {
-        logd("skip: expected none!");
+        log_debug(LOG_LEXER, "skip: expected none!");
         return SCTX_SA_NONE;
     }
    
@@ -508,13 +772,13 @@ se_context_skip_action context_should_skip(se_context* context, char c) {
     if ((context->expect_skip_discard == SCTX_SKIP_ANY
          && context->expect_skip_from != c) 
          || context->expect_skip_discard == c) {
-        logd("skip: discarded, got %c", c);
+        log_debug(LOG_LEXER, "skip: discarded, got %c", c);
         return SCTX_SA_EXIT;
     }
 
     /* handle normal skips */
     if (context->expect_skip_from == SCTX_SKIP_ANY || context->expect_skip_from == c) {
-        logd("skip: got %c, looking for pair", c);
+        log_debug(LOG_LEXER, "skip: got %c, looking for pair", c);
         int pair = -1;
         for (int i = 0; i < se_context_skip_data_size; i++) {
             if (se_context_skip_data[i][0] == c) {
@@ -531,7 +795,7 @@ se_context_skip_action context_should_skip(se_context* context, char c) {
 
         return SCTX_SA_START;
     } else {
-        logd("skip: expected %c, got %c", context->expect_skip_from, c);
+        log_debug(LOG_LEXER, "skip: expected %c, got %c", context->expect_skip_from, c);
         return SCTX_SA_NONE;
     }
 }
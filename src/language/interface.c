@@ -0,0 +1,1744 @@
+/**
+ * @file interface.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Precompiled module interfaces implementation
+ */
+    /* includes */
+#include "language/interface.h" /* this */
+
+#include <stdlib.h>
+#include <stdbool.h> /* boolean */
+#include <stdio.h> /* file functions */
+#include <string.h> /* string functions */
+#include <limits.h> /* path length */
+#include <unistd.h> /* process functions */
+#include <fcntl.h> /* file control */
+#include <sys/mman.h> /* memory mapping */
+#include <sys/stat.h> /* file status */
+
+#include "syntax/declaration/declaration.h" /* declarations */
+#include "syntax/statement/statement.h" /* variable declarations */
+#include "syntax/expression/constant/size.h" /* constant sizes */
+#include "ast/type/primitive.h" /* primitives */
+#include "misc/memory.h" /* memory allocation */
+#include "misc/intern.h" /* interned strings */
+#include "misc/hash.h" /* file key */
+#include "misc/cache.h" /* cache directory */
+#include "language/parser.h" /* token kinds */
+#include "language/native/parser.h" /* native token kinds */
+#include "language/native/declaration.h" /* lazy native declarations */
+#include "language/native/cache.h" /* native snapshot path */
+
+    /* defines */
+/**
+ * Alignment of every interface table
+ */
+#define INTERFACE_ALIGNMENT 8
+
+/**
+ * Maximum number of levels of a type
+ */
+#define INTERFACE_MAX_LEVELS 64
+
+    /* typedefs */
+/**
+ * Growable byte buffer of an interface table
+ */
+typedef struct if_buffer {
+    char* data;
+    size_t size;
+    size_t capacity;
+} if_buffer;
+
+/**
+ * Entry of a pointer lookup, keyed by a pointer and
+ * a declaration kind, with an index or a name
+ */
+typedef struct if_lookup_entry {
+    const void* key; /* NULL for an empty entry */
+    declaration_kind kind;
+    uint32_t index;
+    char* name;
+} if_lookup_entry;
+
+/**
+ * Open addressing pointer lookup of the writer,
+ * which keeps the first entry of every key
+ */
+typedef struct if_lookup {
+    if_lookup_entry* data;
+    uint32_t capacity; /* a power of two */
+    uint32_t size;
+} if_lookup;
+
+/**
+ * Interface writer state
+ */
+typedef struct if_writer {
+    se_context* context;
+    char* native_unit; /* the native unit of a snapshot, NULL for modules */
+    declaration** locals; /* declarations owned by the module */
+    uint32_t local_count;
+    uint32_t local_capacity;
+    uint32_t named_count; /* the rest are hidden declarations allocated by the writer */
+    if_lookup local_map; /* value to the index of a local */
+    if_lookup named_map; /* name to the index of a named local of a snapshot */
+    if_lookup external_map; /* value to the name in the symbol table, built on the first use */
+    bool is_external_map_ready;
+    if_buffer strings, imports, dependencies, declarations;
+    if_buffer members, enum_members, types, indices;
+} if_writer;
+
+/**
+ * Interface reader state
+ */
+typedef struct if_reader {
+    se_context* context;
+    char* native_unit; /* the native unit of a snapshot, NULL for modules */
+    const char* data; /* the mapped file */
+    const if_header* header;
+    void** locals; /* values of the declarations owned by the module */
+    declaration** existing; /* native declarations reused by a snapshot */
+    void** completed; /* bodies of the reused partial declarations */
+} if_reader;
+
+    /* global variables */
+/**
+ * The interface directory, empty if the cache is disabled
+ * or NULL if it has not been determined yet
+ */
+static char* interface_directory = NULL;
+
+    /* internal functions */
+/**
+ * Determines the interface file path of a module
+ *
+ * @param[in]  module Pointer to the module
+ * @param[out] path   The path buffer of PATH_MAX characters
+ *
+ * @return false if the cache is disabled
+ */
+static bool interface_path(se_module* module, char* path) {
+    if (interface_directory == NULL) {
+        interface_directory = cache_directory("modules");
+        if (interface_directory == NULL) {
+            interface_directory = "";
+        }
+    }
+    if (*interface_directory == '\0') {
+        return false;
+    }
+
+    uint64_t key = hash_string(module->filename) ^ hash_mix(hash_string(module->directory), HASH_SECRET_1);
+    return snprintf(path, PATH_MAX, "%s/%016llx.csti", interface_directory,
+        (unsigned long long) key) < PATH_MAX - 32;
+}
+
+/**
+ * Returns the name of a declaration value
+ *
+ * @param[in] kind  Kind of the declaration
+ * @param[in] value Value of the declaration
+ *
+ * @return The name, may be NULL
+ */
+static char* if_value_name(declaration_kind kind, void* value) {
+    switch (kind) {
+        case DC_STRUCTURE:
+            return ((dc_structure*) value)->name;
+
+        case DC_ENUM:
+            return ((dc_enum*) value)->name;
+
+        case DC_FUNCTION:
+            return ((dc_function*) value)->name;
+
+        case DC_ALIAS:
+            return ((dc_alias*) value)->name;
+
+        case DC_ST_VARIABLE:
+            return ((dc_st_variable*) value)->name;
+
+        case DC_CONSTANT:
+            return ((dc_constant*) value)->name;
+
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * Determines the token kinds of a declaration
+ *
+ * @param[in]  kind   Kind of the declaration
+ * @param[out] token  Token kind of the identifier
+ * @param[out] ctoken C token kind of the identifier
+ */
+static void if_declaration_tokens(declaration_kind kind, int* token, int* ctoken) {
+    switch (kind) {
+        case DC_STRUCTURE:
+            *token = TOKEN_STRUCTURE_NAME;
+            *ctoken = CTOKEN_STRUCTURE_NAME;
+            break;
+
+        case DC_ENUM:
+            *token = TOKEN_ENUM_NAME;
+            *ctoken = CTOKEN_ENUM_NAME;
+            break;
+
+        case DC_ALIAS:
+            *token = TOKEN_ALIAS_NAME;
+            *ctoken = CTOKEN_ALIAS_NAME;
+            break;
+
+        case DC_FUNCTION:
+            *token = TOKEN_FUNCTION_NAME;
+            *ctoken = CTOKEN_FUNCTION_NAME;
+            break;
+
+        case DC_ST_VARIABLE:
+            *token = TOKEN_VARIABLE_NAME;
+            *ctoken = CTOKEN_VARIABLE_NAME;
+            break;
+
+        case DC_CONSTANT:
+            *token = TOKEN_CONSTANT_NAME;
+            *ctoken = CTOKEN_IDENTIFIER;
+            break;
+
+        otherwise_error
+    }
+}
+
+/**
+ * Maps a whole file into memory
+ *
+ * @param[in]  path The file path
+ * @param[out] size Size of the file
+ *
+ * @return The mapping or NULL
+ */
+static void* if_map(char* path, size_t* size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size < (off_t) sizeof(if_header)) {
+        close(fd);
+        return NULL;
+    }
+    void* data = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return NULL;
+    }
+    *size = status.st_size;
+    return data;
+}
+
+        /* writer */
+
+/**
+ * Finds the slot of a key in a pointer map
+ *
+ * @param[in] map  Pointer to the map
+ * @param[in] key  The key
+ * @param[in] kind Kind of the declaration
+ *
+ * @return The entry with the key or the empty entry to insert it into
+ */
+static if_lookup_entry* if_lookup_slot(if_lookup* map, const void* key, declaration_kind kind) {
+    uint32_t mask = map->capacity - 1;
+    uint32_t i = (uint32_t) hash_mix((uint64_t) (uintptr_t) key, 0x9e3779b97f4a7c15ull + kind) & mask;
+    while (map->data[i].key != NULL && (map->data[i].key != key || map->data[i].kind != kind)) {
+        i = (i + 1) & mask;
+    }
+    return &map->data[i];
+}
+
+/**
+ * Finds an entry of a pointer map
+ *
+ * @param[in] map  Pointer to the map
+ * @param[in] key  The key
+ * @param[in] kind Kind of the declaration
+ *
+ * @return The entry or NULL
+ */
+static if_lookup_entry* if_lookup_find(if_lookup* map, const void* key, declaration_kind kind) {
+    if (map->size == 0) {
+        return NULL;
+    }
+    if_lookup_entry* entry = if_lookup_slot(map, key, kind);
+    return entry->key != NULL ? entry : NULL;
+}
+
+/**
+ * Adds an entry to a pointer map, unless the key is already there
+ *
+ * @param[in] map   Pointer to the map
+ * @param[in] key   The key, not NULL
+ * @param[in] kind  Kind of the declaration
+ * @param[in] index The index
+ * @param[in] name  The name
+ */
+static void if_lookup_add(if_lookup* map, const void* key, declaration_kind kind, uint32_t index, char* name) {
+    /* the load factor is kept at most one half */
+    if ((map->size + 1) * 2 > map->capacity) {
+        if_lookup old = *map;
+        map->capacity = old.capacity != 0 ? old.capacity * 2 : 64;
+        map->size = 0;
+        map->data = checked_malloc(sizeof(if_lookup_entry) * map->capacity);
+        memset(map->data, 0, sizeof(if_lookup_entry) * map->capacity);
+        for (uint32_t i = 0; i < old.capacity; i++) {
+            if (old.data[i].key != NULL) {
+                *if_lookup_slot(map, old.data[i].key, old.data[i].kind) = old.data[i];
+                map->size++;
+            }
+        }
+        free(old.data);
+    }
+
+    if_lookup_entry* entry = if_lookup_slot(map, key, kind);
+    if (entry->key == NULL) {
+        entry->key = key;
+        entry->kind = kind;
+        entry->index = index;
+        entry->name = name;
+        map->size++;
+    }
+}
+
+/**
+ * Appends data to a buffer
+ *
+ * @param[in] buffer Pointer to the buffer
+ * @param[in] data   The data
+ * @param[in] size   Size of the data
+ */
+static void if_buffer_add(if_buffer* buffer, const void* data, size_t size) {
+    if (buffer->capacity - buffer->size < size) {
+        size_t capacity = buffer->capacity != 0 ? buffer->capacity : 256;
+        while (capacity - buffer->size < size) {
+            capacity *= 2;
+        }
+        buffer->data = checked_realloc(buffer->data, capacity);
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->data + buffer->size, data, size);
+    buffer->size += size;
+}
+
+/**
+ * Appends a record to a table
+ *
+ * @param[in] buffer Pointer to the table
+ * @param[in] record The record
+ * @param[in] size   Size of the record
+ *
+ * @return Index of the record
+ */
+static uint32_t if_table_append(if_buffer* buffer, const void* record, size_t size) {
+    if_buffer_add(buffer, record, size);
+    return buffer->size / size - 1;
+}
+
+/**
+ * Appends a record to a table and returns its index
+ */
+#define if_table_add(buffer, record) if_table_append(&(buffer), &(record), sizeof(record))
+
+/**
+ * Returns the number of records in a table
+ */
+#define if_table_size(buffer, type) ((uint32_t) ((buffer).size / sizeof(type)))
+
+/**
+ * Appends a string to the string table
+ *
+ * @param[in] writer Pointer to the writer
+ * @param[in] string The string
+ *
+ * @return Offset of the string
+ */
+static uint32_t if_write_string(if_writer* writer, const char* string) {
+    uint32_t offset = writer->strings.size;
+    if_buffer_add(&writer->strings, string, strlen(string) + 1);
+    return offset;
+}
+
+/**
+ * Finds the index of a declaration owned by the module
+ *
+ * @param[in] writer Pointer to the writer
+ * @param[in] kind   Kind of the declaration
+ * @param[in] value  Value of the declaration
+ *
+ * @return The index or INTERFACE_NONE
+ */
+static uint32_t if_find_local(if_writer* writer, declaration_kind kind, void* value) {
+    if_lookup_entry* entry = if_lookup_find(&writer->local_map, value, kind);
+    return entry != NULL ? entry->index : INTERFACE_NONE;
+}
+
+/**
+ * Finds the name under which a declaration of
+ * another module can be looked up in the module context
+ *
+ * Only pointers are compared, so that a
+ * broken reference is never dereferenced
+ *
+ * @param[in] writer Pointer to the writer
+ * @param[in] kind   Kind of the declaration
+ * @param[in] value  Value of the declaration
+ *
+ * @return The name or NULL
+ */
+static char* if_find_external(if_writer* writer, declaration_kind kind, void* value) {
+    if (!writer->is_external_map_ready) {
+        ast_symbol_table* table = &writer->context->ast.symbol_table;
+        for (size_t i = 0; i < table->capacity; i++) {
+            ast_symbol* symbol = &table->data[i];
+            if (symbol->key != NULL && symbol->value->u__any != NULL) {
+                if_lookup_add(&writer->external_map, symbol->value->u__any, symbol->value->kind, 0, symbol->key);
+            }
+        }
+        writer->is_external_map_ready = true;
+    }
+    if_lookup_entry* entry = if_lookup_find(&writer->external_map, value, kind);
+    return entry != NULL ? entry->name : NULL;
+}
+
+/**
+ * Adds a declaration to the declarations owned by the module
+ *
+ * @param[in] writer Pointer to the writer
+ * @param[in] dc     The declaration
+ *
+ * @return Index of the declaration
+ */
+static uint32_t if_add_local(if_writer* writer, declaration* dc) {
+    if (writer->local_count == writer->local_capacity) {
+        writer->local_capacity = writer->local_capacity != 0 ? writer->local_capacity * 2 : 64;
+        writer->locals = checked_realloc(writer->locals, sizeof(declaration*) * writer->local_capacity);
+    }
+    writer->locals[writer->local_count] = dc;
+    if (dc->u__any != NULL) {
+        if_lookup_add(&writer->local_map, dc->u__any, dc->kind, writer->local_count, NULL);
+    }
+    return writer->local_count++;
+}
+
+/**
+ * Marks the declarations added so far as the named ones,
+ * indexing the names of the named structures, enums and functions
+ *
+ * @param[in] writer Pointer to the writer
+ */
+static void if_set_named(if_writer* writer) {
+    writer->named_count = writer->local_count;
+    for (uint32_t i = 0; i < writer->named_count; i++) {
+        declaration* dc = writer->locals[i];
+        if (dc->name != NULL && (dc->kind == DC_STRUCTURE || dc->kind == DC_ENUM || dc->kind == DC_FUNCTION)) {
+            if_lookup_add(&writer->named_map, dc->name, dc->kind, i, NULL);
+        }
+    }
+}
+
+/**
+ * Finds the declaration of a native snapshot a structure,
+ * enum or function type refers to, adding the values
+ * which are not in the symbol table as hidden declarations
+ *
+ * The preprocessed header declares every name it refers to,
+ * but a name declared before by another header is kept with
+ * the value of that header, so the values are matched by name
+ *
+ * @param[in] writer Pointer to the writer
+ * @param[in] kind   Kind of the declaration
+ * @param[in] value  Value of the declaration
+ *
+ * @return The index
+ */
+static uint32_t if_find_native(if_writer* writer, declaration_kind kind, void* value) {
+    char* name = if_value_name(kind, value);
+    if_lookup_entry* entry = name != NULL ? if_lookup_find(&writer->named_map, name, kind) : NULL;
+    if (entry != NULL) {
+        return entry->index;
+    }
+
+    declaration* dc = checked_malloc(sizeof(declaration));
+    memset(dc, 0, sizeof(declaration));
+    dc->kind = kind;
+    dc->u__any = value;
+    dc->name = name;
+    dc->is_full = kind == DC_STRUCTURE ? ((dc_structure*) value)->is_full
+                : kind == DC_ENUM ? ((dc_enum*) value)->is_full
+                : ((dc_function*) value)->is_full;
+    return if_add_local(writer, dc);
+}
+
+/**
+ * Appends a type to the type table
+ *
+ * @param[in] writer Pointer to the writer
+ * @param[in] type   The type
+ *
+ * @return Index of the type or INTERFACE_NONE
+ *         if it cannot be represented
+ */
+static uint32_t if_write_type(if_writer* writer, ast_type* type) {
+    if_type result = { .kind = type->kind, .generic_index = 0 };
+    declaration_kind kind;
+    list(ast_type)* impl = NULL;
+
+    switch (type->kind) {
+        case AST_TYPE_PRIMITIVE:
+            if (type->u_primitive < primitive_list.data
+                    || type->u_primitive >= primitive_list.data + primitive_list.size) {
+                return INTERFACE_NONE;
+            }
+            result.reference_kind = IF_REF_PRIMITIVE;
+            result.reference = if_write_string(writer, type->u_primitive->name);
+            break;
+
+        case AST_TYPE_GENERIC:
+            /* generics belong to the structures of the module */
+            result.reference_kind = IF_REF_GENERIC;
+            result.reference = INTERFACE_NONE;
+            for (uint32_t i = 0; i < writer->local_count && result.reference == INTERFACE_NONE; i++) {
+                if (writer->locals[i]->kind != DC_STRUCTURE) continue;
+                dc_structure* structure = writer->locals[i]->u_structure;
+                iterate_array(j, structure->generics.size) {
+                    if (structure->generics.data[j] == type->u_generic) {
+                        result.reference = i;
+                        result.generic_index = j;
+                        break;
+                    }
+                }
+            }
+            if (result.reference == INTERFACE_NONE) {
+                return INTERFACE_NONE;
+            }
+            break;
+
+        case AST_TYPE_STRUCTURE:
+        case AST_TYPE_ENUM:
+        case AST_TYPE_FUNCTION:
+            kind = type->kind == AST_TYPE_STRUCTURE ? DC_STRUCTURE
+                 : type->kind == AST_TYPE_ENUM ? DC_ENUM : DC_FUNCTION;
+            result.reference_kind = IF_REF_LOCAL;
+            result.reference = if_find_local(writer, kind, type->u__any);
+            if (result.reference == INTERFACE_NONE && writer->native_unit != NULL) {
+                result.reference = if_find_native(writer, kind, type->u__any);
+            } else if (result.reference == INTERFACE_NONE) {
+                char* name = if_find_external(writer, kind, type->u__any);
+                if (name == NULL) {
+                    return INTERFACE_NONE;
+                }
+                result.reference_kind = IF_REF_EXTERNAL;
+                result.reference = if_write_string(writer, name);
+            }
+
+            /* the generic implementation is registered again when loading */
+            if (type->kind == AST_TYPE_STRUCTURE && type->u_structure->generics.size != 0) {
+                dc_structure* structure = type->u_structure;
+                if (type->_generic_impl_index >= structure->_generic_impls.size) {
+                    return INTERFACE_NONE;
+                }
+                impl = &structure->_generic_impls.data[type->_generic_impl_index];
+            }
+            break;
+
+        default:
+            return INTERFACE_NONE;
+    }
+
+    /* nested types are written first */
+    uint32_t impl_count = impl != NULL ? impl->size : 0;
+    uint32_t* impl_types = checked_malloc(sizeof(uint32_t) * (impl_count + 1));
+    for (uint32_t i = 0; i < impl_count; i++) {
+        impl_types[i] = if_write_type(writer, &impl->data[i]);
+        if (impl_types[i] == INTERFACE_NONE) {
+            free(impl_types);
+            return INTERFACE_NONE;
+        }
+    }
+
+    /* only pointers and unsized arrays are supported */
+    if (type->level_list.size > INTERFACE_MAX_LEVELS) {
+        free(impl_types);
+        return INTERFACE_NONE;
+    }
+    result.levels.first = if_table_size(writer->indices, uint32_t);
+    result.levels.count = type->level_list.size;
+    iterate_array(i, type->level_list.size) {
+        ast_type_level level = type->level_list.data[i];
+        if (level.kind != AT_LEVEL_POINTER && (level.kind != AT_LEVEL_ARRAY || level.u_array_size != NULL)) {
+            free(impl_types);
+            return INTERFACE_NONE;
+        }
+        uint32_t value = level.kind;
+        if_table_add(writer->indices, value);
+    }
+
+    result.generic_impl.first = if_table_size(writer->indices, uint32_t);
+    result.generic_impl.count = impl_count;
+    for (uint32_t i = 0; i < impl_count; i++) {
+        if_table_add(writer->indices, impl_types[i]);
+    }
+    free(impl_types);
+
+    return if_table_add(writer->types, result);
+}
+
+/**
+ * Appends a list of members or parameters to the member table
+ *
+ * @param[in]  writer Pointer to the writer
+ * @param[in]  names  Member names
+ * @param[in]  types  Member types
+ * @param[in]  stride Distance between the members in bytes
+ * @param[in]  count  Number of members
+ * @param[out] range  The member range
+ *
+ * @return false if a member cannot be represented
+ */
+static bool if_write_members(if_writer* writer, char** names, ast_type* types, size_t stride, size_t count, if_range* range) {
+    if_member* members = checked_malloc(sizeof(if_member) * (count + 1));
+    for (size_t i = 0; i < count; i++) {
+        members[i].name = if_write_string(writer, *(char**) ((char*) names + stride * i));
+        members[i].type = if_write_type(writer, (ast_type*) ((char*) types + stride * i));
+        if (members[i].type == INTERFACE_NONE) {
+            free(members);
+            return false;
+        }
+    }
+
+    range->first = if_table_size(writer->members, if_member);
+    range->count = count;
+    for (size_t i = 0; i < count; i++) {
+        if_table_add(writer->members, members[i]);
+    }
+    free(members);
+    return true;
+}
+
+/**
+ * Appends a declaration owned by the module
+ *
+ * @param[in] writer    Pointer to the writer
+ * @param[in] dc        The declaration
+ * @param[in] is_hidden Marks the declarations which are not in the symbol table
+ *
+ * @return false if the declaration cannot be represented
+ */
+static bool if_write_declaration(if_writer* writer, declaration* dc, bool is_hidden) {
+    if_declaration result = {
+        .kind = dc->kind,
+        .flags = (dc->is_full ? IF_FLAG_FULL : 0) | (is_hidden ? IF_FLAG_HIDDEN : 0),
+        .name = if_write_string(writer, dc->name != NULL ? dc->name : ""),
+        .type = INTERFACE_NONE
+    };
+
+    switch (dc->kind) {
+        case DC_STRUCTURE: {
+            dc_structure* structure = dc->u_structure;
+            if (structure->is_c_struct) result.flags |= IF_FLAG_C;
+
+            dc_structure_member* members = structure->member_list.data;
+            if (structure->member_list.size != 0 && !if_write_members(writer, &members[0].name, &members[0].type,
+                    sizeof(dc_structure_member), structure->member_list.size, &result.members)) {
+                return false;
+            }
+
+            uint32_t* generics = checked_malloc(sizeof(uint32_t) * (structure->generics.size + 1));
+            iterate_array(i, structure->generics.size) {
+                generics[i] = if_write_string(writer, structure->generics.data[i]->name);
+            }
+            result.generics.first = if_table_size(writer->indices, uint32_t);
+            result.generics.count = structure->generics.size;
+            iterate_array(i, structure->generics.size) {
+                if_table_add(writer->indices, generics[i]);
+            }
+            free(generics);
+            break;
+        }
+
+        case DC_ENUM: {
+            dc_enum* value = dc->u_enum;
+            if (value->is_c_enum) result.flags |= IF_FLAG_C;
+
+            if_enum_member* members = checked_malloc(sizeof(if_enum_member) * (value->member_list.size + 1));
+            iterate_array(i, value->member_list.size) {
+                dc_enum_member* member = &value->member_list.data[i];
+                if (member->value.kind > EX_C_DOUBLE) {
+                    free(members);
+                    return false;
+                }
+                members[i].name = if_write_string(writer, member->name);
+                members[i].kind = member->value.kind;
+                members[i].value = 0;
+                memcpy(&members[i].value, &member->value._union_offset, ex_constant_size_table[member->value.kind]);
+            }
+            result.members.first = if_table_size(writer->enum_members, if_enum_member);
+            result.members.count = value->member_list.size;
+            iterate_array(i, value->member_list.size) {
+                if_table_add(writer->enum_members, members[i]);
+            }
+            free(members);
+            break;
+        }
+
+        case DC_ALIAS:
+            result.type = if_write_type(writer, &dc->u_alias->target);
+            if (result.type == INTERFACE_NONE) {
+                return false;
+            }
+            break;
+
+        case DC_FUNCTION: {
+            dc_function* function = dc->u_function;
+            if (function->is_extern) result.flags |= IF_FLAG_EXTERN;
+            if (function->parameters.is_c_vararg) result.flags |= IF_FLAG_C_VARARG;
+
+            result.type = if_write_type(writer, &function->return_type);
+            if (result.type == INTERFACE_NONE) {
+                return false;
+            }
+
+            dc_function_parameter* parameters = function->parameters.value.data;
+            if (function->parameters.value.size != 0 && !if_write_members(writer, &parameters[0].name, &parameters[0].type,
+                    sizeof(dc_function_parameter), function->parameters.value.size, &result.members)) {
+                return false;
+            }
+            break;
+        }
+
+        case DC_ST_VARIABLE:
+            result.type = if_write_type(writer, &dc->u_variable->type);
+            if (result.type == INTERFACE_NONE) {
+                return false;
+            }
+            break;
+
+        case DC_CONSTANT: {
+            /* the value is a single enum member */
+            dc_constant* constant = dc->u_constant;
+            if (writer->native_unit == NULL || constant->value.kind > EX_C_DOUBLE) {
+                return false;
+            }
+            ast_type type;
+            ast_type_init(&type, AST_TYPE_PRIMITIVE, constant->type);
+            result.type = if_write_type(writer, &type);
+            if (result.type == INTERFACE_NONE) {
+                return false;
+            }
+
+            if_enum_member member = {
+                .name = result.name,
+                .kind = constant->value.kind,
+                .value = 0
+            };
+            memcpy(&member.value, &constant->value._union_offset, ex_constant_size_table[constant->value.kind]);
+            result.members.first = if_table_add(writer->enum_members, member);
+            result.members.count = 1;
+            break;
+        }
+
+        default:
+            return false;
+    }
+
+    if_table_add(writer->declarations, result);
+    return true;
+}
+
+/**
+ * Collects the contents of the module into the writer tables
+ *
+ * @param[in] writer Pointer to the writer
+ * @param[in] module Pointer to the module
+ *
+ * @return false if the module cannot be represented
+ */
+static bool if_write_module(if_writer* writer, se_module* module) {
+    se_context* context = module->context;
+
+    /* files parsed in place would be duplicated by the replayed imports */
+    iterate_array(i, context->file_list.size) {
+        se_context_import_file* file = context->file_list.data[i];
+        if (file->is_native || file->filename == module->filename) {
+            continue;
+        }
+        if (!file->is_linked) {
+            log_debug(LOG_IMPORT, "module %s has imports parsed in place, not writing its interface", module->filename);
+            return false;
+        }
+
+        uint64_t hash;
+        if (!module_hash_file(file->filename, &hash)) {
+            return false;
+        }
+        if_dependency dependency = { .filename = if_write_string(writer, file->filename), .hash = hash };
+        if_table_add(writer->dependencies, dependency);
+    }
+
+    /* imports in the source order */
+    iterate_array(i, context->import_list.size) {
+        dc_import* import = context->import_list.data[i];
+        if_import result = { .is_native = import->is_native };
+
+        uint32_t* path = checked_malloc(sizeof(uint32_t) * (import->path.size + 1));
+        iterate_array(j, import->path.size) {
+            path[j] = if_write_string(writer, import->path.data[j]);
+        }
+        result.path.first = if_table_size(writer->indices, uint32_t);
+        result.path.count = import->path.size;
+        iterate_array(j, import->path.size) {
+            if_table_add(writer->indices, path[j]);
+        }
+        free(path);
+
+        if_table_add(writer->imports, result);
+    }
+
+    /* declarations owned by the module */
+    iterate_array(i, context->ast.declaration_list.size) {
+        declaration* dc = context->ast.declaration_list.data[i];
+        if (dc->is_shared || dc->is_native || dc->kind == DC_IMPORT || dc->kind == DC_PRIMITIVE) {
+            continue;
+        }
+        if_add_local(writer, dc);
+    }
+    if_set_named(writer);
+    for (uint32_t i = 0; i < writer->local_count; i++) {
+        if (!if_write_declaration(writer, writer->locals[i], false)) {
+            log_debug(LOG_IMPORT, "declaration %s of module %s cannot be written into an interface",
+                writer->locals[i]->name, module->filename);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Collects the native declarations of a native unit
+ * into the writer tables, translating the lazy ones
+ *
+ * @param[in] writer Pointer to the writer
+ *
+ * @return false if the declarations cannot be represented
+ */
+static bool if_write_native(if_writer* writer) {
+    ast_symbol_table* table = &writer->context->ast.symbol_table;
+    for (size_t i = 0; i < table->capacity; i++) {
+        declaration* dc = table->data[i].value;
+        if (table->data[i].key == NULL || !dc->is_native || dc->kind == DC_IMPORT || dc->kind == DC_PRIMITIVE) {
+            continue;
+        }
+        iterate_array(j, dc->native_filename_list.size) {
+            if (dc->native_filename_list.data[j] == writer->native_unit) {
+                if_add_local(writer, dc);
+                break;
+            }
+        }
+    }
+    if_set_named(writer);
+
+    /* translation only refers to the declarations of the inner types */
+    for (uint32_t i = 0; i < writer->named_count; i++) {
+        cst_native_declaration_resolve(writer->locals[i]);
+    }
+    for (uint32_t i = 0; i < writer->local_count; i++) {
+        if (!if_write_declaration(writer, writer->locals[i], i >= writer->named_count)) {
+            log_debug(LOG_NATIVE, "native declaration %s of %s cannot be written into a snapshot",
+                writer->locals[i]->name, writer->native_unit);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Appends a table to the interface file
+ *
+ * @param[in]  file   The file
+ * @param[in]  buffer The table
+ * @param[in]  size   Size of a record
+ * @param[out] range  The table range
+ * @param[in]  offset Pointer to the current file offset
+ */
+static void if_write_table(FILE* file, if_buffer* buffer, size_t size, if_range* range, size_t* offset) {
+    static const char padding[INTERFACE_ALIGNMENT] = { 0 };
+    range->first = *offset;
+    range->count = buffer->size / size;
+    fwrite(buffer->data, 1, buffer->size, file);
+    *offset += buffer->size;
+
+    size_t extra = (INTERFACE_ALIGNMENT - *offset % INTERFACE_ALIGNMENT) % INTERFACE_ALIGNMENT;
+    fwrite(padding, 1, extra, file);
+    *offset += extra;
+}
+
+/**
+ * Writes the collected tables into an interface file,
+ * replacing the file atomically
+ *
+ * @param[in] writer Pointer to the writer
+ * @param[in] path   The file path
+ * @param[in] magic  Magic number of the file
+ * @param[in] hash   Hash the file is valid for
+ *
+ * @return false if the file has not been written
+ */
+static bool if_write_file(if_writer* writer, char* path, uint32_t magic, uint64_t hash) {
+    char temporary[PATH_MAX];
+    snprintf(temporary, sizeof(temporary), "%s.%d.tmp", path, (int) getpid());
+    FILE* file = fopen(temporary, "wb");
+    if (file == NULL) {
+        return false;
+    }
+    if_header header = {
+        .magic = magic,
+        .version = INTERFACE_VERSION,
+        .hash = hash
+    };
+
+    /* the header is written last, when the table offsets are known */
+    fwrite(&header, 1, sizeof(if_header), file);
+    size_t offset = sizeof(if_header);
+    if_range strings;
+    if_write_table(file, &writer->strings, 1, &strings, &offset);
+    header.string_size = strings.count;
+    if_write_table(file, &writer->imports, sizeof(if_import), &header.imports, &offset);
+    if_write_table(file, &writer->dependencies, sizeof(if_dependency), &header.dependencies, &offset);
+    if_write_table(file, &writer->declarations, sizeof(if_declaration), &header.declarations, &offset);
+    if_write_table(file, &writer->members, sizeof(if_member), &header.members, &offset);
+    if_write_table(file, &writer->enum_members, sizeof(if_enum_member), &header.enum_members, &offset);
+    if_write_table(file, &writer->types, sizeof(if_type), &header.types, &offset);
+    if_write_table(file, &writer->indices, sizeof(uint32_t), &header.indices, &offset);
+    header.file_size = offset;
+
+    bool result = offset <= UINT32_MAX && fseek(file, 0, SEEK_SET) == 0
+        && fwrite(&header, 1, sizeof(if_header), file) == sizeof(if_header);
+    if (fclose(file) != 0 || !result || rename(temporary, path) != 0) {
+        unlink(temporary);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Releases the writer state
+ *
+ * @param[in] writer Pointer to the writer
+ */
+static void if_writer_free(if_writer* writer) {
+    for (uint32_t i = writer->named_count; i < writer->local_count; i++) {
+        free(writer->locals[i]);
+    }
+    free(writer->locals);
+    free(writer->local_map.data);
+    free(writer->named_map.data);
+    free(writer->external_map.data);
+    free(writer->strings.data);
+    free(writer->imports.data);
+    free(writer->dependencies.data);
+    free(writer->declarations.data);
+    free(writer->members.data);
+    free(writer->enum_members.data);
+    free(writer->types.data);
+    free(writer->indices.data);
+}
+
+        /* reader */
+
+/**
+ * Checks that a table range is inside the mapped file
+ *
+ * @param[in] reader Pointer to the reader
+ * @param[in] range  The range
+ * @param[in] size   Size of a record
+ *
+ * @return true if the range is valid
+ */
+static bool if_check_table(if_reader* reader, if_range range, size_t size) {
+    return range.first % INTERFACE_ALIGNMENT == 0
+        && range.first <= reader->header->file_size
+        && (reader->header->file_size - range.first) / size >= range.count;
+}
+
+/**
+ * Checks that a record range is inside a table
+ */
+#define if_check_range(range, table) ((range).first <= (table).count && (table).count - (range).first >= (range).count)
+
+/**
+ * Returns a record of a table
+ */
+#define if_record(reader, type, table, index) \
+    (&((const type*) ((reader)->data + (reader)->header->table.first))[index])
+
+/**
+ * Returns a string of the string table or NULL if the offset is invalid
+ *
+ * @param[in] reader Pointer to the reader
+ * @param[in] offset Offset of the string
+ *
+ * @return The string
+ */
+static const char* if_read_string(if_reader* reader, uint32_t offset) {
+    if (offset >= reader->header->string_size) {
+        return NULL;
+    }
+    return reader->data + sizeof(if_header) + offset;
+}
+
+/**
+ * Returns an interned string of the string table or NULL if the offset is invalid
+ */
+static char* if_read_name(if_reader* reader, uint32_t offset) {
+    const char* string = if_read_string(reader, offset);
+    return string != NULL ? intern_string((char*) string) : NULL;
+}
+
+/**
+ * Reads an entry of the index table
+ */
+#define if_read_index(reader, index) (*if_record(reader, uint32_t, indices, index))
+
+/**
+ * Reads a type
+ *
+ * @param[in]  reader Pointer to the reader
+ * @param[in]  index  Index of the type
+ * @param[in]  limit  Types must precede the types which refer to them
+ * @param[out] type   The type
+ *
+ * @return false if the type is invalid or cannot be resolved
+ */
+static bool if_read_type(if_reader* reader, uint32_t index, uint32_t limit, ast_type* type) {
+    if (index >= limit) {
+        return false;
+    }
+    const if_type* value = if_record(reader, if_type, types, index);
+    if (!if_check_range(value->levels, reader->header->indices)
+            || !if_check_range(value->generic_impl, reader->header->indices)) {
+        return false;
+    }
+
+    /* resolve the reference */
+    void* reference = NULL;
+    declaration_kind kind = value->kind == AST_TYPE_STRUCTURE ? DC_STRUCTURE
+                          : value->kind == AST_TYPE_ENUM ? DC_ENUM : DC_FUNCTION;
+    switch (value->reference_kind) {
+        case IF_REF_PRIMITIVE: {
+            const char* name = if_read_string(reader, value->reference);
+            if (name == NULL || value->kind != AST_TYPE_PRIMITIVE) {
+                return false;
+            }
+            iterate_array(i, primitive_list.size) {
+                if (strcmp(primitive_list.data[i].name, name) == 0) {
+                    reference = &primitive_list.data[i];
+                    break;
+                }
+            }
+            break;
+        }
+
+        case IF_REF_LOCAL:
+            if (value->reference >= reader->header->declarations.count
+                    || value->kind == AST_TYPE_PRIMITIVE || value->kind == AST_TYPE_GENERIC
+                    || if_record(reader, if_declaration, declarations, value->reference)->kind != kind) {
+                return false;
+            }
+            reference = reader->locals[value->reference];
+            break;
+
+        case IF_REF_EXTERNAL: {
+            char* name = if_read_name(reader, value->reference);
+            if (name == NULL || value->kind == AST_TYPE_PRIMITIVE || value->kind == AST_TYPE_GENERIC) {
+                return false;
+            }
+            declaration* dc = ast_declaration_lookup(&reader->context->ast, name);
+            if (dc == NULL || dc->kind != kind) {
+                log_debug(LOG_IMPORT, "interface reference %s cannot be resolved", name);
+                return false;
+            }
+            reference = dc->u__any;
+            break;
+        }
+
+        case IF_REF_GENERIC: {
+            if (value->reference >= reader->header->declarations.count
+                    || value->kind != AST_TYPE_GENERIC
+                    || if_record(reader, if_declaration, declarations, value->reference)->kind != DC_STRUCTURE) {
+                return false;
+            }
+            dc_structure* structure = reader->locals[value->reference];
+            if (value->generic_index >= structure->generics.size) {
+                return false;
+            }
+            reference = structure->generics.data[value->generic_index];
+            break;
+        }
+
+        default:
+            return false;
+    }
+    if (reference == NULL || value->kind > AST_TYPE_GENERIC) {
+        return false;
+    }
+    ast_type_init(type, value->kind, reference);
+    type->_generic_impl_index = 0;
+
+    /* register the generic implementation */
+    size_t generic_count = value->kind == AST_TYPE_STRUCTURE ? ((dc_structure*) reference)->generics.size : 0;
+    if (value->generic_impl.count != generic_count) {
+        return false;
+    }
+    if (generic_count != 0) {
+        dc_structure* structure = reference;
+        list(ast_type) impl;
+        li_init(ast_type, impl, value->generic_impl.count);
+        for (uint32_t i = 0; i < value->generic_impl.count; i++) {
+            if (!if_read_type(reader, if_read_index(reader, value->generic_impl.first + i), index, &impl.data[i])) {
+                return false;
+            }
+        }
+        if (structure->_is_sealed) {
+            /* modules adding implementations to an imported structure are not saved */
+            if (!dc_structure_generic_find_impl(structure, impl, &type->_generic_impl_index)) {
+                return false;
+            }
+        } else {
+            type->_generic_impl_index = dc_structure_generic_add_impl(structure, impl);
+        }
+    }
+
+    /* type levels */
+    if (value->levels.count > INTERFACE_MAX_LEVELS) {
+        return false;
+    }
+    for (uint32_t i = 0; i < value->levels.count; i++) {
+        switch (if_read_index(reader, value->levels.first + i)) {
+            case AT_LEVEL_POINTER:
+                ast_type_pointer_wrap(type);
+                break;
+
+            case AT_LEVEL_ARRAY:
+                ast_type_array_wrap(type);
+                break;
+
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Reads a list of members or parameters
+ *
+ * @param[in]  reader Pointer to the reader
+ * @param[in]  range  The member range
+ * @param[out] names  Member names
+ * @param[out] types  Member types
+ * @param[in]  stride Distance between the members in bytes
+ *
+ * @return false if a member is invalid
+ */
+static bool if_read_members(if_reader* reader, if_range range, char** names, ast_type* types, size_t stride) {
+    if (!if_check_range(range, reader->header->members)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < range.count; i++) {
+        const if_member* member = if_record(reader, if_member, members, range.first + i);
+        char** name = (char**) ((char*) names + stride * i);
+        *name = if_read_name(reader, member->name);
+        if (*name == NULL || !if_read_type(reader, member->type, reader->header->types.count,
+                (ast_type*) ((char*) types + stride * i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Allocates the value of a declaration owned by the module,
+ * so that the declarations can refer to each other
+ *
+ * @param[in] reader Pointer to the reader
+ * @param[in] dc     The declaration
+ *
+ * @return The value or NULL if the declaration is invalid
+ */
+static void* if_create_declaration(if_reader* reader, const if_declaration* dc) {
+    char* name = if_read_name(reader, dc->name);
+    bool is_full = dc->flags & IF_FLAG_FULL;
+    if (name == NULL) {
+        return NULL;
+    }
+    if (dc->flags & IF_FLAG_HIDDEN) {
+        if (reader->native_unit == NULL) {
+            return NULL;
+        }
+        if (*name == '\0') {
+            name = NULL; /* anonymous */
+        }
+    }
+
+    switch (dc->kind) {
+        case DC_STRUCTURE: {
+            if (!if_check_range(dc->generics, reader->header->indices)) {
+                return NULL;
+            }
+            dc_structure* structure = allocate(dc_structure);
+            structure->_origin = NULL;
+            structure->_is_sealed = false;
+            structure->is_full = is_full;
+            structure->name = name;
+            structure->is_c_struct = dc->flags & IF_FLAG_C;
+            arraylist_init_empty(list(ast_type))(&structure->_generic_impls);
+            arraylist_init_empty(ast_layout)(&structure->_layouts);
+            li_init_empty(dc_structure_member, structure->member_list);
+
+            li_init(dc_generic_ptr, structure->generics, dc->generics.count);
+            for (uint32_t i = 0; i < dc->generics.count; i++) {
+                dc_generic* generic = allocate(dc_generic);
+                memset(generic, 0, sizeof(dc_generic));
+                generic->name = if_read_name(reader, if_read_index(reader, dc->generics.first + i));
+                if (generic->name == NULL) {
+                    return NULL;
+                }
+                structure->generics.data[i] = generic;
+            }
+            return structure;
+        }
+
+        case DC_ENUM: {
+            dc_enum* value = allocate(dc_enum);
+            value->_origin = NULL;
+            value->is_full = is_full;
+            value->is_c_enum = dc->flags & IF_FLAG_C;
+            value->name = name;
+            return value;
+        }
+
+        case DC_ALIAS: {
+            dc_alias* alias = allocate(dc_alias);
+            alias->is_full = is_full;
+            alias->name = name;
+            return alias;
+        }
+
+        case DC_FUNCTION: {
+            dc_function* function = allocate(dc_function);
+            function->is_full = is_full;
+            function->name = name;
+            function->is_extern = dc->flags & IF_FLAG_EXTERN;
+            function->parameters.is_c_vararg = dc->flags & IF_FLAG_C_VARARG;
+            li_init_empty(st_compound_item, function->body);
+            return function;
+        }
+
+        case DC_ST_VARIABLE: {
+            dc_st_variable* variable = allocate(dc_st_variable);
+            variable->is_full = is_full;
+            variable->name = name;
+            arraylist_init_empty(ex_constructor_ptr)(&variable->value.constructors);
+            variable->value.value = NULL;
+            return variable;
+        }
+
+        case DC_CONSTANT: {
+            if (reader->native_unit == NULL || (dc->flags & IF_FLAG_HIDDEN)) {
+                return NULL;
+            }
+            dc_constant* constant = allocate(dc_constant);
+            constant->name = name;
+            return constant;
+        }
+
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * Allocates the value of a native snapshot declaration,
+ * reusing the native declaration of the same name and kind
+ * so that the types of several headers stay equal
+ *
+ * @param[in] reader Pointer to the reader
+ * @param[in] index  Index of the declaration
+ *
+ * @return The value or NULL if the declaration is invalid
+ */
+static void* if_create_native(if_reader* reader, uint32_t index) {
+    const if_declaration* dc = if_record(reader, if_declaration, declarations, index);
+    const char* name = if_read_string(reader, dc->name);
+    if (name == NULL) {
+        return NULL;
+    }
+
+    declaration* dc_ex = NULL;
+    if (!(dc->flags & IF_FLAG_HIDDEN)) {
+        dc_ex = ast_symbol_table_find(&reader->context->ast.symbol_table, intern_string((char*) name));
+    }
+    if (dc_ex == NULL || !dc_ex->is_native || dc_ex->kind != dc->kind) {
+        return if_create_declaration(reader, dc);
+    }
+    cst_native_declaration_resolve(dc_ex);
+    reader->existing[index] = dc_ex;
+
+    /* a partial structure or enum is completed in place */
+    if (!dc_ex->is_full && (dc->flags & IF_FLAG_FULL) && (dc->kind == DC_STRUCTURE || dc->kind == DC_ENUM)) {
+        reader->completed[index] = if_create_declaration(reader, dc);
+        if (reader->completed[index] == NULL) {
+            return NULL;
+        }
+    }
+    return dc_ex->u__any;
+}
+
+/**
+ * Reads the body of a declaration owned by the module
+ *
+ * @param[in] reader Pointer to the reader
+ * @param[in] dc     The declaration
+ * @param[in] value  The value allocated by if_create_declaration
+ *
+ * @return false if the declaration is invalid
+ */
+static bool if_read_declaration(if_reader* reader, const if_declaration* dc, void* value) {
+    uint32_t types = reader->header->types.count;
+
+    switch (dc->kind) {
+        case DC_STRUCTURE: {
+            dc_structure* structure = value;
+            li_init(dc_structure_member, structure->member_list, dc->members.count);
+            if (dc->members.count != 0 && !if_read_members(reader, dc->members,
+                    &structure->member_list.data[0].name, &structure->member_list.data[0].type,
+                    sizeof(dc_structure_member))) {
+                return false;
+            }
+            return true;
+        }
+
+        case DC_ENUM: {
+            dc_enum* enumeration = value;
+            if (!if_check_range(dc->members, reader->header->enum_members)) {
+                return false;
+            }
+            li_init(dc_enum_member, enumeration->member_list, dc->members.count);
+            for (uint32_t i = 0; i < dc->members.count; i++) {
+                const if_enum_member* member = if_record(reader, if_enum_member, enum_members, dc->members.first + i);
+                dc_enum_member* result = &enumeration->member_list.data[i];
+                result->name = if_read_name(reader, member->name);
+                if (result->name == NULL || member->kind > EX_C_DOUBLE) {
+                    return false;
+                }
+                result->value.kind = member->kind;
+                memcpy(&result->value._union_offset, &member->value, ex_constant_size_table[member->kind]);
+                result->value.origin = NULL;
+                result->parent = enumeration;
+            }
+            return true;
+        }
+
+        case DC_ALIAS: {
+            dc_alias* alias = value;
+            if (!if_read_type(reader, dc->type, types, &alias->target)) {
+                return false;
+            }
+            return true;
+        }
+
+        case DC_FUNCTION: {
+            dc_function* function = value;
+            if (!if_read_type(reader, dc->type, types, &function->return_type)) {
+                return false;
+            }
+            li_init(dc_function_parameter, function->parameters.value, dc->members.count);
+            if (dc->members.count != 0 && !if_read_members(reader, dc->members,
+                    &function->parameters.value.data[0].name, &function->parameters.value.data[0].type,
+                    sizeof(dc_function_parameter))) {
+                return false;
+            }
+            return true;
+        }
+
+        case DC_ST_VARIABLE: {
+            dc_st_variable* variable = value;
+            if (!if_read_type(reader, dc->type, types, &variable->type)) {
+                return false;
+            }
+            return true;
+        }
+
+        case DC_CONSTANT: {
+            dc_constant* constant = value;
+            ast_type type;
+            if (!if_read_type(reader, dc->type, types, &type)
+                    || type.kind != AST_TYPE_PRIMITIVE || type.level_list.size != 0
+                    || dc->members.count != 1 || !if_check_range(dc->members, reader->header->enum_members)) {
+                return false;
+            }
+            const if_enum_member* member = if_record(reader, if_enum_member, enum_members, dc->members.first);
+            if (member->kind > EX_C_DOUBLE) {
+                return false;
+            }
+            constant->type = type.u_primitive;
+            constant->value.kind = member->kind;
+            memcpy(&constant->value._union_offset, &member->value, ex_constant_size_table[member->kind]);
+            constant->value.origin = NULL;
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * Adds a declaration read by if_read_declaration to the context,
+ * hidden declarations are only referred to by types
+ *
+ * @param[in] reader Pointer to the reader
+ * @param[in] index  Index of the declaration
+ */
+static void if_declare(if_reader* reader, uint32_t index) {
+    const if_declaration* dc = if_record(reader, if_declaration, declarations, index);
+    void* value = reader->locals[index];
+    ast_root* ast = &reader->context->ast;
+    if (dc->flags & IF_FLAG_HIDDEN) {
+        return;
+    }
+
+    int token, ctoken;
+    if_declaration_tokens(dc->kind, &token, &ctoken);
+    char* name = if_value_name(dc->kind, value);
+    if (reader->native_unit == NULL) {
+        ast_declare(ast, dc->kind, token, ctoken, name, value);
+        return;
+    }
+
+    declaration* dc_ex = reader->existing[index];
+    if (dc_ex == NULL) {
+        ast_declare_native(ast, dc->kind, token, ctoken, name, value, reader->native_unit);
+        return;
+    }
+
+    /* the existing value keeps its identity */
+    if (reader->completed[index] != NULL) {
+        if (dc->kind == DC_STRUCTURE) {
+            *(dc_structure*) value = *(dc_structure*) reader->completed[index];
+        } else {
+            dc_enum* enumeration = value;
+            *enumeration = *(dc_enum*) reader->completed[index];
+            iterate_array(i, enumeration->member_list.size) {
+                enumeration->member_list.data[i].parent = enumeration;
+            }
+        }
+        dc_ex->is_full = true;
+    }
+    ast_add_native_filename(dc_ex, reader->native_unit);
+}
+
+/**
+ * Validates the interface header and tables
+ *
+ * @param[in] reader Pointer to the reader
+ * @param[in] size   Size of the mapped file
+ * @param[in] magic  Expected magic number
+ * @param[in] hash   Expected hash
+ * @param[in] name   Name of the module or header for messages
+ *
+ * @return true if the interface is valid for the module
+ */
+static bool if_read_header(if_reader* reader, size_t size, uint32_t magic, uint64_t hash, char* name) {
+    const if_header* header = reader->header;
+    if (size < sizeof(if_header) || header->magic != magic
+            || header->version != INTERFACE_VERSION || header->file_size != size) {
+        return false;
+    }
+    if (header->hash != hash) {
+        log_debug(LOG_IMPORT, "interface of %s is outdated", name);
+        return false;
+    }
+
+    /* the string table must end with a null character */
+    if (header->string_size == 0 || header->string_size > size - sizeof(if_header)
+            || reader->data[sizeof(if_header) + header->string_size - 1] != '\0') {
+        return false;
+    }
+
+    return if_check_table(reader, header->imports, sizeof(if_import))
+        && if_check_table(reader, header->dependencies, sizeof(if_dependency))
+        && if_check_table(reader, header->declarations, sizeof(if_declaration))
+        && if_check_table(reader, header->members, sizeof(if_member))
+        && if_check_table(reader, header->enum_members, sizeof(if_enum_member))
+        && if_check_table(reader, header->types, sizeof(if_type))
+        && if_check_table(reader, header->indices, sizeof(uint32_t));
+}
+
+/**
+ * Loads the contents of a mapped interface
+ *
+ * @param[in] reader Pointer to the reader
+ * @param[in] module Pointer to the module
+ *
+ * @return false if the interface is invalid or outdated
+ */
+static bool if_read_module(if_reader* reader, se_module* module) {
+    const if_header* header = reader->header;
+    se_context* context = reader->context;
+
+    /* every module the interface refers to must be unchanged */
+    for (uint32_t i = 0; i < header->dependencies.count; i++) {
+        const if_dependency* dependency = if_record(reader, if_dependency, dependencies, i);
+        const char* filename = if_read_string(reader, dependency->filename);
+        uint64_t hash;
+        if (filename == NULL || !module_hash_file((char*) filename, &hash) || hash != dependency->hash) {
+            log_debug(LOG_IMPORT, "interface of %s is outdated because of its imports", module->filename);
+            return false;
+        }
+    }
+
+    /* allocate the declarations */
+    reader->locals = allocate_array(void*, header->declarations.count + 1);
+    for (uint32_t i = 0; i < header->declarations.count; i++) {
+        reader->locals[i] = if_create_declaration(reader, if_record(reader, if_declaration, declarations, i));
+        if (reader->locals[i] == NULL) {
+            return false;
+        }
+    }
+
+    /* replay the imports */
+    arraylist(dc_import_ptr) imports;
+    arl_init(dc_import_ptr, imports);
+    for (uint32_t i = 0; i < header->imports.count; i++) {
+        const if_import* value = if_record(reader, if_import, imports, i);
+        if (value->path.count == 0 || !if_check_range(value->path, header->indices)) {
+            arraylist_free(dc_import_ptr)(&imports);
+            return false;
+        }
+
+        dc_import* import = allocate(dc_import);
+        import->is_native = value->is_native;
+        li_init(dc_import_node, import->path, value->path.count);
+        for (uint32_t j = 0; j < value->path.count; j++) {
+            import->path.data[j] = if_read_name(reader, if_read_index(reader, value->path.first + j));
+            if (import->path.data[j] == NULL) {
+                arraylist_free(dc_import_ptr)(&imports);
+                return false;
+            }
+        }
+        arl_add(dc_import_ptr, imports, import);
+    }
+    context->pass = SCTX_PASS_1;
+    iterate_array(i, imports.size) {
+        context_import(context, imports.data[i]);
+    }
+    context->pass = SCTX_PASS_2;
+    iterate_array(i, imports.size) {
+        context_import(context, imports.data[i]);
+    }
+    arraylist_free(dc_import_ptr)(&imports);
+
+    /* read the declarations */
+    for (uint32_t i = 0; i < header->declarations.count; i++) {
+        if (!if_read_declaration(reader, if_record(reader, if_declaration, declarations, i), reader->locals[i])) {
+            log_debug(LOG_IMPORT, "interface of %s is invalid", module->filename);
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header->declarations.count; i++) {
+        if_declare(reader, i);
+    }
+    return true;
+}
+
+/**
+ * Loads the contents of a mapped native snapshot
+ *
+ * Every declaration is read before the first one is
+ * added to the symbol table, so that an invalid snapshot
+ * leaves the context unchanged
+ *
+ * @param[in] reader Pointer to the reader
+ * @param[in] header The header name
+ *
+ * @return false if the snapshot is invalid
+ */
+static bool if_read_native(if_reader* reader, char* header) {
+    uint32_t count = reader->header->declarations.count;
+    if (reader->header->imports.count != 0 || reader->header->dependencies.count != 0) {
+        return false;
+    }
+
+    /* allocate the declarations */
+    reader->locals = allocate_array(void*, count + 1);
+    reader->existing = allocate_array(declaration*, count + 1);
+    reader->completed = allocate_array(void*, count + 1);
+    memset(reader->existing, 0, sizeof(declaration*) * count);
+    memset(reader->completed, 0, sizeof(void*) * count);
+    for (uint32_t i = 0; i < count; i++) {
+        reader->locals[i] = if_create_native(reader, i);
+        if (reader->locals[i] == NULL) {
+            return false;
+        }
+    }
+
+    /* read the declarations */
+    for (uint32_t i = 0; i < count; i++) {
+        if (reader->existing[i] != NULL && reader->completed[i] == NULL) {
+            continue;
+        }
+        void* value = reader->completed[i] != NULL ? reader->completed[i] : reader->locals[i];
+        if (!if_read_declaration(reader, if_record(reader, if_declaration, declarations, i), value)) {
+            log_debug(LOG_NATIVE, "snapshot of %s is invalid", header);
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if_declare(reader, i);
+    }
+    return true;
+}
+
+    /* functions */
+/**
+ * Loads the interface of a module into its module context,
+ * replaying the module imports first
+ *
+ * @param module Pointer to the module
+ * @param loader Pointer to the new module context
+ *
+ * @return false if there is no valid interface, in which
+ *         case the module context must be discarded
+ */
+bool interface_load(se_module* module, se_context* loader) {
+    char path[PATH_MAX];
+    if (!interface_path(module, path)) {
+        return false;
+    }
+
+    size_t size;
+    void* data = if_map(path, &size);
+    if (data == NULL) {
+        return false;
+    }
+
+    if_reader reader = {
+        .context = loader,
+        .native_unit = NULL,
+        .data = data,
+        .header = data,
+        .locals = NULL
+    };
+    bool result = if_read_header(&reader, size, INTERFACE_MAGIC, module->hash, module->filename)
+               && if_read_module(&reader, module);
+    munmap(data, size);
+
+    if (result) {
+        log_debug(LOG_IMPORT, "loaded the interface of %s", module->filename);
+    }
+    return result;
+}
+
+/**
+ * Writes the interface of a parsed module,
+ * does nothing if the module cannot be represented
+ *
+ * @param module Pointer to the module
+ */
+void interface_save(se_module* module) {
+    char path[PATH_MAX];
+    if (!interface_path(module, path)) {
+        return;
+    }
+
+    if_writer writer;
+    memset(&writer, 0, sizeof(if_writer));
+    writer.context = module->context;
+    if_buffer_add(&writer.strings, "", 1); /* the string table is never empty */
+
+    if (if_write_module(&writer, module) && if_write_file(&writer, path, INTERFACE_MAGIC, module->hash)) {
+        log_debug(LOG_IMPORT, "saved the interface of %s", module->filename);
+    }
+    if_writer_free(&writer);
+}
+
+/**
+ * Loads the declaration snapshot of a native header
+ * into the symbol table without parsing the header
+ *
+ * @param context     Pointer to the parser context
+ * @param header      The header name, as in #include <header>
+ * @param native_unit The native unit of the declarations
+ *
+ * @return false if there is no valid snapshot,
+ *         in which case the context is unchanged
+ */
+bool interface_load_native(se_context* context, char* header, char* native_unit) {
+    char path[PATH_MAX];
+    uint64_t hash;
+    if (!native_cache_snapshot(header, path, &hash)) {
+        return false;
+    }
+
+    size_t size;
+    void* data = if_map(path, &size);
+    if (data == NULL) {
+        return false;
+    }
+
+    if_reader reader = {
+        .context = context,
+        .native_unit = native_unit,
+        .data = data,
+        .header = data,
+        .locals = NULL
+    };
+    bool result = if_read_header(&reader, size, INTERFACE_NATIVE_MAGIC, hash, header)
+               && if_read_native(&reader, header);
+    if (result) {
+        log_debug(LOG_NATIVE, "loaded the snapshot of %s with %u declarations", header, reader.header->declarations.count);
+    }
+    munmap(data, size);
+    return result;
+}
+
+/**
+ * Writes the declaration snapshot of a parsed native header,
+ * does nothing if the declarations cannot be represented
+ *
+ * @param context     Pointer to the parser context
+ * @param header      The header name, as in #include <header>
+ * @param native_unit The native unit of the declarations
+ */
+void interface_save_native(se_context* context, char* header, char* native_unit) {
+    char path[PATH_MAX];
+    uint64_t hash;
+    if (!native_cache_snapshot(header, path, &hash)) {
+        return;
+    }
+
+    if_writer writer;
+    memset(&writer, 0, sizeof(if_writer));
+    writer.context = context;
+    writer.native_unit = native_unit;
+    if_buffer_add(&writer.strings, "", 1); /* the string table is never empty */
+
+    if (if_write_native(&writer) && if_write_file(&writer, path, INTERFACE_NATIVE_MAGIC, hash)) {
+        log_debug(LOG_NATIVE, "saved the snapshot of %s with %u declarations", header, writer.local_count);
+    }
+    if_writer_free(&writer);
+}
\ No newline at end of file
@@ -0,0 +1,349 @@
+/**
+ * @file module.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Process-wide cache of imported modules implementation
+ */
+    /* includes */
+#include "language/module.h" /* this */
+
+#include <stdio.h> /* file functions */
+#include <stdlib.h> /* memory allocation */
+#include <string.h> /* memory moving */
+#include <sys/stat.h> /* file status */
+
+#include "syntax/declaration/declaration.h" /* declarations */
+#include "misc/memory.h" /* memory allocation */
+#include "misc/intern.h" /* interned strings */
+#include "misc/hash.h" /* content hash */
+#include "language/interface.h" /* precompiled interfaces */
+#include "misc/trace.h" /* trace output */
+
+    /* global variables */
+/**
+ * List of all known modules
+ */
+static arraylist(se_module_ptr) module_list;
+static bool module_list_ready = false;
+
+    /* internal functions */
+/**
+ * Finds an imported file entry of a parser context
+ *
+ * @param[in] context   Pointer to the parser context
+ * @param[in] filename  Interned filename
+ * @param[in] is_native Whether the file is native
+ *
+ * @return Pointer to the entry or NULL
+ */
+static se_context_import_file* module_find_file(se_context* context, char* filename, bool is_native) {
+    iterate_array(i, context->file_list.size) {
+        se_context_import_file* file = context->file_list.data[i];
+        if (file->filename == filename && file->is_native == is_native) {
+            return file;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Removes a module from the module list,
+ * keeping the loading order of the others,
+ * which the import cycle check depends on
+ *
+ * @param[in] index Index of the module
+ */
+static void module_list_remove(index_t index) {
+    memmove(&module_list.data[index], &module_list.data[index + 1],
+        sizeof(se_module_ptr) * (module_list.size - index - 1));
+    module_list.size--;
+}
+
+/**
+ * Returns the modification time of a file
+ *
+ * @param[in] info The file status
+ *
+ * @return The time in nanoseconds
+ */
+static long long module_file_mtime(struct stat* info) {
+    return (long long) info->st_mtim.tv_sec * 1000000000 + info->st_mtim.tv_nsec;
+}
+
+/**
+ * Creates a module context with the module
+ * marked as imported to prevent self-imports
+ *
+ * @param context Pointer to the importing parser context
+ * @param module  Pointer to the module
+ *
+ * @return Pointer to the module context
+ */
+static se_context* module_new_context(se_context* context, se_module* module) {
+    se_context* loader = context_new();
+
+    /* nested imports are resolved the same way as for the importer */
+    loader->filename = context->filename;
+
+    se_context_import_file* file = allocate(se_context_import_file);
+    file->filename = module->filename;
+    file->is_native = false;
+    file->is_linked = false;
+    file->tokens = NULL;
+    file->native_unit = module->filename;
+    file->native_batch = NULL;
+    file->last = SCTX_PASS_2;
+    arl_add(se_context_import_file_ptr, loader->file_list, file);
+    return loader;
+}
+
+/**
+ * Loads the header-level declarations of a module into
+ * a new module context, from its precompiled interface
+ * if there is a valid one or by parsing the module
+ *
+ * @param context Pointer to the importing parser context
+ * @param module  Pointer to the module
+ */
+static void module_load(se_context* context, se_module* module) {
+    log_debug(LOG_IMPORT, "loading module %s", module->filename);
+    trace_begin("module", module->filename);
+    mem_arena* previous = arena_current;
+    se_context* loader = module_new_context(context, module);
+
+    trace_begin("interface", module->filename);
+    bool is_parsed = !interface_load(module, loader);
+    trace_end();
+    if (is_parsed) {
+        context_free(loader);
+        loader = module_new_context(context, module);
+        se_context_import_file* file = loader->file_list.data[0];
+
+        /* do the import passes */
+        loader->pass = SCTX_PASS_1;
+        file->last = loader->pass;
+        arena_reset(&loader->transient);
+        context_parse(loader, module->filename);
+        loader->pass = SCTX_PASS_2;
+        file->last = loader->pass;
+        arena_reset(&loader->transient);
+        context_parse(loader, module->filename);
+
+        /* the module file is not parsed again */
+        token_stream_free(file->tokens);
+        file->tokens = NULL;
+    }
+
+    arena_select(previous);
+
+    /* a module which is part of an import cycle depends on its importer */
+    if (module->is_cyclic) {
+        log_debug(LOG_IMPORT, "module %s is part of an import cycle, not caching", module->filename);
+        module->state = SE_MODULE_UNCACHEABLE;
+        context_free(loader);
+        trace_end();
+        return;
+    }
+
+    /* so does a module which has changed values of other modules or may have seen them changed */
+    module->is_dependent = loader->ast.is_dependent;
+    if (module->is_dependent || ast_shared_count != 0) {
+        log_debug(LOG_IMPORT, "module %s depends on its importer, not caching", module->filename);
+        module->state = SE_MODULE_UNCACHEABLE;
+        context_free(loader);
+        trace_end();
+        return;
+    }
+
+    /* implementations of the module's own structures are only added by the module */
+    iterate_array(i, loader->ast.declaration_list.size) {
+        declaration* dc = loader->ast.declaration_list.data[i];
+        if (dc->kind == DC_STRUCTURE && !dc->is_shared) {
+            dc->u_structure->_is_sealed = true;
+        }
+    }
+
+    module->context = loader;
+    module->state = SE_MODULE_READY;
+    if (is_parsed) {
+        interface_save(module);
+    }
+    trace_end();
+}
+
+    /* functions */
+/**
+ * Hashes the contents of a file
+ *
+ * @param[in]  filename Name of the file
+ * @param[out] hash     The content hash
+ *
+ * @return false if the file could not be read
+ */
+bool module_hash_file(char* filename, uint64_t* hash) {
+    FILE* file = fopen(filename, "rb");
+    if (file == NULL) {
+        return false;
+    }
+
+    bool result = false;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long size = ftell(file);
+        if (size >= 0 && fseek(file, 0, SEEK_SET) == 0) {
+            char* data = checked_malloc(size + 1);
+            if (fread(data, 1, size, file) == (size_t) size) {
+                *hash = hash_bytes(data, size);
+                result = true;
+            }
+            free(data);
+        }
+    }
+
+    fclose(file);
+    return result;
+}
+
+/**
+ * Finds a cached module or loads it
+ *
+ * @param context   Pointer to the importing parser context
+ * @param filename  Interned absolute filename of the module
+ * @param directory Interned directory of nested imports
+ *
+ * @return Pointer to the ready module, or NULL if
+ *         the file has to be parsed in place
+ */
+se_module* module_get(se_context* context, char* filename, char* directory) {
+    if (!module_list_ready) {
+        arl_init(se_module_ptr, module_list);
+        module_list_ready = true;
+    }
+
+    /* missing files are reported by the parser */
+    struct stat info;
+    if (stat(filename, &info) != 0) {
+        return NULL;
+    }
+    uint64_t hash;
+    bool is_hashed = false;
+
+    iterate_array(i, module_list.size) {
+        se_module* module = module_list.data[i];
+        if (module->filename != filename || module->directory != directory) {
+            continue;
+        }
+
+        switch (module->state) {
+            case SE_MODULE_LOADING:
+                /* every module loaded since this one is a part of the cycle */
+                iterate_range_single(j, i, module_list.size) {
+                    if (module_list.data[j]->state == SE_MODULE_LOADING) {
+                        module_list.data[j]->is_cyclic = true;
+                    }
+                }
+                return NULL;
+
+            case SE_MODULE_UNCACHEABLE:
+                /* the values completed by an earlier importer have been restored */
+                if (module->is_cyclic || module->is_dependent || ast_shared_count != 0) {
+                    return NULL;
+                }
+                module_list_remove(i);
+                free(module);
+                break;
+
+            case SE_MODULE_READY:
+                /* the contents are only hashed again when the file status has changed */
+                if (module->file_size == info.st_size && module->file_mtime == module_file_mtime(&info)) {
+                    return module;
+                }
+                if (!module_hash_file(filename, &hash)) {
+                    return NULL;
+                }
+                is_hashed = true;
+                if (module->hash == hash) {
+                    module->file_size = info.st_size;
+                    module->file_mtime = module_file_mtime(&info);
+                    return module;
+                }
+
+                /* the file has changed, contexts linked to the old module keep it */
+                log_debug(LOG_IMPORT, "module %s has changed, reloading", filename);
+                module_list_remove(i);
+                break;
+
+            otherwise_error
+        }
+        break;
+    }
+
+    if (!is_hashed && !module_hash_file(filename, &hash)) {
+        return NULL;
+    }
+
+    se_module* module = checked_malloc(sizeof(se_module));
+    module->filename = filename;
+    module->directory = directory;
+    module->hash = hash;
+    module->file_size = info.st_size;
+    module->file_mtime = module_file_mtime(&info);
+    module->state = SE_MODULE_LOADING;
+    module->is_cyclic = false;
+    module->is_dependent = false;
+    module->context = NULL;
+    arl_add(se_module_ptr, module_list, module);
+
+    module_load(context, module);
+    return module->state == SE_MODULE_READY ? module : NULL;
+}
+
+/**
+ * Links the declarations of a cached module
+ * and all of its imports into a parser context
+ *
+ * @param context Pointer to the parser context
+ * @param module  Pointer to the module
+ */
+void module_link(se_context* context, se_module* module) {
+    log_debug(LOG_IMPORT, "linking module %s", module->filename);
+    se_context* source = module->context;
+
+    /* non-native declarations and native includes in declaration order */
+    iterate_array(i, source->ast.declaration_list.size) {
+        declaration* dc = source->ast.declaration_list.data[i];
+        if (dc->kind == DC_IMPORT) {
+            char* header = intern_string(import_to_filename(dc->u_import));
+            if (module_find_file(context, header, true) == NULL) {
+                arl_add(declaration_ptr, context->ast.declaration_list, dc);
+            }
+        } else {
+            ast_link_declaration(&context->ast, dc);
+        }
+    }
+
+    /* native declarations are only present in the lookup table */
+    iterate_array(i, source->ast.symbol_table.capacity) {
+        ast_symbol* symbol = &source->ast.symbol_table.data[i];
+        if (symbol->key != NULL && symbol->value->is_native) {
+            ast_link_declaration(&context->ast, symbol->value);
+        }
+    }
+
+    /* files imported by the module must not be parsed again */
+    iterate_array(i, source->file_list.size) {
+        se_context_import_file* file = source->file_list.data[i];
+        if (module_find_file(context, file->filename, file->is_native) == NULL) {
+            se_context_import_file* current = allocate(se_context_import_file);
+            current->filename = file->filename;
+            current->is_native = file->is_native;
+            current->is_linked = true;
+            current->tokens = NULL;
+            current->native_unit = file->native_unit;
+            current->native_batch = NULL;
+            current->last = context->pass;
+            arl_add(se_context_import_file_ptr, context->file_list, current);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+/**
+ * @file batch.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Batched preprocessing of native headers implementation
+ */
+    /* includes */
+#include "language/native/batch.h" /* this */
+
+#include <stdlib.h>
+#include <string.h> /* string functions */
+
+#include "language/native/cache.h" /* preprocessor */
+#include "language/native/macro.h" /* macro definitions */
+#include "misc/memory.h" /* memory allocation */
+
+    /* global variables */
+/**
+ * Enables batched preprocessing, set by --native-batch
+ */
+bool native_batch_mode = false;
+
+    /* internal functions */
+/**
+ * Parses a line marker of <stdin>
+ *
+ * @param[in] line The line
+ *
+ * @return Line number of the marker, or 0 if the line
+ *          is not a line marker of <stdin>
+ */
+static size_t native_batch_marker(char* line) {
+    if (line[0] != '#' || line[1] != ' ') {
+        return 0;
+    }
+    char* end;
+    unsigned long number = strtoul(line + 2, &end, 10);
+    if (end == line + 2 || strncmp(end, " \"<stdin>\"", strlen(" \"<stdin>\"")) != 0) {
+        return 0;
+    }
+    return number;
+}
+
+    /* functions */
+/**
+ * Preprocesses a list of headers at once
+ *
+ * @param[in] headers The interned header names, without duplicates
+ * @param[in] count   Number of headers
+ * @param[in] unit    The interned unit name
+ *
+ * @return The batch allocated by malloc, or NULL
+ *          if the preprocessor has failed
+ */
+native_batch* native_batch_new(char** headers, size_t count, char* unit) {
+    /* the macro definitions are kept in place for native_macro_import_batch */
+    source_buffer source;
+    if (!native_preprocess(headers, count, "-dD", "batch", &source)) {
+        log_debug(LOG_NATIVE, "batch preprocessing for %s failed", unit);
+        return NULL;
+    }
+    char* output = source.data;
+
+    native_batch* batch = checked_malloc(sizeof(native_batch));
+    batch->unit = unit;
+    batch->output = output;
+    batch->size = source.size;
+    batch->macros = NULL;
+    batch->count = count;
+    batch->regions = checked_malloc(sizeof(native_batch_region) * count);
+    for (size_t i = 0; i < count; i++) {
+        batch->regions[i].header = headers[i];
+        batch->regions[i].start = NULL;
+        batch->regions[i].size = 0;
+        batch->regions[i].is_parsed = false;
+    }
+
+    /* every region spans from its first marker to the next marker of another line */
+    native_batch_region* current = NULL;
+    char* line = output;
+    while (*line != '\0') {
+        char* next = strchr(line, '\n');
+        next = next != NULL ? next + 1 : line + strlen(line);
+
+        size_t number = native_batch_marker(line);
+        if (number != 0) {
+            native_batch_region* region = number <= count ? &batch->regions[number - 1] : NULL;
+            if (region != current) {
+                if (current != NULL) {
+                    current->size = line - current->start;
+                }
+                if (region != NULL && region->start == NULL) {
+                    region->start = next;
+                }
+                current = region != NULL && region->size == 0 ? region : NULL;
+            }
+        }
+        line = next;
+    }
+    if (current != NULL) {
+        current->size = line - current->start;
+    }
+
+    log_debug(LOG_NATIVE, "preprocessed %zu headers for %s at once", count, unit);
+    return batch;
+}
+
+/**
+ * Finds the region of a header which may be parsed now,
+ * that is only after the regions of all previous headers
+ *
+ * @param[in] batch  The batch
+ * @param[in] header The interned header name
+ *
+ * @return The region, or NULL if the header has to be preprocessed alone
+ */
+native_batch_region* native_batch_find(native_batch* batch, char* header) {
+    for (size_t i = 0; i < batch->count; i++) {
+        native_batch_region* region = &batch->regions[i];
+        if (region->header == header) {
+            return region->is_parsed ? NULL : region;
+        }
+
+        /* a skipped region might contain the declarations used by the next ones */
+        if (!region->is_parsed) {
+            return NULL;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Copies a region into a source buffer for scanning
+ *
+ * @param[in]  region The region
+ * @param[out] source The source buffer
+ */
+void native_batch_region_open(native_batch_region* region, source_buffer* source) {
+    source->data = checked_malloc(region->size + SOURCE_BUFFER_SENTINEL);
+    if (region->size != 0) {
+        memcpy(source->data, region->start, region->size);
+    }
+    memset(source->data + region->size, 0, SOURCE_BUFFER_SENTINEL);
+    source->size = region->size;
+    source->mapped_size = 0;
+}
+
+/**
+ * Releases a batch
+ *
+ * @param[in] batch The batch
+ */
+void native_batch_free(native_batch* batch) {
+    if (batch->macros != NULL) {
+        native_macro_table_free(batch->macros);
+    }
+    free(batch->output);
+    free(batch->regions);
+    free(batch);
+}
\ No newline at end of file
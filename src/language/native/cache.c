@@ -0,0 +1,681 @@
+/**
+ * @file cache.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Persistent cache of preprocessed native headers implementation
+ */
+    /* includes */
+#include "language/native/cache.h" /* this */
+
+#include <stdlib.h>
+#include <stdbool.h> /* boolean */
+#include <stdio.h> /* file functions */
+#include <string.h> /* string functions */
+#include <errno.h> /* error codes */
+#include <limits.h> /* path length */
+#include <unistd.h> /* process functions */
+#include <fcntl.h> /* file control */
+#include <sys/types.h>
+#include <sys/stat.h> /* file status */
+#include <sys/wait.h> /* process status */
+
+#include "misc/memory.h" /* memory allocation */
+#include "misc/hash.h" /* key hash */
+#include "misc/cache.h" /* cache directory */
+#include "misc/timer.h" /* monotonic clock */
+#include "misc/trace.h" /* trace output */
+
+    /* typedefs */
+/**
+ * Paths of a cache entry and its temporary files
+ */
+typedef struct native_cache_entry {
+    char* header;
+    bool is_macros; /* the entry has the macro definitions (-dM) instead of the text */
+    pid_t pid; /* the running preprocessor or -1 */
+    uint64_t start; /* start time of the preprocessor */
+    char text[PATH_MAX];
+    char manifest[PATH_MAX];
+    char text_tmp[PATH_MAX];
+    char manifest_tmp[PATH_MAX];
+    char dependencies_tmp[PATH_MAX];
+} native_cache_entry;
+
+    /* global variables */
+/**
+ * The cache directory, empty if the cache is disabled
+ * or NULL if it has not been determined yet
+ */
+static char* native_cache_directory = NULL;
+
+    /* internal functions */
+/**
+ * Determines the cache directory
+ *
+ * @return The cache directory, or NULL if the cache is disabled
+ */
+static char* native_cache_get_directory() {
+    if (native_cache_directory == NULL) {
+        native_cache_directory = cache_directory("native");
+        if (native_cache_directory == NULL) {
+            native_cache_directory = "";
+        }
+    }
+    return *native_cache_directory != '\0' ? native_cache_directory : NULL;
+}
+
+/**
+ * Identifies the preprocessor executable found in $PATH
+ * by its resolved path, inode, size and modification time,
+ * so that an upgraded compiler with other builtin macros
+ * and system headers does not reuse the entries
+ *
+ * @return The identity, empty if the executable is not found
+ */
+static char* native_cache_identity() {
+    static char identity[PATH_MAX + 128];
+    static bool is_ready = false;
+    if (is_ready) {
+        return identity;
+    }
+    is_ready = true;
+    identity[0] = '\0';
+
+    char* path = getenv("PATH");
+    while (path != NULL && *path != '\0') {
+        char* separator = strchr(path, ':');
+        size_t length = separator != NULL ? (size_t) (separator - path) : strlen(path);
+        char candidate[PATH_MAX], resolved[PATH_MAX];
+        struct stat info;
+        if (snprintf(candidate, sizeof(candidate), "%.*s/%s", (int) length, path, NATIVE_PREPROCESSOR) < (int) sizeof(candidate)
+                && access(candidate, X_OK) == 0 && realpath(candidate, resolved) != NULL
+                && stat(resolved, &info) == 0) {
+            snprintf(identity, sizeof(identity), "%s %llu %lld %lld.%09ld", resolved,
+                (unsigned long long) info.st_ino, (long long) info.st_size,
+                (long long) info.st_mtim.tv_sec, info.st_mtim.tv_nsec);
+            break;
+        }
+        path = separator != NULL ? separator + 1 : NULL;
+    }
+    return identity;
+}
+
+/**
+ * Computes the cache key of a header
+ *
+ * @param[in] header    The header name
+ * @param[in] is_macros Whether the key is for the macro definitions
+ *
+ * @return The cache key
+ */
+static uint64_t native_cache_key(char* header, bool is_macros) {
+    char* cpath = getenv("CPATH");
+    char* c_include_path = getenv("C_INCLUDE_PATH");
+    char* options = is_macros ? "-E -dM -" : "-E -";
+
+    char* identity = native_cache_identity();
+
+    int length = snprintf(NULL, 0, "%d\n%s %s\n%s\n%s\n%s\n%s\n", NATIVE_CACHE_VERSION,
+        NATIVE_PREPROCESSOR, options, identity, header, cpath ? cpath : "", c_include_path ? c_include_path : "");
+    char* key = checked_malloc(length + 1);
+    snprintf(key, length + 1, "%d\n%s %s\n%s\n%s\n%s\n%s\n", NATIVE_CACHE_VERSION,
+        NATIVE_PREPROCESSOR, options, identity, header, cpath ? cpath : "", c_include_path ? c_include_path : "");
+
+    uint64_t hash = hash_bytes(key, length);
+    free(key);
+    return hash;
+}
+
+/**
+ * Reads a whole file into a null-terminated buffer
+ *
+ * @param[in] filename Name of the file
+ *
+ * @return The buffer allocated by malloc, or NULL
+ */
+static char* native_cache_read(char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    size_t size = 0, capacity = 4096;
+    char* data = checked_malloc(capacity);
+    size_t count;
+    while ((count = fread(data + size, 1, capacity - size - 1, file)) != 0) {
+        size += count;
+        if (capacity - size == 1) {
+            capacity *= 2;
+            data = checked_realloc(data, capacity);
+        }
+    }
+    data[size] = '\0';
+
+    fclose(file);
+    return data;
+}
+
+/**
+ * Checks that every file listed in a manifest
+ * has not changed since the entry has been created
+ *
+ * @param[in] manifest Path to the manifest
+ * @param[in] header   The header name
+ *
+ * @return true if the entry is valid
+ */
+static bool native_cache_validate(char* manifest, char* header) {
+    FILE* file = fopen(manifest, "r");
+    if (file == NULL) {
+        return false;
+    }
+
+    char line[PATH_MAX + 128];
+    char expected[PATH_MAX + 128];
+    snprintf(expected, sizeof(expected), "carbonsteel native cache %d %s\n", NATIVE_CACHE_VERSION, header);
+    bool result = fgets(line, sizeof(line), file) != NULL && strcmp(line, expected) == 0;
+
+    while (result && fgets(line, sizeof(line), file) != NULL) {
+        long long seconds, nanoseconds, size;
+        int offset;
+        if (sscanf(line, "%lld %lld %lld %n", &seconds, &nanoseconds, &size, &offset) != 3) {
+            result = false;
+            break;
+        }
+        line[strcspn(line, "\n")] = '\0';
+
+        struct stat status;
+        if (stat(line + offset, &status) != 0
+                || status.st_mtim.tv_sec != seconds
+                || status.st_mtim.tv_nsec != nanoseconds
+                || status.st_size != size) {
+            log_debug(LOG_NATIVE, "native cache entry for %s is stale because of %s", header, line + offset);
+            result = false;
+        }
+    }
+
+    fclose(file);
+    return result;
+}
+
+/**
+ * Converts the make-style dependency list written
+ * by the preprocessor into a manifest
+ *
+ * @param[in] dependencies Path to the dependency list
+ * @param[in] manifest     Path to the manifest
+ * @param[in] header       The header name
+ *
+ * @return false if the manifest could not be written
+ */
+static bool native_cache_write_manifest(char* dependencies, char* manifest, char* header) {
+    char* data = native_cache_read(dependencies);
+    if (data == NULL) {
+        return false;
+    }
+    FILE* file = fopen(manifest, "w");
+    if (file == NULL) {
+        free(data);
+        return false;
+    }
+    fprintf(file, "carbonsteel native cache %d %s\n", NATIVE_CACHE_VERSION, header);
+
+    /* skip the target */
+    char* p = strchr(data, ':');
+    bool result = p != NULL;
+    if (result) {
+        p++;
+    }
+
+    /* dependencies are separated by whitespace and escaped line breaks */
+    char path[PATH_MAX];
+    while (result && *p != '\0') {
+        if (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'
+                || (*p == '\\' && (p[1] == '\n' || p[1] == '\r'))) {
+            p++;
+            continue;
+        }
+
+        size_t length = 0;
+        while (*p != '\0' && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') {
+            if (*p == '\\' && p[1] == ' ') {
+                p++;
+            }
+            if (length == sizeof(path) - 1) {
+                result = false;
+                break;
+            }
+            path[length++] = *p++;
+        }
+        path[length] = '\0';
+
+        struct stat status;
+        if (!result || stat(path, &status) != 0) {
+            result = false;
+            break;
+        }
+        fprintf(file, "%lld %lld %lld %s\n", (long long) status.st_mtim.tv_sec,
+            (long long) status.st_mtim.tv_nsec, (long long) status.st_size, path);
+    }
+
+    if (fclose(file) != 0) {
+        result = false;
+    }
+    free(data);
+    return result;
+}
+
+/**
+ * Computes the paths of the cache entry of a header
+ *
+ * @param[out] entry     Pointer to the entry
+ * @param[in]  header    The header name
+ * @param[in]  is_macros Whether the entry is for the macro definitions
+ *
+ * @return false if the cache is disabled or the paths are too long
+ */
+static bool native_cache_entry_init(native_cache_entry* entry, char* header, bool is_macros) {
+    char* directory = native_cache_get_directory();
+    if (directory == NULL) {
+        return false;
+    }
+
+    char base[PATH_MAX];
+    int pid = (int) getpid();
+    if (snprintf(base, sizeof(base), "%s/%016llx", directory,
+            (unsigned long long) native_cache_key(header, is_macros)) >= (int) sizeof(base) - 32) {
+        return false;
+    }
+    char* extension = is_macros ? "dM" : "i";
+    entry->header = header;
+    entry->is_macros = is_macros;
+    entry->pid = -1;
+    snprintf(entry->text, sizeof(entry->text), "%s.%s", base, extension);
+    snprintf(entry->manifest, sizeof(entry->manifest), "%s.manifest", base);
+    snprintf(entry->text_tmp, sizeof(entry->text_tmp), "%s.%d.%s.tmp", base, pid, extension);
+    snprintf(entry->manifest_tmp, sizeof(entry->manifest_tmp), "%s.%d.manifest.tmp", base, pid);
+    snprintf(entry->dependencies_tmp, sizeof(entry->dependencies_tmp), "%s.%d.d.tmp", base, pid);
+    return true;
+}
+
+/**
+ * Starts the preprocessor on a header, which writes
+ * the preprocessed text or the macro definitions and
+ * the dependency list into the temporary files of the entry
+ *
+ * @param[in] entry Pointer to the entry
+ *
+ * @return The preprocessor process id, or -1
+ */
+static pid_t native_cache_start(native_cache_entry* entry) {
+    int pd_in[2];
+    if (pipe(pd_in) != 0) {
+        return -1;
+    }
+
+    entry->start = trace_mode ? timer_now() : 0;
+    pid_t child = fork();
+    if (child < 0) {
+        close(pd_in[0]);
+        close(pd_in[1]);
+        return -1;
+    }
+    if (child == 0) {
+        close(pd_in[1]);
+        dup2(pd_in[0], 0);
+
+        /* errors are reported by the uncached preprocessor run */
+        int null = open("/dev/null", O_WRONLY);
+        if (null >= 0) {
+            dup2(null, 2);
+        }
+        if (entry->is_macros) {
+            execlp(NATIVE_PREPROCESSOR, NATIVE_PREPROCESSOR, "-E", "-dM", "-MD", "-MF", entry->dependencies_tmp,
+                "-MT", "native", "-o", entry->text_tmp, "-", NULL);
+        } else {
+            execlp(NATIVE_PREPROCESSOR, NATIVE_PREPROCESSOR, "-E", "-MD", "-MF", entry->dependencies_tmp,
+                "-MT", "native", "-o", entry->text_tmp, "-", NULL);
+        }
+        _exit(127);
+    }
+    close(pd_in[0]);
+
+    /* write the preprocessor input */
+    dprintf(pd_in[1], "#include <%s>\n", entry->header);
+    close(pd_in[1]);
+    return child;
+}
+
+/**
+ * Moves the output of a finished preprocessor into the entry,
+ * the entry is replaced atomically so that parallel compilers
+ * never see a partial one
+ *
+ * @param[in] entry  Pointer to the entry
+ * @param[in] status Exit status of the preprocessor
+ *
+ * @return false if the preprocessor has failed
+ */
+static bool native_cache_finish(native_cache_entry* entry, int status) {
+    bool result = WIFEXITED(status) && WEXITSTATUS(status) == 0
+        && native_cache_write_manifest(entry->dependencies_tmp, entry->manifest_tmp, entry->header)
+        && rename(entry->text_tmp, entry->text) == 0
+        && rename(entry->manifest_tmp, entry->manifest) == 0;
+
+    unlink(entry->dependencies_tmp);
+    if (!result) {
+        unlink(entry->text_tmp);
+        unlink(entry->manifest_tmp);
+    }
+    return result;
+}
+
+/**
+ * Maps a cache entry of a native header,
+ * running the preprocessor only if it is not valid
+ *
+ * @param[in]  header    The header name
+ * @param[in]  is_macros Whether to open the macro definitions
+ * @param[out] source    The entry contents
+ *
+ * @return false if the cache is disabled
+ *          or the header could not be cached
+ */
+static bool native_cache_open_entry(char* header, bool is_macros, source_buffer* source) {
+    native_cache_entry entry;
+    if (!native_cache_entry_init(&entry, header, is_macros)) {
+        return false;
+    }
+
+    /* cache hit */
+    if (native_cache_validate(entry.manifest, header) && source_buffer_open(source, entry.text)) {
+        log_debug(LOG_NATIVE, "native cache hit for %s%s", header, is_macros ? " macros" : "");
+        return true;
+    }
+
+    /* cache miss */
+    log_debug(LOG_NATIVE, "native cache miss for %s%s", header, is_macros ? " macros" : "");
+    entry.pid = native_cache_start(&entry);
+    if (entry.pid < 0) {
+        return false;
+    }
+    int status;
+    while (waitpid(entry.pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+    trace_process("preprocessor", header, entry.start, entry.pid);
+    return native_cache_finish(&entry, status) && source_buffer_open(source, entry.text);
+}
+
+/**
+ * Collects a preprocessor started by native_cache_prefetch,
+ * only the process of the entry is waited for, so children
+ * started elsewhere in the compiler are never reaped here
+ *
+ * @param[in] entry   Pointer to the entry
+ * @param[in] options Options of waitpid, WNOHANG or 0
+ *
+ * @return false if the preprocessor is still running
+ */
+static bool native_cache_collect(native_cache_entry* entry, int options) {
+    int status;
+    pid_t result;
+    while ((result = waitpid(entry->pid, &status, options)) < 0 && errno == EINTR) {
+        continue;
+    }
+    if (result == 0) {
+        return false;
+    }
+
+    if (result == entry->pid) {
+        trace_process("preprocessor", entry->header, entry->start, entry->pid);
+        native_cache_finish(entry, status);
+    } else {
+        /* the process is lost, the header is preprocessed again when imported */
+        unlink(entry->dependencies_tmp);
+        unlink(entry->text_tmp);
+        unlink(entry->manifest_tmp);
+    }
+    entry->pid = -1;
+    return true;
+}
+
+    /* functions */
+/**
+ * Determines the path of the declaration snapshot of a native
+ * header, which is kept next to its preprocessed text and is
+ * only valid together with the dependency manifest of the text
+ *
+ * @param[in]  header The header name, as in #include <header>
+ * @param[out] path   The path buffer of PATH_MAX characters
+ * @param[out] hash   Hash of the dependency manifest
+ *
+ * @return false if the cache is disabled or the
+ *          preprocessed text has no valid entry
+ */
+bool native_cache_snapshot(char* header, char* path, uint64_t* hash) {
+    native_cache_entry entry;
+    if (!native_cache_entry_init(&entry, header, false) || !native_cache_validate(entry.manifest, header)) {
+        return false;
+    }
+    char* manifest = native_cache_read(entry.manifest);
+    if (manifest == NULL) {
+        return false;
+    }
+    *hash = hash_string(manifest);
+    free(manifest);
+
+    size_t length = strlen(entry.text) - strlen("i");
+    if (length + strlen("csts") >= PATH_MAX) {
+        return false;
+    }
+    memcpy(path, entry.text, length);
+    strcpy(path + length, "csts");
+    return true;
+}
+
+/**
+ * Maps the preprocessed text of a native header,
+ * running the preprocessor only if there is no
+ * valid cache entry for it
+ *
+ * @param[in]  header The header name, as in #include <header>
+ * @param[out] source The preprocessed text
+ *
+ * @return false if the cache is disabled
+ *          or the header could not be cached
+ */
+bool native_cache_open(char* header, source_buffer* source) {
+    return native_cache_open_entry(header, false, source);
+}
+
+/**
+ * Maps the macro definitions of a native header,
+ * as printed by the preprocessor with -dM
+ *
+ * @param[in]  header The header name, as in #include <header>
+ * @param[out] source The macro definitions
+ *
+ * @return false if the cache is disabled
+ *          or the header could not be cached
+ */
+bool native_cache_open_macros(char* header, source_buffer* source) {
+    return native_cache_open_entry(header, true, source);
+}
+
+/**
+ * Runs the preprocessor concurrently on every header
+ * without valid cache entries, so that native_cache_open
+ * and native_cache_open_macros find the entries
+ * when the headers are imported
+ *
+ * @param[in] headers The header names
+ * @param[in] count   Number of headers
+ */
+void native_cache_prefetch(char** headers, size_t count) {
+    if (count == 0 || native_cache_get_directory() == NULL) {
+        return;
+    }
+
+    /* one preprocessor per processor */
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t jobs = processors < 1 ? 1 : (size_t) processors;
+    if (jobs > NATIVE_PREFETCH_MAX_JOBS) {
+        jobs = NATIVE_PREFETCH_MAX_JOBS;
+    }
+
+    /* the text and the macro definitions of each header */
+    size_t total = count * 2;
+    native_cache_entry* entries = checked_malloc(sizeof(native_cache_entry) * total);
+    size_t next = 0, running = 0;
+    while (next < total || running > 0) {
+        /* start the next job */
+        if (next < total && running < jobs) {
+            native_cache_entry* entry = &entries[next];
+            bool is_macros = next % 2 != 0;
+            char* header = headers[next++ / 2];
+
+            bool is_duplicate = false;
+            for (size_t i = is_macros; i + 1 < next; i += 2) {
+                if (strcmp(headers[i / 2], header) == 0) {
+                    is_duplicate = true;
+                }
+            }
+            if (is_duplicate || !native_cache_entry_init(entry, header, is_macros)) {
+                entry->pid = -1;
+                continue;
+            }
+            if (native_cache_validate(entry->manifest, header)) {
+                entry->pid = -1;
+                continue;
+            }
+
+            log_debug(LOG_NATIVE, "native cache prefetch for %s", header);
+            entry->pid = native_cache_start(entry);
+            if (entry->pid > 0) {
+                running++;
+            }
+            continue;
+        }
+
+        /* collect a finished job, or wait for the oldest one */
+        size_t oldest = next;
+        bool is_collected = false;
+        for (size_t i = 0; i < next && !is_collected; i++) {
+            if (entries[i].pid > 0) {
+                if (oldest == next) {
+                    oldest = i;
+                }
+                is_collected = native_cache_collect(&entries[i], WNOHANG);
+            }
+        }
+        if (!is_collected) {
+            native_cache_collect(&entries[oldest], 0);
+        }
+        running--;
+    }
+
+    free(entries);
+}
+
+/**
+ * Runs the preprocessor on an include list without
+ * the cache and reads the whole output, header i
+ * is included on line i + 1 of <stdin>
+ *
+ * @param[in]  headers The header names
+ * @param[in]  count   Number of headers
+ * @param[in]  option  An extra preprocessor option such as -dM, or NULL
+ * @param[in]  name    Name of the run in the trace output
+ * @param[out] source  The preprocessor output
+ *
+ * @return false if the preprocessor has failed
+ */
+bool native_preprocess(char** headers, size_t count, char* option, char* name, source_buffer* source) {
+    int pd_in[2];
+    int pd_out[2];
+    if (pipe(pd_in) != 0) {
+        return false;
+    }
+    if (pipe(pd_out) != 0) {
+        close(pd_in[0]);
+        close(pd_in[1]);
+        return false;
+    }
+
+    uint64_t start = trace_mode ? timer_now() : 0;
+    pid_t child = fork();
+    if (child < 0) {
+        close(pd_in[0]);
+        close(pd_in[1]);
+        close(pd_out[0]);
+        close(pd_out[1]);
+        return false;
+    }
+    if (child == 0) {
+        close(pd_in[1]);
+        dup2(pd_in[0], 0);
+        close(pd_out[0]);
+        dup2(pd_out[1], 1);
+        if (option != NULL) {
+            execlp(NATIVE_PREPROCESSOR, NATIVE_PREPROCESSOR, "-E", option, "-", NULL);
+        } else {
+            execlp(NATIVE_PREPROCESSOR, NATIVE_PREPROCESSOR, "-E", "-", NULL);
+        }
+        _exit(127);
+    }
+    close(pd_in[0]);
+    close(pd_out[1]);
+
+    /* write the include list */
+    FILE* input = fdopen(pd_in[1], "w");
+    if (input != NULL) {
+        for (size_t i = 0; i < count; i++) {
+            fprintf(input, "#include <%s>\n", headers[i]);
+        }
+        fclose(input);
+    } else {
+        close(pd_in[1]);
+    }
+
+    /* read the output */
+    size_t capacity = 65536;
+    source->data = checked_malloc(capacity);
+    source->size = 0;
+    source->mapped_size = 0;
+    while (true) {
+        if (capacity - source->size <= SOURCE_BUFFER_SENTINEL) {
+            capacity *= 2;
+            source->data = checked_realloc(source->data, capacity);
+        }
+        ssize_t length = read(pd_out[0], source->data + source->size,
+            capacity - source->size - SOURCE_BUFFER_SENTINEL);
+        if (length < 0 && errno == EINTR) {
+            continue;
+        }
+        if (length <= 0) {
+            break;
+        }
+        source->size += length;
+    }
+    memset(source->data + source->size, 0, SOURCE_BUFFER_SENTINEL);
+    close(pd_out[0]);
+
+    int status;
+    while (waitpid(child, &status, 0) < 0) {
+        if (errno != EINTR) {
+            source_buffer_close(source);
+            return false;
+        }
+    }
+    trace_process("preprocessor", name, start, child);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        source_buffer_close(source);
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
@@ -23,11 +23,12 @@
  * 
  * @param context The parser context
  * @param in The C-native declaration specifiers
+ * @param native_unit The native unit which contains the declaration
  * @param declarations The arraylist to append any inner declarations into
  * 
  * @return The type
  */
-ast_type cst_native_declspecs_translate(se_context* context, c_declaration_specifiers in, arraylist(declaration)* declarations) {
+ast_type cst_native_declspecs_translate(se_context* context, c_declaration_specifiers in, char* native_unit, arraylist(declaration)* declarations) {
     // ignore: storage class specifiers
     // ignore: function specifiers
     // ignore: type qualifiers
@@ -59,23 +60,23 @@ ast_type cst_native_declspecs_translate(se_context* context, c_declaration_speci
 
             case C_TS_TYPE:
                 ast_type* current = &in.type_specs.data[i].u_type;
-                logd("walk: <%s>", ast_type_display_name(current));
+                log_debug(LOG_NATIVE, "walk: <%s>", ast_type_display_name(current));
 
                 /* handle types like "long int" and "long long int", etc */
                 if (has_been_set) {
-                    logd("complex type! processing...");
+                    log_debug(LOG_NATIVE, "complex type! processing...");
 
                     if (ast_type_is_pp(current)) {
                         index_t index = ast_type_primitive_get_index(current->u_primitive);
                         switch (index) {
                             case PRIMITIVE_INDEX_INT:
                             case PRIMITIVE_INDEX_LONG:
-                                logd("discarding an <int/long> flag");
+                                log_debug(LOG_NATIVE, "discarding an <int/long> flag");
                                 current = NULL;
                                 break;
 
                             case PRIMITIVE_INDEX_DOUBLE:
-                                logd("overriding the type with a <double>");
+                                log_debug(LOG_NATIVE, "overriding the type with a <double>");
                                 logw("long doubles are not supported yet, resolving as double");
                                 break;
 
@@ -110,13 +111,15 @@ ast_type cst_native_declspecs_translate(se_context* context, c_declaration_speci
                     case AST_TYPE_STRUCTURE:
                         dc_structure* st = type.u_structure;
                         if (st->name != NULL) {
+                            /* a typedef of the same name does not hide the structure */
                             declaration* dc_ex = ast_declaration_lookup(&context->ast, st->name);
-                            if (dc_ex != NULL) {
-                                logd("[native-ignore] struct %s", st->name);
+                            if (dc_ex != NULL && dc_ex->kind == DC_STRUCTURE) {
+                                log_debug(LOG_NATIVE, "[native-ignore] struct %s", st->name);
+                                ast_add_native_filename(dc_ex, native_unit);
                             } else {
                                 st->name = cst_native_struct_name(st->name);
                                 dc.name = st->name;
-                                logd("[native] struct %s", dc.name);
+                                log_debug(LOG_NATIVE, "[native] struct %s", dc.name);
                                 dc.is_full = st->is_full;
                                 dc.kind = DC_STRUCTURE;
                                 dc.token = TOKEN_STRUCTURE_NAME;
@@ -130,12 +133,13 @@ ast_type cst_native_declspecs_translate(se_context* context, c_declaration_speci
                         dc_enum* en = type.u_enum;
                         if (en->name != NULL) {
                             declaration* dc_ex = ast_declaration_lookup(&context->ast, en->name);
-                            if (dc_ex != NULL) {
-                                logd("[native-ignore] enum %s", en->name);
+                            if (dc_ex != NULL && dc_ex->kind == DC_ENUM) {
+                                log_debug(LOG_NATIVE, "[native-ignore] enum %s", en->name);
+                                ast_add_native_filename(dc_ex, native_unit);
                             } else {
                                 en->name = cst_native_enum_name(en->name);
                                 dc.name = en->name;
-                                logd("[native] enum %s", dc.name);
+                                log_debug(LOG_NATIVE, "[native] enum %s", dc.name);
                                 dc.is_full = en->is_full;
                                 dc.kind = DC_ENUM;
                                 dc.token = TOKEN_ENUM_NAME;
@@ -166,30 +170,155 @@ ast_type cst_native_declspecs_translate(se_context* context, c_declaration_speci
     return type;
 }
 
+/**
+ * Translates C-native function parameters
+ * 
+ * @param context The parser context
+ * @param in The C-native function parameters
+ * @param native_unit The native unit which contains the declaration
+ * 
+ * @return Carbonsteel function parameters
+ */
+static dc_function_parameters cst_native_parameters_translate(se_context* context, c_function_parameters in, char* native_unit) {
+    arraylist(dc_function_parameter) parameters;
+    arl_init(dc_function_parameter, parameters);
+    for (int i = 0; i < in.value.size; i++) {
+        arl_add(dc_function_parameter, parameters, cst_native_declaration_to_function_parameter(context, in.value.data[i], native_unit));
+    }
+
+    dc_function_parameters result;
+    li_init_from(dc_function_parameter, result.value, parameters);
+    result.is_c_vararg = in.is_c_vararg;
+    return result;
+}
+
+/**
+ * Translates a single C-native declarator into
+ * a Carbonsteel declaration
+ * 
+ * @param context The parser context
+ * @param raw_type The translated declaration specifiers
+ * @param this The C-native declarator
+ * @param is_typedef Whether the declaration is a typedef
+ * @param native_unit The native unit which contains the declaration
+ * 
+ * @return The declaration
+ */
+static declaration cst_native_declarator_translate(se_context* context, ast_type raw_type, c_declarator this, bool is_typedef, char* native_unit) {
+    /* create an alias for the type */
+    dc_alias* al = allocate(dc_alias);
+    al->is_full = true;
+    al->name = this.name;
+    ast_type_clone_to(&al->target, raw_type);
+
+    /* append the levels set in the declarator */
+    for (int j = 0; j < this.level_list.size; j++) {
+        arraylist_add(ast_type_level)(&al->target.level_list, this.level_list.data[j]);
+    }
+
+    /* path char* as char[] */
+    if (ast_type_is_single_pointer(&al->target)
+        && al->target.kind == AST_TYPE_PRIMITIVE
+        && ast_type_primitive_get_index(al->target.u_primitive) == PRIMITIVE_INDEX_CHAR) {
+            log_debug(LOG_NATIVE, "patching char* as char[]");
+            al->target.level_list.data[0].kind = AT_LEVEL_ARRAY;
+            al->target.level_list.data[0].u_array_size = 0;
+        }
+
+    declaration dc;
+    dc.native_pending = NULL;
+    if (this.is_function) {
+        if (is_typedef) {
+            /* wrap it into another alias */
+            al = allocate(dc_alias);
+            al->is_full = true;
+            al->name = this.name;
+            ast_type_init(&al->target, AST_TYPE_PRIMITIVE, &primitive_list.data[PRIMITIVE_INDEX_VOID]);
+            ast_type_pointer_wrap(&al->target);
+            logw("function types are not supported yet!");
+
+            /* and wrap it into a declaration */
+            dc.is_full = true;
+            dc.is_native = true;
+            dc.name = al->name;
+            dc.kind = DC_ALIAS;
+            dc.token = TOKEN_ALIAS_NAME;
+            dc.ctoken = CTOKEN_ALIAS_NAME;
+            dc.u_alias = al;
+
+            log_debug(LOG_NATIVE, "[native] <%s(...)>", this.name);
+        } else {
+            /* wrap it into a function */
+            dc_function* fn = allocate(dc_function);
+            fn->is_extern = true;
+            fn->is_full = true;
+            fn->name = this.name;
+            fn->parameters = cst_native_parameters_translate(context, this.u_parameters, native_unit);
+            fn->return_type = al->target;
+
+            /* and wrap it into a declaration straightaway*/
+            dc.is_full = true;
+            dc.is_native = true;
+            dc.name = fn->name;
+            dc.kind = DC_FUNCTION;
+            dc.token = TOKEN_FUNCTION_NAME;
+            dc.ctoken = CTOKEN_FUNCTION_NAME;
+            dc.u_function = fn;
+
+            log_debug(LOG_NATIVE, "[native] %s %s(...)", ast_type_display_name(&fn->return_type), this.name);
+        }
+    } else {
+        /* wrap it into a declaration */
+        dc.is_full = true;
+        dc.is_native = true;
+        dc.name = al->name;
+        dc.kind = DC_ALIAS;
+        dc.token = TOKEN_ALIAS_NAME;
+        dc.ctoken = CTOKEN_ALIAS_NAME;
+        dc.u_alias = al;
+        
+        log_debug(LOG_NATIVE, "[native] %s = <%s>", this.name, ast_type_display_name(&al->target));
+    }
+
+    return dc;
+}
+
+/**
+ * Checks whether a C-native declaration is a typedef
+ * 
+ * @param in The C-native declaration
+ * 
+ * @return true if one of the storage specifiers is typedef
+ */
+static bool cst_native_declaration_is_typedef(c_declaration in) {
+    for (int i = 0; i < in.specs.storage_specs.size; i++) {
+        if (in.specs.storage_specs.data[i] == C_SCLS_TYPEDEF) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * Translates a C-native declaration into a list of
  * Carbonsteel declarations
  * 
  * @param context The parser context
  * @param in The C-native declaration
+ * @param native_unit The native unit which contains the declaration
  * 
  * @return A list of processed declarations 
  */
-arraylist(declaration) cst_native_declaration_translate(se_context* context, c_declaration in) {
+arraylist(declaration) cst_native_declaration_translate(se_context* context, c_declaration in, char* native_unit) {
     arraylist(declaration) result;
     arl_init(declaration, result);
 
     /* process storage flags */
-    bool is_typedef = false;
-    for (int i = 0; i < in.specs.storage_specs.size; i++) {
-        if (in.specs.storage_specs.data[i] == C_SCLS_TYPEDEF) {
-            is_typedef = true;
-        }
-    }
+    bool is_typedef = cst_native_declaration_is_typedef(in);
 
     /* process inner declarations */
     for (int i = 0; i < in.declarations.size; i++) {
-        arraylist(declaration) current_result = cst_native_declaration_translate(context, in.declarations.data[i]);
+        arraylist(declaration) current_result = cst_native_declaration_translate(context, in.declarations.data[i], native_unit);
         for (int j = 0; j < current_result.size; j++) {
             arraylist_add(declaration)(&result, current_result.data[j]);
         }
@@ -197,89 +326,11 @@ arraylist(declaration) cst_native_declaration_translate(se_context* context, c_d
     }
 
     /* extract the raw type */
-    ast_type raw_type = cst_native_declspecs_translate(context, in.specs, &result);
+    ast_type raw_type = cst_native_declspecs_translate(context, in.specs, native_unit, &result);
 
     /* process the declarators */
     for (int i = 0; i < in.declarators.size; i++) {
-        c_declarator this = in.declarators.data[i];
-
-        /* create an alias for the type */
-        dc_alias* al = allocate(dc_alias);
-        al->is_full = true;
-        al->name = this.name;
-        ast_type_clone_to(&al->target, raw_type);
-
-        /* append the levels set in the declarator */
-        for (int j = 0; j < this.level_list.size; j++) {
-            arraylist_add(ast_type_level)(&al->target.level_list, this.level_list.data[j]);
-        }
-
-        /* path char* as char[] */
-        if (ast_type_is_single_pointer(&al->target)
-            && al->target.kind == AST_TYPE_PRIMITIVE
-            && ast_type_primitive_get_index(al->target.u_primitive) == PRIMITIVE_INDEX_CHAR) {
-                logd("patching char* as char[]");
-                al->target.level_list.data[0].kind = AT_LEVEL_ARRAY;
-                al->target.level_list.data[0].u_array_size = 0;
-            }
-
-        declaration dc;
-        if (this.is_function) {
-            /* wrap it into a function */
-            dc_function* fn = allocate(dc_function);
-            fn->is_extern = true;
-            fn->is_full = true;
-            fn->name = this.name;
-            fn->parameters = this.u_parameters;
-            fn->return_type = al->target;
-            free(al);
-
-            if (is_typedef) {
-                /* then wrap it into another alias */
-                al = allocate(dc_alias);
-                al->is_full = true;
-                al->name = this.name;
-                ast_type_init(&al->target, AST_TYPE_PRIMITIVE, &primitive_list.data[PRIMITIVE_INDEX_VOID]);
-                ast_type_pointer_wrap(&al->target);
-                logw("function types are not supported yet!");
-
-                /* and wrap it into a declaration */
-                dc.is_full = true;
-                dc.is_native = true;
-                dc.name = al->name;
-                dc.kind = DC_ALIAS;
-                dc.token = TOKEN_ALIAS_NAME;
-                dc.ctoken = CTOKEN_ALIAS_NAME;
-                dc.u_alias = al;
-
-                logd("[native] %s = <%s(...)>", ast_type_display_name(&fn->return_type), this.name);
-            } else {
-                /* or wrap it into a declaration straightaway*/
-                dc.is_full = true;
-                dc.is_native = true;
-                dc.name = fn->name;
-                dc.kind = DC_FUNCTION;
-                dc.token = TOKEN_FUNCTION_NAME;
-                dc.ctoken = CTOKEN_FUNCTION_NAME;
-                dc.u_function = fn;
-
-                logd("[native] %s %s(...)", ast_type_display_name(&fn->return_type), this.name);
-            }
-        } else {
-            /* wrap it into a declaration */
-            dc.is_full = true;
-            dc.is_native = true;
-            dc.name = al->name;
-            dc.kind = DC_ALIAS;
-            dc.token = TOKEN_ALIAS_NAME;
-            dc.ctoken = CTOKEN_ALIAS_NAME;
-            dc.u_alias = al;
-            
-            logd("[native] %s = <%s>", this.name, ast_type_display_name(&al->target));
-        }
-
-        /* add it to the result list */
-        arraylist_add(declaration)(&result, dc);
+        arraylist_add(declaration)(&result, cst_native_declarator_translate(context, raw_type, in.declarators.data[i], is_typedef, native_unit));
     }
 
     /* special case - abstract declaration */
@@ -294,17 +345,106 @@ arraylist(declaration) cst_native_declaration_translate(se_context* context, c_d
         declaration dc;
         dc.is_full = true;
         dc.is_native = true;
+        dc.native_pending = NULL;
         dc.name = al->name;
         dc.kind = DC_ALIAS;
         dc.token = TOKEN_ALIAS_NAME;
         dc.ctoken = CTOKEN_ALIAS_NAME;
         dc.u_alias = al;
         
-        logd("[native] <abstract> <%s>;", ast_type_display_name(&al->target));
+        log_debug(LOG_NATIVE, "[native] <abstract> <%s>;", ast_type_display_name(&al->target));
 
         /* add it to the result list */
         arraylist_add(declaration)(&result, dc);
     }
 
     return result;
+}
+
+/**
+ * Declares the names of a top-level C-native declaration,
+ * deferring the translation of its declarators until
+ * their first use
+ * 
+ * Inner structure and enum declarations are
+ * declared right away, because the C parser refers to them
+ * 
+ * @param context The parser context
+ * @param in The C-native declaration
+ * @param native_unit The native unit the declaration belongs to
+ */
+void cst_native_declaration_declare(se_context* context, c_declaration in, char* native_unit) {
+    bool is_typedef = cst_native_declaration_is_typedef(in);
+
+    /* process inner declarations */
+    for (int i = 0; i < in.declarations.size; i++) {
+        cst_native_declaration_declare(context, in.declarations.data[i], native_unit);
+    }
+
+    /* declare the inner structures and enums */
+    arraylist(declaration) inner;
+    arl_init(declaration, inner);
+    ast_type raw_type = cst_native_declspecs_translate(context, in.specs, native_unit, &inner);
+    for (int i = 0; i < inner.size; i++) {
+        declaration dc = inner.data[i];
+        ast_declare_native(&context->ast, dc.kind, dc.token, dc.ctoken, dc.name, dc.u__any, native_unit);
+    }
+    arraylist_free(declaration)(&inner);
+
+    /* only remember the declarators */
+    for (int i = 0; i < in.declarators.size; i++) {
+        c_declarator this = in.declarators.data[i];
+        if (this.name == NULL) {
+            continue;
+        }
+
+        c_native_pending* pending = allocate(c_native_pending);
+        pending->raw_type = raw_type;
+        pending->declarator = this;
+        pending->is_typedef = is_typedef;
+        pending->context = context;
+        pending->native_unit = native_unit;
+        pending->value = NULL;
+
+        declaration* dc = allocate(declaration);
+        dc->is_full = true;
+        dc->is_native = true;
+        dc->is_shared = false;
+        dc->shared_origin = NULL;
+        dc->native_pending = pending;
+        dc->name = intern_string(this.name);
+        dc->kind = this.is_function && !is_typedef ? DC_FUNCTION : DC_ALIAS;
+        dc->u__any = NULL;
+        arraylist_init_with(char_ptr)(&dc->native_filename_list, native_unit);
+
+        log_debug(LOG_NATIVE, "[native-lazy] %s", dc->name);
+        if (dc->kind == DC_FUNCTION) {
+            ast_add_identifier(&context->ast, TOKEN_FUNCTION_NAME, CTOKEN_FUNCTION_NAME, dc);
+        } else {
+            ast_add_identifier(&context->ast, TOKEN_ALIAS_NAME, CTOKEN_ALIAS_NAME, dc);
+        }
+    }
+}
+
+/**
+ * Translates a native declaration declared by
+ * cst_native_declaration_declare on its first use
+ * 
+ * The value is allocated in the arena of the context
+ * which has parsed the declaration and shared by every
+ * linked copy of the declaration
+ * 
+ * @param pending The untranslated declaration
+ * 
+ * @return The value of the declaration
+ */
+void* cst_native_pending_translate(c_native_pending* pending) {
+    if (pending->value == NULL) {
+        mem_arena* previous = arena_select(&pending->context->arena);
+        declaration dc = cst_native_declarator_translate(pending->context,
+            pending->raw_type, pending->declarator, pending->is_typedef, pending->native_unit);
+        arena_select(previous);
+        pending->value = dc.u__any;
+    }
+    return pending->value;
 }
\ No newline at end of file
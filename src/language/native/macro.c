@@ -0,0 +1,859 @@
+/**
+ * @file macro.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Native macro constants implementation
+ */
+    /* includes */
+#include "language/native/macro.h" /* this */
+
+#include <stdlib.h>
+#include <stdint.h> /* integer limits */
+#include <string.h> /* string functions */
+#include <ctype.h> /* character classes */
+#include <errno.h> /* error codes */
+
+#include "syntax/declaration/declaration.h" /* declarations */
+#include "ast/root.h" /* syntax tree */
+#include "ast/type/primitive.h" /* primitives */
+#include "language/parser.h" /* parser */
+#include "language/native/parser.h" /* native parser */
+#include "language/native/cache.h" /* preprocessor name and cache */
+#include "misc/memory.h" /* memory allocation */
+#include "misc/intern.h" /* interned names */
+#include "misc/hash.h" /* name hash */
+
+    /* defines */
+/**
+ * Shift operators in the operator precedence table
+ */
+#define NATIVE_MACRO_SHIFT_LEFT  256
+#define NATIVE_MACRO_SHIFT_RIGHT 257
+
+    /* typedefs */
+/**
+ * Folding state of a macro
+ */
+typedef enum native_macro_state {
+    NATIVE_MACRO_UNKNOWN, NATIVE_MACRO_FOLDING,
+    NATIVE_MACRO_FOLDED, NATIVE_MACRO_INVALID
+} native_macro_state;
+
+/**
+ * Object-like macro definition, the name and
+ * the body point into the preprocessor output
+ */
+typedef struct native_macro {
+    char* name;
+    size_t length;
+    char* body;
+    char* end;
+    native_macro_state state;
+    ex_constant value;
+} native_macro;
+
+/**
+ * Macro definitions with an open addressing index by name
+ */
+struct native_macro_table {
+    native_macro* data;
+    size_t size;
+    size_t capacity;
+    size_t* slots; /* macro index + 1, or 0 for an empty slot */
+    size_t slot_mask;
+};
+
+/**
+ * Position of the folder in a macro body
+ */
+typedef struct native_macro_parser {
+    native_macro_table* table;
+    char* position;
+    char* end;
+    unsigned depth;
+} native_macro_parser;
+
+    /* internal functions */
+static bool native_macro_fold(native_macro_table* table, native_macro* macro, unsigned depth);
+static bool native_macro_fold_binary(native_macro_parser* parser, ex_constant* result, int min_precedence);
+static bool native_macro_apply_integer(ex_constant* left, int operator, ex_constant right);
+
+/**
+ * Finds a macro by its name
+ *
+ * @param[in] table  The macro table
+ * @param[in] name   The name
+ * @param[in] length Length of the name
+ *
+ * @return Pointer to the macro or NULL
+ */
+static native_macro* native_macro_find(native_macro_table* table, char* name, size_t length) {
+    size_t slot = hash_bytes(name, length) & table->slot_mask;
+    while (table->slots[slot] != 0) {
+        native_macro* macro = &table->data[table->slots[slot] - 1];
+        if (macro->length == length && memcmp(macro->name, name, length) == 0) {
+            return macro;
+        }
+        slot = (slot + 1) & table->slot_mask;
+    }
+    return NULL;
+}
+
+/**
+ * Collects the object-like macro definitions
+ * from the preprocessor output
+ *
+ * @param[in] data The preprocessor output
+ * @param[in] size Size of the output
+ *
+ * @return The macro table allocated by malloc
+ */
+static native_macro_table* native_macro_table_new(char* data, size_t size) {
+    native_macro_table* table = checked_malloc(sizeof(native_macro_table));
+    table->size = 0;
+    table->capacity = 256;
+    table->data = checked_malloc(sizeof(native_macro) * table->capacity);
+
+    char* line = data;
+    char* end = data + size;
+    while (line < end) {
+        char* next = memchr(line, '\n', end - line);
+        if (next == NULL) {
+            next = end;
+        }
+
+        /* #define NAME BODY, function-like macros are skipped, #undef NAME is kept as invalid */
+        size_t prefix = 0;
+        if ((size_t) (next - line) > strlen("#define ") && memcmp(line, "#define ", strlen("#define ")) == 0) {
+            prefix = strlen("#define ");
+        } else if ((size_t) (next - line) > strlen("#undef ") && memcmp(line, "#undef ", strlen("#undef ")) == 0) {
+            prefix = strlen("#undef ");
+        }
+        if (prefix != 0) {
+            char* name = line + prefix;
+            char* p = name;
+            while (p < next && (isalnum((unsigned char) *p) || *p == '_')) {
+                p++;
+            }
+            if (p != name && (p == next || *p == ' ')) {
+                if (table->size == table->capacity) {
+                    table->capacity *= 2;
+                    table->data = checked_realloc(table->data, sizeof(native_macro) * table->capacity);
+                }
+                native_macro* macro = &table->data[table->size++];
+                macro->name = name;
+                macro->length = p - name;
+                macro->body = p;
+                macro->end = next;
+                macro->state = line[1] == 'd' ? NATIVE_MACRO_UNKNOWN : NATIVE_MACRO_INVALID;
+            }
+        }
+        line = next + 1;
+    }
+
+    /* index the macros, a redefinition replaces the previous one */
+    size_t slot_count = 1;
+    while (slot_count < table->size * 2) {
+        slot_count *= 2;
+    }
+    table->slot_mask = slot_count - 1;
+    table->slots = checked_malloc(sizeof(size_t) * slot_count);
+    memset(table->slots, 0, sizeof(size_t) * slot_count);
+    iterate_array(i, table->size) {
+        native_macro* macro = &table->data[i];
+        size_t slot = hash_bytes(macro->name, macro->length) & table->slot_mask;
+        while (table->slots[slot] != 0) {
+            native_macro* current = &table->data[table->slots[slot] - 1];
+            if (current->length == macro->length && memcmp(current->name, macro->name, macro->length) == 0) {
+                current->state = NATIVE_MACRO_INVALID;
+                break;
+            }
+            slot = (slot + 1) & table->slot_mask;
+        }
+        table->slots[slot] = i + 1;
+    }
+    return table;
+}
+
+/**
+ * Skips the whitespace in a macro body
+ *
+ * @param[in] parser Pointer to the parser
+ */
+static void native_macro_skip(native_macro_parser* parser) {
+    while (parser->position < parser->end && isspace((unsigned char) *parser->position)) {
+        parser->position++;
+    }
+}
+
+/**
+ * Reads the value of an integer constant
+ *
+ * @param[in]  constant The constant
+ * @param[out] value    The value
+ * @param[out] width    Width of the constant in bits
+ *
+ * @return false if the constant is not an integer
+ */
+static bool native_macro_integer(ex_constant* constant, long long* value, int* width) {
+    switch (constant->kind) {
+        case EX_C_INT:
+            *value = constant->u_int;
+            *width = 32;
+            return true;
+
+        case EX_C_UINT:
+            *value = constant->u_uint;
+            *width = 32;
+            return true;
+
+        case EX_C_LONG:
+            *value = constant->u_long;
+            *width = 64;
+            return true;
+
+        case EX_C_ULONG:
+            *value = (long long) constant->u_ulong;
+            *width = 64;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * Checks whether a constant is zero or minus one,
+ * which are not allowed as divisors
+ *
+ * @param[in] constant The constant
+ *
+ * @return true if the constant may be a divisor
+ */
+static bool native_macro_is_divisor(ex_constant* constant) {
+    long long value;
+    int width;
+    if (native_macro_integer(constant, &value, &width)) {
+        return value != 0 && value != -1;
+    }
+    return ex_constant_is_floating(constant);
+}
+
+/**
+ * Folds a number literal with its C type
+ *
+ * @param[in]  parser Pointer to the parser
+ * @param[out] result The value
+ *
+ * @return false if the literal is not supported
+ */
+static bool native_macro_fold_number(native_macro_parser* parser, ex_constant* result) {
+    char* p = parser->position;
+    bool is_hex = parser->end - p > 1 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X');
+    bool is_floating = false;
+    while (p < parser->end) {
+        char c = *p;
+        if (c == '.') {
+            is_floating = true;
+        } else if ((c == 'e' || c == 'E') && !is_hex) {
+            is_floating = true;
+            if (p + 1 < parser->end && (p[1] == '+' || p[1] == '-')) {
+                p++;
+            }
+        } else if ((c == 'p' || c == 'P') && is_hex) {
+            is_floating = true;
+            if (p + 1 < parser->end && (p[1] == '+' || p[1] == '-')) {
+                p++;
+            }
+        } else if (!isalnum((unsigned char) c) && c != '_') {
+            break;
+        }
+        p++;
+    }
+
+    char literal[64];
+    size_t length = p - parser->position;
+    if (length >= sizeof(literal)) {
+        return false;
+    }
+    memcpy(literal, parser->position, length);
+    literal[length] = '\0';
+    parser->position = p;
+
+    char* suffix;
+    errno = 0;
+    if (is_floating) {
+        double value = strtod(literal, &suffix);
+        if (errno != 0) {
+            return false;
+        }
+        if (suffix[0] == 'f' || suffix[0] == 'F') {
+            if (suffix[1] != '\0') {
+                return false;
+            }
+            ex_constant_init(*result, FLOAT, float, (float) value);
+        } else {
+            if (suffix[0] != '\0' && ((suffix[0] != 'l' && suffix[0] != 'L') || suffix[1] != '\0')) {
+                return false;
+            }
+            ex_constant_init(*result, DOUBLE, double, value);
+        }
+        return true;
+    }
+
+    unsigned long long value = strtoull(literal, &suffix, 0);
+    if (errno != 0) {
+        return false;
+    }
+    bool is_unsigned = false;
+    int long_count = 0;
+    for (; *suffix != '\0'; suffix++) {
+        if ((*suffix == 'u' || *suffix == 'U') && !is_unsigned) {
+            is_unsigned = true;
+        } else if ((*suffix == 'l' || *suffix == 'L') && long_count < 2) {
+            long_count++;
+        } else {
+            return false;
+        }
+    }
+
+    /* decimal literals are never promoted to an unsigned type */
+    bool is_decimal = literal[0] != '0';
+    if (!is_unsigned && long_count == 0 && value <= INT32_MAX) {
+        ex_constant_init(*result, INT, int, (int32_t) value);
+    } else if (long_count == 0 && value <= UINT32_MAX && (is_unsigned || !is_decimal)) {
+        ex_constant_init(*result, UINT, uint, (uint32_t) value);
+    } else if (!is_unsigned && value <= INT64_MAX) {
+        ex_constant_init(*result, LONG, long, (int64_t) value);
+    } else if (is_unsigned || !is_decimal) {
+        ex_constant_init(*result, ULONG, ulong, (uint64_t) value);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Folds a unary expression: a number literal, a macro reference,
+ * an expression in parentheses or a unary operator
+ *
+ * @param[in]  parser Pointer to the parser
+ * @param[out] result The value
+ *
+ * @return false if the expression cannot be folded
+ */
+static bool native_macro_fold_unary(native_macro_parser* parser, ex_constant* result) {
+    native_macro_skip(parser);
+    if (parser->position == parser->end) {
+        return false;
+    }
+
+    char c = *parser->position;
+    if (isdigit((unsigned char) c) || (c == '.' && parser->position + 1 < parser->end
+            && isdigit((unsigned char) parser->position[1]))) {
+        return native_macro_fold_number(parser, result);
+    }
+
+    if (isalpha((unsigned char) c) || c == '_') {
+        char* name = parser->position;
+        while (parser->position < parser->end
+                && (isalnum((unsigned char) *parser->position) || *parser->position == '_')) {
+            parser->position++;
+        }
+        native_macro* macro = native_macro_find(parser->table, name, parser->position - name);
+        if (macro == NULL || !native_macro_fold(parser->table, macro, parser->depth + 1)) {
+            return false;
+        }
+        *result = macro->value;
+        return true;
+    }
+
+    parser->position++;
+    switch (c) {
+        case '(':
+            if (!native_macro_fold_binary(parser, result, 0)) {
+                return false;
+            }
+            native_macro_skip(parser);
+            if (parser->position == parser->end || *parser->position != ')') {
+                return false;
+            }
+            parser->position++;
+            return true;
+
+        case '+':
+            return native_macro_fold_unary(parser, result)
+                && ex_constant_is_number(result);
+
+        case '-': {
+            ex_constant value;
+            if (!native_macro_fold_unary(parser, &value) || !ex_constant_is_number(&value)) {
+                return false;
+            }
+
+            /* integers are negated as 0 - x, so that the negation of the minimum is rejected */
+            long long integer;
+            int width;
+            if (native_macro_integer(&value, &integer, &width)) {
+                *result = value;
+                switch (value.kind) {
+                    case EX_C_INT:   result->u_int   = 0; break;
+                    case EX_C_UINT:  result->u_uint  = 0; break;
+                    case EX_C_LONG:  result->u_long  = 0; break;
+                    case EX_C_ULONG: result->u_ulong = 0; break;
+                    otherwise_error
+                }
+                return native_macro_apply_integer(result, '-', value);
+            }
+            *result = value;
+            ex_constant_inherit_prefix((*result), value, -);
+            return true;
+        }
+
+        case '~': {
+            ex_constant value;
+            if (!native_macro_fold_unary(parser, &value)) {
+                return false;
+            }
+            *result = value;
+            switch (value.kind) {
+                case EX_C_INT:   result->u_int   = ~value.u_int;   return true;
+                case EX_C_UINT:  result->u_uint  = ~value.u_uint;  return true;
+                case EX_C_LONG:  result->u_long  = ~value.u_long;  return true;
+                case EX_C_ULONG: result->u_ulong = ~value.u_ulong; return true;
+                default: return false;
+            }
+        }
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * Reads the next binary operator without consuming it
+ *
+ * @param[in]  parser     Pointer to the parser
+ * @param[out] length     Length of the operator
+ * @param[out] precedence Precedence of the operator
+ *
+ * @return The operator, or 0 if there is no supported operator
+ */
+static int native_macro_operator(native_macro_parser* parser, size_t* length, int* precedence) {
+    native_macro_skip(parser);
+    char* p = parser->position;
+    size_t left = parser->end - p;
+    if (left == 0) {
+        return 0;
+    }
+
+    /* comparison, logical and assignment operators are not folded */
+    char next = left > 1 ? p[1] : '\0';
+    *length = 1;
+    switch (*p) {
+        case '*': case '/': case '%':
+            *precedence = 10;
+            return next == '=' ? 0 : *p;
+
+        case '+': case '-':
+            *precedence = 9;
+            return next == '=' || next == *p ? 0 : *p;
+
+        case '<': case '>':
+            if (next != *p || (left > 2 && p[2] == '=')) {
+                return 0;
+            }
+            *length = 2;
+            *precedence = 8;
+            return *p == '<' ? NATIVE_MACRO_SHIFT_LEFT : NATIVE_MACRO_SHIFT_RIGHT;
+
+        case '&':
+            *precedence = 5;
+            return next == '=' || next == '&' ? 0 : '&';
+
+        case '^':
+            *precedence = 4;
+            return next == '=' ? 0 : '^';
+
+        case '|':
+            *precedence = 3;
+            return next == '=' || next == '|' ? 0 : '|';
+
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Applies an addition, a subtraction, a multiplication or a left shift
+ * to two integer constants the way C does: the operands are converted
+ * to a common type, unsigned results wrap around and signed results
+ * outside of their type are rejected, as those are undefined in C
+ *
+ * @param[in,out] left     The left operand and the result
+ * @param[in]     operator The operator
+ * @param[in]     right    The right operand
+ *
+ * @return false if the result does not fit its type
+ */
+static bool native_macro_apply_integer(ex_constant* left, int operator, ex_constant right) {
+    long long left_value, right_value;
+    int left_width, right_width;
+    native_macro_integer(left, &left_value, &left_width);
+    native_macro_integer(&right, &right_value, &right_width);
+
+    /* the type of a shift is the type of its left operand */
+    ex_constant_kind kind = left->kind;
+    if (operator != NATIVE_MACRO_SHIFT_LEFT && right.kind != kind) {
+        bool is_long = left_width == 64 || right_width == 64;
+        bool is_unsigned = left->kind == EX_C_ULONG || right.kind == EX_C_ULONG
+            || (!is_long && (left->kind == EX_C_UINT || right.kind == EX_C_UINT));
+        kind = is_long ? (is_unsigned ? EX_C_ULONG : EX_C_LONG) : (is_unsigned ? EX_C_UINT : EX_C_INT);
+    }
+
+    switch (kind) {
+        case EX_C_UINT:
+        case EX_C_ULONG: {
+            uint64_t a = (uint64_t) left_value, b = (uint64_t) right_value, value;
+            switch (operator) {
+                case '+': value = a + b; break;
+                case '-': value = a - b; break;
+                case '*': value = a * b; break;
+                case NATIVE_MACRO_SHIFT_LEFT: value = a << b; break;
+                otherwise_error
+            }
+            if (kind == EX_C_UINT) {
+                ex_constant_init(*left, UINT, uint, (uint32_t) value);
+            } else {
+                ex_constant_init(*left, ULONG, ulong, value);
+            }
+            return true;
+        }
+
+        case EX_C_INT:
+        case EX_C_LONG: {
+            int64_t value;
+            bool is_overflow;
+            switch (operator) {
+                case '+': is_overflow = __builtin_add_overflow(left_value, right_value, &value); break;
+                case '-': is_overflow = __builtin_sub_overflow(left_value, right_value, &value); break;
+                case '*': is_overflow = __builtin_mul_overflow(left_value, right_value, &value); break;
+                case NATIVE_MACRO_SHIFT_LEFT:
+                    is_overflow = left_value > (INT64_MAX >> right_value);
+                    value = is_overflow ? 0 : left_value << right_value;
+                    break;
+                otherwise_error
+            }
+            if (kind == EX_C_INT) {
+                if (is_overflow || value < INT32_MIN || value > INT32_MAX) {
+                    return false;
+                }
+                ex_constant_init(*left, INT, int, (int32_t) value);
+            } else {
+                if (is_overflow) {
+                    return false;
+                }
+                ex_constant_init(*left, LONG, long, value);
+            }
+            return true;
+        }
+
+        otherwise_error
+    }
+    return false;
+}
+
+/**
+ * Applies a binary operator to two constants
+ *
+ * @param[in,out] left     The left operand and the result
+ * @param[in]     operator The operator
+ * @param[in]     right    The right operand
+ *
+ * @return false if the operation cannot be folded
+ */
+static bool native_macro_apply(ex_constant* left, int operator, ex_constant right) {
+    ex_constant result = { .origin = NULL };
+    long long left_value, right_value;
+    int left_width, right_width;
+    bool is_integer = native_macro_integer(left, &left_value, &left_width)
+        && native_macro_integer(&right, &right_value, &right_width);
+    if (!is_integer && (!ex_constant_is_number(left) || !ex_constant_is_number(&right))) {
+        return false;
+    }
+
+    /* integer operations which may overflow */
+    if (is_integer && (operator == '+' || operator == '-' || operator == '*')) {
+        return native_macro_apply_integer(left, operator, right);
+    }
+
+    switch (operator) {
+        case '*':
+            ex_constant_inherit_binary_numerical(result, (*left), *, right);
+            break;
+
+        case '/':
+            if (!native_macro_is_divisor(&right)) {
+                return false;
+            }
+            ex_constant_inherit_binary_numerical(result, (*left), /, right);
+            break;
+
+        case '+':
+            ex_constant_inherit_binary_numerical(result, (*left), +, right);
+            break;
+
+        case '-':
+            ex_constant_inherit_binary_numerical(result, (*left), -, right);
+            break;
+
+        case '%':
+            if (!is_integer || !native_macro_is_divisor(&right)) {
+                return false;
+            }
+            ex_constant_inherit_binary_integer(result, (*left), %, right);
+            break;
+
+        case NATIVE_MACRO_SHIFT_LEFT:
+            if (!is_integer || left_value < 0 || right_value < 0 || right_value >= left_width) {
+                return false;
+            }
+            return native_macro_apply_integer(left, operator, right);
+
+        case NATIVE_MACRO_SHIFT_RIGHT:
+            if (!is_integer || right_value < 0 || right_value >= left_width) {
+                return false;
+            }
+            ex_constant_inherit_binary_integer(result, (*left), >>, right);
+            break;
+
+        case '&':
+            if (!is_integer) {
+                return false;
+            }
+            ex_constant_inherit_binary_integer(result, (*left), &, right);
+            break;
+
+        case '^':
+            if (!is_integer) {
+                return false;
+            }
+            ex_constant_inherit_binary_integer(result, (*left), ^, right);
+            break;
+
+        case '|':
+            if (!is_integer) {
+                return false;
+            }
+            ex_constant_inherit_binary_integer(result, (*left), |, right);
+            break;
+
+        otherwise_error
+    }
+
+    *left = result;
+    return true;
+}
+
+/**
+ * Folds a binary expression by precedence climbing
+ *
+ * @param[in]  parser         Pointer to the parser
+ * @param[out] result         The value
+ * @param[in]  min_precedence Minimum precedence of the operators to fold
+ *
+ * @return false if the expression cannot be folded
+ */
+static bool native_macro_fold_binary(native_macro_parser* parser, ex_constant* result, int min_precedence) {
+    if (!native_macro_fold_unary(parser, result)) {
+        return false;
+    }
+
+    int operator;
+    size_t length;
+    int precedence;
+    while ((operator = native_macro_operator(parser, &length, &precedence)) != 0 && precedence >= min_precedence) {
+        parser->position += length;
+
+        ex_constant right;
+        if (!native_macro_fold_binary(parser, &right, precedence + 1)
+                || !native_macro_apply(result, operator, right)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Folds the body of a macro, once
+ *
+ * @param[in] table The macro table
+ * @param[in] macro Pointer to the macro
+ * @param[in] depth Nesting of macro references
+ *
+ * @return false if the body cannot be folded
+ */
+static bool native_macro_fold(native_macro_table* table, native_macro* macro, unsigned depth) {
+    switch (macro->state) {
+        case NATIVE_MACRO_FOLDED:
+            return true;
+
+        case NATIVE_MACRO_FOLDING: /* self-referencing macros are not expanded */
+        case NATIVE_MACRO_INVALID:
+            return false;
+
+        case NATIVE_MACRO_UNKNOWN:
+            break;
+
+        otherwise_error
+    }
+    if (depth > NATIVE_MACRO_MAX_DEPTH) {
+        return false;
+    }
+
+    macro->state = NATIVE_MACRO_FOLDING;
+    native_macro_parser parser = { table, macro->body, macro->end, depth };
+    bool result = native_macro_fold_binary(&parser, &macro->value, 0);
+    native_macro_skip(&parser);
+    result = result && parser.position == parser.end;
+
+    macro->state = result ? NATIVE_MACRO_FOLDED : NATIVE_MACRO_INVALID;
+    return result;
+}
+
+/**
+ * Checks whether a macro name may be declared
+ *
+ * @param[in] macro Pointer to the macro
+ *
+ * @return false for internal and lowercase names
+ */
+static bool native_macro_is_exported(native_macro* macro) {
+    if (macro->length >= 2 && macro->name[0] == '_' && macro->name[1] == '_') {
+        return false;
+    }
+    for (size_t i = 0; i < macro->length; i++) {
+        if (islower((unsigned char) macro->name[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Finds the primitive type of a folded constant
+ *
+ * @param[in] constant The constant
+ *
+ * @return The primitive type
+ */
+static ast_type_primitive* native_macro_type(ex_constant* constant) {
+    switch (constant->kind) {
+        case EX_C_INT:    return &primitive_list.data[PRIMITIVE_INDEX_INT];
+        case EX_C_UINT:   return &primitive_list.data[PRIMITIVE_INDEX_UINT];
+        case EX_C_LONG:   return &primitive_list.data[PRIMITIVE_INDEX_LONG];
+        case EX_C_ULONG:  return &primitive_list.data[PRIMITIVE_INDEX_ULONG];
+        case EX_C_FLOAT:  return &primitive_list.data[PRIMITIVE_INDEX_FLOAT];
+        case EX_C_DOUBLE: return &primitive_list.data[PRIMITIVE_INDEX_DOUBLE];
+        otherwise_error
+    }
+    return NULL;
+}
+
+/**
+ * Declares the folded macro constants defined
+ * in a part of the preprocessor output
+ *
+ * @param[in] context     Pointer to the parser context
+ * @param[in] table       The macro table
+ * @param[in] first       Start of the part
+ * @param[in] last        End of the part
+ * @param[in] header      The header name, for debug output
+ * @param[in] native_unit The native unit the constants belong to
+ */
+static void native_macro_declare(se_context* context, native_macro_table* table,
+        char* first, char* last, char* header, char* native_unit) {
+    size_t count = 0, total = 0;
+    iterate_array(i, table->size) {
+        native_macro* macro = &table->data[i];
+        if (macro->name < first || macro->name >= last) {
+            continue;
+        }
+        total++;
+        if (!native_macro_is_exported(macro) || !native_macro_fold(table, macro, 0)) {
+            continue;
+        }
+
+        /* native declarations of the same name are merged as usual */
+        char* name = intern_string_length(macro->name, macro->length);
+        declaration* dc_ex = ast_declaration_lookup(&context->ast, name);
+        if (dc_ex != NULL && !dc_ex->is_native) {
+            log_debug(LOG_NATIVE, "macro %s is shadowed by a declaration", name);
+            continue;
+        }
+
+        dc_constant* constant = allocate(dc_constant);
+        constant->name = name;
+        constant->value = macro->value;
+        constant->type = native_macro_type(&macro->value);
+        ast_declare_native(&context->ast, DC_CONSTANT, TOKEN_CONSTANT_NAME, CTOKEN_IDENTIFIER,
+            name, constant, native_unit);
+        count++;
+    }
+    log_debug(LOG_NATIVE, "declared %zu of %zu macro constants from %s", count, total, header);
+}
+
+    /* functions */
+/**
+ * Declares the macro constants of a native header
+ *
+ * @param[in] context     Pointer to the parser context
+ * @param[in] header      The header name, as in #include <header>
+ * @param[in] native_unit The native unit the constants belong to
+ */
+void native_macro_import(se_context* context, char* header, char* native_unit) {
+    source_buffer source;
+    if (!native_cache_open_macros(header, &source) && !native_preprocess(&header, 1, "-dM", header, &source)) {
+        logw("unable to read the macro definitions of %s", header);
+        return;
+    }
+
+    native_macro_table* table = native_macro_table_new(source.data, source.size);
+    native_macro_declare(context, table, source.data, source.data + source.size, header, native_unit);
+
+    native_macro_table_free(table);
+    source_buffer_close(&source);
+}
+
+/**
+ * Declares the macro constants defined in the region
+ * of a header in a batch, the macros are folded as they
+ * are defined at the end of the batch
+ *
+ * @param[in] context Pointer to the parser context
+ * @param[in] batch   The batch
+ * @param[in] region  The region of the header
+ */
+void native_macro_import_batch(se_context* context, native_batch* batch, native_batch_region* region) {
+    if (region->start == NULL) {
+        return;
+    }
+    if (batch->macros == NULL) {
+        batch->macros = native_macro_table_new(batch->output, batch->size);
+    }
+    native_macro_declare(context, batch->macros, region->start, region->start + region->size,
+        region->header, batch->unit);
+}
+
+/**
+ * Releases a macro table
+ *
+ * @param[in] table The macro table
+ */
+void native_macro_table_free(native_macro_table* table) {
+    free(table->data);
+    free(table->slots);
+    free(table);
+}
\ No newline at end of file
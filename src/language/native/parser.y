@@ -210,9 +210,9 @@
 %nterm  <c_declarator>  direct_abstract_declarator
 
 	/* function */
-%nterm  <dc_function_parameters>  		   	function_parameters
-%nterm  <arraylist(dc_function_parameter)> 	function_parameter_list
-%nterm  <dc_function_parameter>			   	function_parameter
+%nterm  <c_function_parameters>  		   	function_parameters
+%nterm  <arraylist(c_declaration)> 			function_parameter_list
+%nterm  <c_declaration>			   			function_parameter
 %nterm  <c_declaration>						parameter_declaration
 
 	/* structure */
@@ -536,23 +536,29 @@ struct_or_union_specifier
 	: struct_or_union_prefix structure_name structure_body
 		{
 			$$ = allocate(dc_structure);
+			$$->_origin = NULL;
+			$$->_is_sealed = false;
 			$$->is_full = true;
 			$$->is_c_struct = true;
 			$$->name = $structure_name;
 			$$->member_list = $structure_body;
 			li_init_empty(dc_generic_ptr, $$->generics);
 			arraylist_init_empty(list(ast_type))(&$$->_generic_impls);
+			arraylist_init_empty(ast_layout)(&$$->_layouts);
 		}
 	
 	| struct_or_union_prefix structure_body
 		{
 			$$ = allocate(dc_structure);
+			$$->_origin = NULL;
+			$$->_is_sealed = false;
 			$$->is_full = true;
 			$$->is_c_struct = true;
 			$$->name = NULL;
 			$$->member_list = $structure_body;
 			li_init_empty(dc_generic_ptr, $$->generics);
 			arraylist_init_empty(list(ast_type))(&$$->_generic_impls);
+			arraylist_init_empty(ast_layout)(&$$->_layouts);
 		}
 
 	| struct_or_union_prefix structure_name
@@ -561,22 +567,26 @@ struct_or_union_specifier
 			declaration* dc = ast_declaration_lookup(&context->ast, actual);
 			if (dc == NULL) {
 				dc_structure* st = allocate(dc_structure);
+				st->_origin = NULL;
+				st->_is_sealed = false;
 				st->is_full = false;
 				st->is_c_struct = true;
 				st->name = actual;
 				li_init_empty(dc_generic_ptr, st->generics);
 				li_init_empty(dc_structure_member, st->member_list);
+				arraylist_init_empty(ast_layout)(&st->_layouts);
 
 				ast_declare_native(&context->ast, 
 					DC_STRUCTURE, TOKEN_STRUCTURE_NAME, CTOKEN_STRUCTURE_NAME, 
 					st->name, st,
-					arraylist_last(context->file_list)->filename); 
+					arraylist_last(context->file_list)->native_unit); 
 				
 				$$ = st;
 			} else {
 				if (dc->kind == DC_STRUCTURE) {
+					/* the forward declaration belongs to this header too */
+					ast_add_native_filename(dc, arraylist_last(context->file_list)->native_unit);
 					$$ = dc->u_structure;
-					free(actual);
 				} else {
 					logfe("expected a structure name (%s)", actual);
 				}
@@ -599,7 +609,7 @@ structure_member_list
 
 structure_member
 	: struct_declaration
-		{ $$ = cst_native_declaration_to_structure_member(context, $struct_declaration); }
+		{ $$ = cst_native_declaration_to_structure_member(context, $struct_declaration, arraylist_last(context->file_list)->native_unit); }
 	;
 
 struct_declaration
@@ -696,6 +706,7 @@ enum_specifier
 			declaration* dc = ast_declaration_lookup(&context->ast, actual);
 			if (dc == NULL) {
 				dc_enum* st = allocate(dc_enum);
+				st->_origin = NULL;
 				st->is_full = false;
 				st->is_c_enum = true;
 				st->name = actual;
@@ -704,13 +715,13 @@ enum_specifier
 				ast_declare_native(&context->ast, 
 					DC_ENUM, TOKEN_ENUM_NAME, CTOKEN_ENUM_NAME, 
 					st->name, st,
-					arraylist_last(context->file_list)->filename); 
+					arraylist_last(context->file_list)->native_unit); 
 				
 				$$ = st;
 			} else {
 				if (dc->kind == DC_ENUM) {
+					ast_add_native_filename(dc, arraylist_last(context->file_list)->native_unit);
 					$$ = dc->u_enum;
-					free(actual);
 				} else {
 					logfe("expected a enum name (%s)", actual);
 				}
@@ -861,6 +872,8 @@ direct_declarator
 	| direct_declarator[value] '(' ')'
 		{ $$ = $value; 
 			$$.is_function = true;
+			$$.u_parameters.is_c_vararg = false;
+			arraylist_init_empty(c_declaration)(&$$.u_parameters.value);
 		}
 		
 	| direct_declarator[value] '(' identifier_list ')'
@@ -888,28 +901,28 @@ type_qualifier_list
 function_parameters
 	: function_parameter_list
 		{ 
-			li_init_from(dc_function_parameter, $$.value, $function_parameter_list);
+			$$.value = $function_parameter_list;
 			$$.is_c_vararg = false;
 		}
 
 	| function_parameter_list ',' C_VARARG
 		{ 
-			li_init_from(dc_function_parameter, $$.value, $function_parameter_list);
+			$$.value = $function_parameter_list;
 			$$.is_c_vararg = true;
 		}
 	;
 
 function_parameter_list
 	: function_parameter
-		{ arraylist_init_with(dc_function_parameter)(&$$, $function_parameter); }
+		{ arraylist_init_with(c_declaration)(&$$, $function_parameter); }
 
 	| function_parameter_list[value] ',' function_parameter
-		{ arl_assign_add(dc_function_parameter, $$, $function_parameter, $value); }
+		{ arl_assign_add(c_declaration, $$, $function_parameter, $value); }
 	;
 
 function_parameter
 	: parameter_declaration
-		{ $$ = cst_native_declaration_to_function_parameter(context, $parameter_declaration); }
+		{ $$ = $parameter_declaration; }
 	;
 
 parameter_declaration
@@ -991,7 +1004,7 @@ direct_abstract_declarator
 			$$.name = NULL; 
 			$$.is_function = true;
 			$$.u_parameters.is_c_vararg = false;
-			li_init_empty(dc_function_parameter, $$.u_parameters.value);
+			arraylist_init_empty(c_declaration)(&$$.u_parameters.value);
 			arraylist_init_empty(ast_type_level)(&$$.level_list);
 		}
 
@@ -1007,7 +1020,7 @@ direct_abstract_declarator
 		{ $$ = $value;
 			$$.is_function = true;
 			$$.u_parameters.is_c_vararg = false;
-			li_init_empty(dc_function_parameter, $$.u_parameters.value);
+			arraylist_init_empty(c_declaration)(&$$.u_parameters.value);
 		}
 
 	| direct_abstract_declarator[value] '(' function_parameters ')'
@@ -1114,17 +1127,8 @@ translation_unit
 external_declaration_terminal
 	: external_declaration
 		{ 
-			arraylist(declaration) declarations = cst_native_declaration_translate(context, $external_declaration);
-			logd("got %zu declarations", declarations.size);
-			for (int i = 0; i < declarations.size; i++) {
-				declaration dc = declarations.data[i];
-				if (dc.name != NULL) {
-					ast_declare_native(&context->ast,
-						dc.kind, dc.token, dc.ctoken, 
-						dc.name, dc.u__any, 
-						arraylist_last(context->file_list)->filename);
-				}
-			}
+			cst_native_declaration_declare(context, $external_declaration,
+				arraylist_last(context->file_list)->native_unit);
 		}
 	;
 
@@ -41,6 +41,13 @@
 	* @param[in] message  The error message
 	*/
 	void myyerror(MYYLTYPE* location, void* scanner, se_context* context, const char* message);
+
+	/**
+	* Returns the display name of a token kind
+	*
+	* @param[in] kind The token kind
+	*/
+	const char* myytoken_name(int kind);
 }
 
 %{	
@@ -121,6 +128,9 @@
 		TYPE		"type"
 		NEW			"new"
 		AS			"as"
+		SIZEOF		"sizeof"
+		ALIGNOF		"alignof"
+		OFFSETOF	"offsetof"
 
 		IF			"if"
 		ELSE		"else"
@@ -144,6 +154,7 @@
 	/* value references */
 %token <dc_st_variable*>		VARIABLE_NAME  			"variable name"
 %token <dc_function*> 			FUNCTION_NAME 			"function name"
+%token <dc_constant*> 			CONSTANT_NAME 			"constant name"
 %token <dc_function_parameter*> FUNCTION_PARAMETER_NAME	"function parameter name"
 
 	/* special tokens */
@@ -214,6 +225,9 @@
 %nterm 	<ex_constructor*>  constructor_expression_
 %nterm	<ex_constructor*>  constructor_expression_basic
 
+	/* layout expression */
+%nterm 	<ex_layout*>  layout_expression
+
 	/* enum member expression */
 %nterm 	<ex_enum_member*>  enum_member_expression
 
@@ -419,7 +433,7 @@ function_prefix
 					.u_function_parameter = &$function_parameters.value.data[i]
 				};
 
-				arl_add(local_declaration, context_current(context)->u_locals, dc);
+				context_declare_local(context, dc);
 			}
 
 			context_skip(context, SCTX_PASS_2);
@@ -549,13 +563,16 @@ structure_prefix
 					.u_generic = $generics.data[i]
 				};
 
-				arl_add(local_declaration, context_current(context)->u_locals, dc);
+				context_declare_local(context, dc);
 			}
 			
 			$$ = allocate(dc_structure);
+			$$->_origin = NULL;
+			$$->_is_sealed = false;
 			$$->name = $structure_name;
 			$$->generics = $generics;
 			arraylist_init_empty(list(ast_type))(&$$->_generic_impls);
+			arraylist_init_empty(ast_layout)(&$$->_layouts);
 		}
 	;
 
@@ -649,6 +666,7 @@ enum_declaration
 	  SKIPPED_BODY ';'
 	  	{
 			$$ = allocate(dc_enum);
+			$$->_origin = NULL;
 			$$->is_full = false;
 			$$->is_c_enum = false;
 			$$->name = $enum_name;
@@ -775,8 +793,7 @@ local_variable_declaration_statement
 		{
 			$$ = $variable_declaration_statement;
 
-			se_context_level* function = context_find(context, SCTX_SCOPE);
-			if (function != NULL) {
+			if (context_find(context, SCTX_SCOPE) != NULL) {
 				local_declaration dc = {
 					.kind = DC_L_VARIABLE,
 					.token = TOKEN_VARIABLE_NAME,
@@ -784,7 +801,7 @@ local_variable_declaration_statement
 					.u_variable = $$
 				};
 
-				arl_add(local_declaration, function->u_locals, dc);
+				context_declare_local(context, dc);
 			}
 		}
 	;
@@ -911,6 +928,17 @@ constructor_expression
 		}
 	;
 
+layout_expression
+	: SIZEOF '(' type ')'
+		{ $$ = ex_layout_new(EX_L_SIZEOF, $type, NULL); }
+
+	| ALIGNOF '(' type ')'
+		{ $$ = ex_layout_new(EX_L_ALIGNOF, $type, NULL); }
+
+	| OFFSETOF '(' type ',' IDENTIFIER ')'
+		{ $$ = ex_layout_new(EX_L_OFFSETOF, $type, $IDENTIFIER); }
+	;
+
 enum_member_expression
 	: ENUM_NAME '.' IDENTIFIER
 		{
@@ -950,9 +978,15 @@ basic_expression
 	| constructor_expression
 		{ inherit_extern(basic, ex_constructor, $$, $constructor_expression);}
 
+	| layout_expression
+		{ inherit_extern(basic, layout, $$, $layout_expression); }
+
 	| enum_member_expression
 		{ inherit_extern(basic, enum_member, $$, $enum_member_expression); }
 
+	| CONSTANT_NAME
+		{ inherit_extern(basic, constant, $$, $CONSTANT_NAME); }
+
 	| '(' expression ')'
 		{ inherit_expression(basic, expression, $$, (*$expression)); }
 	;
@@ -1187,8 +1221,10 @@ type_terminal
 
 	| STRUCTURE_NAME generic_impls
 		{ 
-			ast_type_init(&$$, AST_TYPE_STRUCTURE, $STRUCTURE_NAME); 
-			$$._generic_impl_index = dc_structure_generic_add_impl($STRUCTURE_NAME, $generic_impls);
+			dc_structure* structure = $STRUCTURE_NAME;
+			index_t impl_index = ast_structure_add_impl(&context->ast, &structure, $generic_impls);
+			ast_type_init(&$$, AST_TYPE_STRUCTURE, structure); 
+			$$._generic_impl_index = impl_index;
 		}
 
 	| ENUM_NAME
@@ -1325,6 +1361,15 @@ void yyerror(MYYLTYPE* location, void* scanner, se_context* context, const char*
 	error_syntax("%s", message);
 }
 
+/**
+ * Returns the display name of a token kind
+ *
+ * @param[in] kind The token kind
+ */
+const char* myytoken_name(int kind) {
+	return yysymbol_name(YYTRANSLATE(kind));
+}
+
 char* error_format_string(int argc) {
 	switch (argc) {
 		case 0: return "%@: syntax error";
@@ -0,0 +1,188 @@
+/**
+ * @file scope.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ *  Scoped symbol table implementation
+ */
+    /* includes */
+#include "language/scope.h" /* this */
+#include "syntax/declaration/declaration.h" /* local declarations */
+
+#include <stdlib.h> /* memory allocation */
+
+#include "misc/intern.h" /* interned names */
+#include "misc/error.h"  /* error throw */
+
+    /* defines */
+/**
+ * Initial slot count of the hash map, must be a power of two
+ */
+#define SCOPE_TABLE_INITIAL_CAPACITY 64
+
+    /* internal functions */
+/**
+ * Finds the slot of a name, or the
+ * empty slot where it should be inserted
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] name  The interned name
+ * 
+ * @return Index of the slot
+ */
+static inline size_t scope_table_probe(se_scope_table* table, char* name) {
+    size_t mask = table->capacity - 1;
+    size_t index = intern_hash(name) & mask;
+    while (table->slots[index].key != NULL && table->slots[index].key != name) {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+/**
+ * Allocates the slot array of a table
+ * 
+ * @param[out] table    Pointer to the table
+ * @param[in]  capacity The capacity, a power of two
+ */
+static void scope_table_allocate(se_scope_table* table, size_t capacity) {
+    table->slots = calloc(capacity, sizeof(se_scope_slot));
+    if (table->slots == NULL) {
+        error_internal("failed to allocate a scope table of %zu entries", capacity);
+    }
+    table->capacity = capacity;
+}
+
+/**
+ * Doubles the capacity of the hash map
+ * 
+ * @param[in] table Pointer to the table
+ */
+static void scope_table_grow(se_scope_table* table) {
+    se_scope_slot* old_slots = table->slots;
+    size_t old_capacity = table->capacity;
+
+    scope_table_allocate(table, old_capacity * 2);
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_slots[i].key != NULL) {
+            table->slots[scope_table_probe(table, old_slots[i].key)] = old_slots[i];
+        }
+    }
+    free(old_slots);
+}
+
+/**
+ * Removes a name from the hash map by shifting
+ * the following slots back
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] index Index of the slot to be removed
+ */
+static void scope_table_remove_slot(se_scope_table* table, size_t index) {
+    size_t mask = table->capacity - 1;
+    size_t hole = index;
+    size_t next = (hole + 1) & mask;
+    while (table->slots[next].key != NULL) {
+        size_t home = intern_hash(table->slots[next].key) & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            table->slots[hole] = table->slots[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    table->slots[hole].key = NULL;
+    table->size--;
+}
+
+    /* functions */
+/**
+ * Initializes an empty scoped symbol table
+ * 
+ * @param[out] table Pointer to the table
+ */
+void scope_table_init(se_scope_table* table) {
+    arl_init(se_scope_binding, table->bindings);
+    scope_table_allocate(table, SCOPE_TABLE_INITIAL_CAPACITY);
+    table->size = 0;
+}
+
+/**
+ * Releases the memory of a scoped symbol table
+ * 
+ * @param[in] table Pointer to the table
+ */
+void scope_table_free(se_scope_table* table) {
+    arraylist_free(se_scope_binding)(&table->bindings);
+    free(table->slots);
+    table->slots = NULL;
+    table->capacity = 0;
+    table->size = 0;
+}
+
+/**
+ * Declares a local symbol in the innermost scope,
+ * shadowing any outer symbol with the same name
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] dc    The local declaration with an interned name
+ */
+void scope_table_declare(se_scope_table* table, local_declaration dc) {
+    if ((table->size + 1) * 2 > table->capacity) {
+        scope_table_grow(table);
+    }
+
+    se_scope_binding binding = { .value = dc, .shadowed = SCOPE_BINDING_NONE };
+    size_t index = scope_table_probe(table, dc.name);
+    if (table->slots[index].key != NULL) {
+        binding.shadowed = table->slots[index].binding;
+    } else {
+        table->slots[index].key = dc.name;
+        table->size++;
+    }
+
+    table->slots[index].binding = table->bindings.size;
+    arl_add(se_scope_binding, table->bindings, binding);
+}
+
+/**
+ * Looks up the innermost local symbol with specified name
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] name  Interned name of the symbol
+ * 
+ * @return Pointer to the local declaration, valid until the next declaration,
+ *          or NULL if not found
+ */
+local_declaration* scope_table_lookup(se_scope_table* table, char* name) {
+    if (table->size == 0) {
+        return NULL;
+    }
+
+    size_t index = scope_table_probe(table, name);
+    if (table->slots[index].key == NULL) {
+        return NULL;
+    }
+    return &table->bindings.data[table->slots[index].binding].value;
+}
+
+/**
+ * Removes every symbol declared after the mark
+ * and restores the symbols shadowed by them
+ * 
+ * @param[in] table Pointer to the table
+ * @param[in] mark  The binding log position returned by scope_table_mark
+ */
+void scope_table_unwind(se_scope_table* table, size_t mark) {
+    while (table->bindings.size > mark) {
+        se_scope_binding binding = arraylist_last(table->bindings);
+        arl_pop(se_scope_binding, table->bindings);
+        size_t index = scope_table_probe(table, binding.value.name);
+
+        if (binding.shadowed != SCOPE_BINDING_NONE) {
+            table->slots[index].binding = binding.shadowed;
+        } else {
+            scope_table_remove_slot(table, index);
+        }
+    }
+}
\ No newline at end of file
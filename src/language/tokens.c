@@ -0,0 +1,290 @@
+/**
+ * @file tokens.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Recorded token streams implementation
+ */
+    /* includes */
+#include "language/tokens.h" /* this */
+
+#include <stdlib.h>
+
+#include "language/context.h" /* parser context */
+#include "language/parser.h" /* parser */
+#include "language/lexer.h" /* lexer */
+#include "ast/lookup.h" /* identifier lookup */
+#include "misc/memory.h" /* memory allocation */
+#include "misc/stats.h" /* token counts */
+
+    /* defines */
+/**
+ * Initial number of tokens in a stream
+ */
+#define TOKEN_STREAM_INITIAL_CAPACITY 1024
+
+/**
+ * Returned by token_skip if the parser expects no token
+ */
+#define TOKEN_SKIP_CONTINUE -1
+
+    /* internal functions */
+/**
+ * Takes the next token of a stream
+ *
+ * @param[in]  reader   Pointer to the token reader
+ * @param[out] location Location of the token
+ *
+ * @return Pointer to the token, or NULL at the end of the stream
+ */
+static se_token* token_next(se_token_reader* reader, MYYLTYPE* location) {
+    if (reader->position == reader->stream->size) {
+        return NULL;
+    }
+    se_token* token = &reader->stream->data[reader->position++];
+    location->first_line = token->line;
+    location->last_line = token->line;
+    return token;
+}
+
+/**
+ * Skips the tokens up to the pair of the
+ * opening token which has started the skip mode
+ *
+ * @param[in]  reader   Pointer to the token reader
+ * @param[out] location Location of the last token
+ * @param[in]  context  Pointer to the parser context
+ * @param[in]  opening  The opening token, one of '{', '(', '=' and '<'
+ *
+ * @return The skipped token kind, TOKEN_SKIP_CONTINUE if the parser
+ *          expects the next real token or 0 at the end of the stream
+ */
+static int token_skip(se_token_reader* reader, MYYLTYPE* location, se_context* context, int opening) {
+    /* statements are terminated by a ';' outside of braces */
+    bool is_statement = opening == '=';
+    int open = is_statement ? '{' : opening;
+    int close = is_statement ? '}' : context->skip_until;
+
+    se_token* token;
+    while ((token = token_next(reader, location)) != NULL) {
+        if (token->kind == open) {
+            ++context->skip_pair_count;
+            continue;
+        }
+        if (token->kind == close) {
+            --context->skip_pair_count;
+            if (is_statement || context->skip_pair_count != 0) {
+                continue;
+            }
+        } else if (!is_statement || token->kind != ';' || context->skip_pair_count != 0) {
+            continue;
+        }
+
+        /* the pair has been found */
+        context_finish_skip(context);
+        switch (opening) {
+            case '{':
+                return TOKEN_SKIPPED_BODY;
+
+            case '(':
+                log_debug(LOG_LEXER, "parameter skip: forwarding to body skip");
+                context_skip_specific_unless(context, context->pass, '{', ';');
+                return TOKEN_SKIPPED_PARAMETERS;
+
+            case '=':
+                return TOKEN_SKIPPED_STATEMENT;
+
+            case '<':
+                log_debug(LOG_LEXER, "generic skip: forwarding to parameter skip");
+                context_skip_specific_unless(context, context->pass, '(', SCTX_SKIP_ANY);
+                return TOKEN_SKIP_CONTINUE;
+
+            otherwise_error
+        }
+    }
+    return 0;
+}
+
+    /* functions */
+/**
+ * Lexes a whole source file into a new token stream,
+ * scanning the source buffer in place
+ *
+ * String literals are allocated in the current arena
+ *
+ * @param[in] source   The source buffer
+ * @param[in] filename Name of the file for error messages
+ *
+ * @return The token stream allocated by malloc
+ */
+se_token_stream* token_stream_lex(source_buffer* source, char* filename) {
+    se_token_stream* stream = checked_malloc(sizeof(se_token_stream));
+    stream->size = 0;
+    stream->capacity = TOKEN_STREAM_INITIAL_CAPACITY;
+    stream->data = checked_malloc(sizeof(se_token) * stream->capacity);
+
+    /* initialize the scanner */
+    yyscan_t scanner;
+    if (myylex_init(&scanner) != 0) {
+        error_internal("import: unable to initizize the yacc scanner");
+    }
+    if (myy_scan_buffer(source->data, source_buffer_scan_size(source), scanner) == NULL) {
+        error_internal("import: unable to scan file %s", filename);
+    }
+
+    /* record every token */
+    MYYSTYPE value;
+    MYYLTYPE location = { 1, 1, 1, 1 };
+    int kind;
+    while ((kind = myylex_raw(&value, &location, scanner)) != 0) {
+        if (stream->size == stream->capacity) {
+            stream->capacity *= 2;
+            stream->data = checked_realloc(stream->data, sizeof(se_token) * stream->capacity);
+        }
+        se_token* token = &stream->data[stream->size++];
+        token->kind = kind;
+        token->line = location.first_line;
+        stats_count_token(kind);
+
+        switch (kind) {
+            case TOKEN_IDENTIFIER:
+                token->u_string = value.TOKEN_IDENTIFIER;
+                break;
+
+            case TOKEN_STRING_LITERAL:
+                token->u_string = value.TOKEN_STRING_LITERAL;
+                break;
+
+            case TOKEN_CODE_LITERAL:
+                token->u_string = value.TOKEN_CODE_LITERAL;
+                break;
+
+            case TOKEN_LONG_CONSTANT:
+                token->u_long = value.TOKEN_LONG_CONSTANT;
+                break;
+
+            case TOKEN_DOUBLE_CONSTANT:
+                token->u_double = value.TOKEN_DOUBLE_CONSTANT;
+                break;
+
+            case TOKEN_CHAR_CONSTANT:
+                token->u_char = value.TOKEN_CHAR_CONSTANT;
+                break;
+
+            case TOKEN_TRUE:
+                token->u_boolean = value.TOKEN_TRUE;
+                break;
+
+            case TOKEN_FALSE:
+                token->u_boolean = value.TOKEN_FALSE;
+                break;
+
+            case TOKEN_OP_ASSIGN:
+                token->u_op_assign = value.TOKEN_OP_ASSIGN;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    /* free */
+    myylex_destroy(scanner);
+
+    log_debug(LOG_LEXER, "lexed %zu tokens from %s", stream->size, filename);
+    return stream;
+}
+
+/**
+ * Releases a token stream
+ *
+ * @param[in] stream The token stream
+ */
+void token_stream_free(se_token_stream* stream) {
+    free(stream->data);
+    free(stream);
+}
+
+/**
+ * Returns the next token of a recorded token stream,
+ * classifying identifiers and applying the skip mode
+ * of the current pass
+ *
+ * @param[out] yylval_param Sematic value of the token
+ * @param[out] yylloc_param Location of the token
+ * @param[in]  yyscanner    Pointer to the token reader
+ * @param[in]  context      Pointer to the parser context
+ *
+ * @return Kind of the token, or 0 at the end of the stream
+ */
+int myylex(MYYSTYPE* yylval_param, MYYLTYPE* yylloc_param, void* yyscanner, se_context* context) {
+    se_token_reader* reader = yyscanner;
+
+    se_token* token;
+    while ((token = token_next(reader, yylloc_param)) != NULL) {
+        switch (token->kind) {
+            /* tokens which may start the skip mode */
+            case '{':
+            case '(':
+            case '=':
+            case '<':
+                switch (context_should_skip(context, token->kind)) {
+                    case SCTX_SA_NONE:
+                    case SCTX_SA_EXIT:
+                        return token->kind;
+
+                    case SCTX_SA_START: {
+                        log_debug(LOG_LEXER, "skip: %c", token->kind);
+                        int result = token_skip(reader, yylloc_param, context, token->kind);
+                        if (result != TOKEN_SKIP_CONTINUE) {
+                            return result;
+                        }
+                        break;
+                    }
+
+                    otherwise_error
+                }
+                break;
+
+            case TOKEN_IDENTIFIER:
+                return ast_lex_token(context, yylval_param, token->u_string);
+
+            case TOKEN_STRING_LITERAL:
+                yylval_param->TOKEN_STRING_LITERAL = token->u_string;
+                return token->kind;
+
+            case TOKEN_CODE_LITERAL:
+                yylval_param->TOKEN_CODE_LITERAL = token->u_string;
+                return token->kind;
+
+            case TOKEN_LONG_CONSTANT:
+                yylval_param->TOKEN_LONG_CONSTANT = token->u_long;
+                return token->kind;
+
+            case TOKEN_DOUBLE_CONSTANT:
+                yylval_param->TOKEN_DOUBLE_CONSTANT = token->u_double;
+                return token->kind;
+
+            case TOKEN_CHAR_CONSTANT:
+                yylval_param->TOKEN_CHAR_CONSTANT = token->u_char;
+                return token->kind;
+
+            case TOKEN_TRUE:
+                yylval_param->TOKEN_TRUE = token->u_boolean;
+                return token->kind;
+
+            case TOKEN_FALSE:
+                yylval_param->TOKEN_FALSE = token->u_boolean;
+                return token->kind;
+
+            case TOKEN_OP_ASSIGN:
+                yylval_param->TOKEN_OP_ASSIGN = token->u_op_assign;
+                return token->kind;
+
+            default:
+                return token->kind;
+        }
+    }
+    return 0;
+}
\ No newline at end of file
@@ -12,17 +12,267 @@
 #include "codegen/codegen.h" /* code generation */
 #include "misc/memory.h" /* memory allocation */
 #include "misc/string.h"
+#include "misc/timer.h" /* phase timers */
+#include "misc/trace.h" /* trace output */
+#include "misc/stats.h" /* lookup statistics */
 #include "language/parser.h" /* parser */
 #include "language/native/parser.h"
+#include "language/native/batch.h" /* batched native headers */
 #include "language/lexer.h" /* lexer */
+#include "language/context.h" /* parser context */
 #include <stdlib.h>
+#include <unistd.h> /* process functions */
+#include <sys/types.h>
+#include <sys/wait.h> /* process status */
+
+    /* defines */
+/**
+ * Maximum number of parallel compilation workers
+ */
+#define MAX_JOBS 256
+
+    /* typedefs */
+/**
+ * Compilation job of a single input file,
+ * executed in a forked worker process
+ */
+typedef struct compile_job {
+    pid_t pid;
+    FILE* log; /* captured worker output */
+    FILE* times; /* phase times of the worker, NULL without --time-report */
+    int status;
+    bool is_done;
+} compile_job;
+
+    /* global variables */
+/**
+ * Phase times of every compiled file
+ */
+static timer_report timer_all;
+
+    /* internal functions */
+/**
+ * Compiles a single input file
+ * 
+ * @param input  The absolute input filename
+ * @param output The output filename
+ * 
+ * @return true if the output has been written successfully
+ */
+static bool compile_file(char* input, char* output) {
+    memset(&timer_current, 0, sizeof(timer_report));
+    uint64_t start = timer_start();
+    if (memstat_mode) {
+        memstat_reset();
+    }
+    memset(&stats_current, 0, sizeof(stats_report));
+    trace_begin("compile", input);
+
+    /* parse */
+    se_context* context = context_new();
+    context_parse_origin(context, input);
+
+    /* set output */
+    FILE* file = fopen(output, "w");
+    if (file == NULL) {
+        loge("Unable to open file %s for output", output);
+        context_free(context);
+        trace_end();
+        return false;
+    }
+    cg_output buffer;
+    cg_output_init_file(&buffer, file, CG_OUTPUT_FLUSH_SIZE);
+
+    /* do code generation */
+    codegen(&context->ast, &buffer);
+
+    /* close the files */
+    bool result = cg_output_close(&buffer);
+    if (!result) {
+        loge("Unable to write to file %s", output);
+    }
+    if (fclose(file) != 0) {
+        result = false;
+    }
+
+    /* the arena peak is reached before the syntax tree is released */
+    if (memstat_mode) {
+        memstat_print(stderr, input);
+    }
+    if (stats_mode) {
+        stats_print(stderr, input, &context->ast);
+    }
+
+    /* release the syntax tree */
+    context_free(context);
+    trace_end();
+
+    if (timer_mode) {
+        timer_current.total = timer_now() - start;
+        timer_report_print(stderr, input, &timer_current);
+        timer_report_add(&timer_all, &timer_current);
+    }
+    return result;
+}
+
+/**
+ * Forks a worker process which compiles
+ * a single input file and captures its
+ * output into a temporary file
+ * 
+ * Every worker has its own copy of the
+ * global state such as the primitive list,
+ * and a fatal error only terminates the worker
+ * 
+ * @param job    Pointer to the job
+ * @param input  The absolute input filename
+ * @param output The output filename
+ */
+static void compile_job_start(compile_job* job, char* input, char* output) {
+    job->log = tmpfile();
+    if (job->log == NULL) {
+        logfe("Unable to create a temporary file for the compilation of %s", input);
+    }
+    job->times = NULL;
+    if (timer_mode && (job->times = tmpfile()) == NULL) {
+        logfe("Unable to create a temporary file for the compilation of %s", input);
+    }
+    job->is_done = false;
+
+    /* pending buffered output must not be duplicated */
+    fflush(stdout);
+    fflush(stderr);
+
+    job->pid = fork();
+    if (job->pid == -1) {
+        logfe("Unable to start a worker process for the compilation of %s", input);
+    }
+    if (job->pid == 0) {
+        dup2(fileno(job->log), STDOUT_FILENO);
+        dup2(fileno(job->log), STDERR_FILENO);
+        trace_name_process(cst_strconcat("worker ", input));
+        bool result = compile_file(input, output);
+        if (job->times != NULL) {
+            fwrite(&timer_current, sizeof(timer_report), 1, job->times);
+            fflush(job->times);
+        }
+        exit(result ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+}
+
+/**
+ * Waits for any running worker to finish
+ * 
+ * @param jobs  The job list
+ * @param count Number of started jobs
+ */
+static void compile_job_wait(compile_job* jobs, size_t count) {
+    int status;
+    pid_t pid = wait(&status);
+    if (pid == -1) {
+        logfe("Unable to wait for a worker process");
+    }
+
+    iterate_array(i, count) {
+        if (jobs[i].pid == pid && !jobs[i].is_done) {
+            jobs[i].status = status;
+            jobs[i].is_done = true;
+            return;
+        }
+    }
+    logfe("Unknown worker process %d has exited", (int) pid);
+}
+
+/**
+ * Replays the captured output of a finished
+ * worker and releases the job
+ * 
+ * @param job   Pointer to the job
+ * @param input The input filename
+ * 
+ * @return true if the worker has succeeded
+ */
+static bool compile_job_finish(compile_job* job, char* input) {
+    char buffer[4096];
+    size_t length;
+
+    fflush(stderr);
+    rewind(job->log);
+    while ((length = fread(buffer, 1, sizeof(buffer), job->log)) != 0) {
+        fwrite(buffer, 1, length, stderr);
+    }
+    fclose(job->log);
+
+    /* the worker times are added to the report of the whole run */
+    if (job->times != NULL) {
+        timer_report times;
+        rewind(job->times);
+        if (fread(&times, sizeof(timer_report), 1, job->times) == 1) {
+            timer_report_add(&timer_all, &times);
+        }
+        fclose(job->times);
+    }
+
+    if (WIFEXITED(job->status) && WEXITSTATUS(job->status) == EXIT_SUCCESS) {
+        return true;
+    }
+    if (WIFSIGNALED(job->status)) {
+        loge("Compilation of %s was terminated by signal %d", input, WTERMSIG(job->status));
+    } else {
+        loge("Compilation of %s has failed", input);
+    }
+    return false;
+}
+
+/**
+ * Compiles the input files in parallel
+ * using forked worker processes
+ * 
+ * The worker output is reported in the order of
+ * input files regardless of the completion order
+ * 
+ * @param inputs  The absolute input filenames
+ * @param outputs The output filenames
+ * @param count   Number of input files
+ * @param jobs    Maximum number of parallel workers
+ * 
+ * @return true if every file has been compiled successfully
+ */
+static bool compile_parallel(char** inputs, char** outputs, size_t count, size_t jobs) {
+    compile_job* list = checked_malloc(sizeof(compile_job) * count);
+    size_t started = 0, running = 0, reported = 0;
+    bool result = true;
+
+    while (reported < count) {
+        /* keep the pool full */
+        while (running < jobs && started < count) {
+            compile_job_start(&list[started], inputs[started], outputs[started]);
+            started++;
+            running++;
+        }
+
+        compile_job_wait(list, started);
+        running--;
+
+        /* report finished jobs in order */
+        while (reported < started && list[reported].is_done) {
+            if (!compile_job_finish(&list[reported], inputs[reported])) {
+                result = false;
+            }
+            reported++;
+        }
+    }
+
+    free(list);
+    return result;
+}
 
     /* functions */
 /**
  * Compiler entrypoint
  * 
  * @param argc Argument count (at least 2)
- * @param argv Arguments (compiler action and files)
+ * @param argv Arguments (compiler action, files and options)
  */
 int main(int argc, char* argv[]) {
     //cyydebug = 1;
@@ -46,12 +296,64 @@ int main(int argc, char* argv[]) {
 
     /* add input files */
     bool output_specified = false;
+    size_t jobs = 1;
     iterate_range_single(i, 2, argc) {
         if (!output_specified) {
             if (strncmp(argv[i], "-o", sizeof("-o")) == 0) {
                 output_specified = true;
                 continue;
             }
+            if (strncmp(argv[i], "-j", 2) == 0) {
+                char* count = argv[i] + 2;
+                if (*count == '\0') {
+                    if (++i >= argc) {
+                        logfe("Please specify the number of parallel jobs after -j");
+                    }
+                    count = argv[i];
+                }
+                char* end;
+                long value = strtol(count, &end, 10);
+                if (*end != '\0' || value < 1 || value > MAX_JOBS) {
+                    logfe("Invalid number of parallel jobs: %s, must be from 1 to %d", count, MAX_JOBS);
+                }
+                jobs = value;
+                continue;
+            }
+            if (strncmp(argv[i], "--native-batch", sizeof("--native-batch")) == 0) {
+                native_batch_mode = true;
+                continue;
+            }
+            if (strncmp(argv[i], "--time-report", sizeof("--time-report")) == 0) {
+                timer_mode = true;
+                continue;
+            }
+            if (strncmp(argv[i], "--mem-report", sizeof("--mem-report")) == 0) {
+                memstat_mode = true;
+                continue;
+            }
+            if (strncmp(argv[i], "--stats", sizeof("--stats")) == 0) {
+                stats_mode = true;
+                continue;
+            }
+            if (strncmp(argv[i], "--trace", sizeof("--trace")) == 0) {
+                if (++i >= argc) {
+                    logfe("Please specify the trace filename after --trace");
+                }
+                if (!trace_open(argv[i])) {
+                    logfe("Unable to create the trace file %s", argv[i]);
+                }
+                trace_name_process("carbonsteel");
+                continue;
+            }
+            if (strncmp(argv[i], "--log", sizeof("--log")) == 0) {
+                if (++i >= argc) {
+                    logfe("Please specify the message categories after --log");
+                }
+                if (!log_enable(argv[i])) {
+                    logfe("Unknown message category in %s, must be one of: lexer, parser, import, native, codegen, all", argv[i]);
+                }
+                continue;
+            }
             char* filename =  realpath(argv[i], NULL);
             arl_add(char_ptr, input_files, filename);
             if (filename == NULL) {
@@ -73,25 +375,21 @@ int main(int argc, char* argv[]) {
     }
 
     /* compile each file */
-    iterate_array(i, input_files.size) {
-        /* parse */
-        se_context* context = context_new();
-        context_parse_origin(context, input_files.data[i]);
-
-        /* set output */
-        FILE* output = fopen(output_files.data[i], "w");
-        if (output == NULL) {
-            loge("Unable to open file %s for output", output_files.data[i]);
-            continue;
+    bool result = true;
+    if (jobs > 1 && input_files.size > 1) {
+        result = compile_parallel(input_files.data, output_files.data, input_files.size, jobs);
+    } else {
+        iterate_array(i, input_files.size) {
+            if (!compile_file(input_files.data[i], output_files.data[i])) {
+                result = false;
+            }
         }
+    }
 
-        /* do code generation */
-        codegen(&context->ast, output);
-
-        /* close the files */
-        fclose(output);
+    /* the total is the sum of the files, not the wall time of parallel workers */
+    if (timer_mode && input_files.size > 1) {
+        timer_report_print(stderr, "all files", &timer_all);
     }
 
-    /* success */
-    return 0;
+    return result ? EXIT_SUCCESS : EXIT_FAILURE;
 }
\ No newline at end of file
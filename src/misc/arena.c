@@ -0,0 +1,171 @@
+/**
+ * @file arena.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Region (bump) allocator implementation
+ */
+    /* includes */
+#include "misc/arena.h" /* this */
+
+#include <string.h> /* string functions */
+
+#include "misc/memory.h" /* checked allocation */
+
+    /* global variables */
+/**
+ * Process-wide arena for data that outlives
+ * any parser context, such as the primitive list
+ */
+static mem_arena arena_global;
+
+/**
+ * The arena used by allocate(), allocate_array() and copy_string()
+ */
+mem_arena* arena_current = &arena_global;
+
+    /* internal functions */
+/**
+ * Rounds a size up to the arena alignment
+ *
+ * @param[in] size The size
+ *
+ * @return The aligned size
+ */
+static inline size_t arena_align(size_t size) {
+    return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+/**
+ * Prepends a new chunk which is able
+ * to hold at least the specified size
+ *
+ * @param[in] arena Pointer to the arena
+ * @param[in] size  The requested size
+ */
+static void arena_grow(mem_arena* arena, size_t size) {
+    size_t chunk_size = ARENA_CHUNK_SIZE;
+    if (arena->head != NULL) {
+        chunk_size = arena->head->size * 2;
+        if (chunk_size > ARENA_CHUNK_SIZE_MAX) {
+            chunk_size = ARENA_CHUNK_SIZE_MAX;
+        }
+    }
+    if (chunk_size < size) {
+        chunk_size = size;
+    }
+
+    mem_arena_chunk* chunk = checked_malloc(sizeof(mem_arena_chunk) + chunk_size);
+    if (memstat_mode) {
+        memstat_chunk(chunk_size);
+    }
+    chunk->next = arena->head;
+    chunk->size = chunk_size;
+    chunk->used = 0;
+    arena->head = chunk;
+}
+
+    /* functions */
+/**
+ * Initializes an empty arena
+ *
+ * @param[out] arena Pointer to the arena
+ */
+void arena_init(mem_arena* arena) {
+    arena->head = NULL;
+    arena->total = 0;
+}
+
+/**
+ * Allocates an aligned memory region from the arena
+ * or throws an internal error on failure
+ *
+ * @param[in] arena Pointer to the arena
+ * @param[in] size  The size of memory region
+ *
+ * @return The allocated memory region
+ */
+void* arena_allocate(mem_arena* arena, size_t size) {
+    size = arena_align(size);
+    if (arena->head == NULL || arena->head->size - arena->head->used < size) {
+        arena_grow(arena, size);
+    }
+
+    void* result = arena->head->data + arena->head->used;
+    arena->head->used += size;
+    arena->total += size;
+    return result;
+}
+
+/**
+ * Duplicates a string into the arena
+ *
+ * @param[in] arena  Pointer to the arena
+ * @param[in] string The string
+ *
+ * @return Copy of the string
+ */
+char* arena_copy_string(mem_arena* arena, const char* string) {
+    size_t length = strlen(string) + 1;
+    char* result = arena_allocate(arena, length);
+    memcpy(result, string, length);
+    return result;
+}
+
+/**
+ * Discards all allocations, but keeps the
+ * most recent chunk for reuse
+ *
+ * @param[in] arena Pointer to the arena
+ */
+void arena_reset(mem_arena* arena) {
+    if (arena->head == NULL) {
+        return;
+    }
+
+    mem_arena_chunk* chunk = arena->head->next;
+    while (chunk != NULL) {
+        mem_arena_chunk* next = chunk->next;
+        if (memstat_mode) {
+            memstat_chunk(-(long long) chunk->size);
+        }
+        free(chunk);
+        chunk = next;
+    }
+    arena->head->next = NULL;
+    arena->head->used = 0;
+    arena->total = 0;
+}
+
+/**
+ * Releases all chunks of the arena
+ *
+ * @param[in] arena Pointer to the arena
+ */
+void arena_free(mem_arena* arena) {
+    mem_arena_chunk* chunk = arena->head;
+    while (chunk != NULL) {
+        mem_arena_chunk* next = chunk->next;
+        if (memstat_mode) {
+            memstat_chunk(-(long long) chunk->size);
+        }
+        free(chunk);
+        chunk = next;
+    }
+    arena_init(arena);
+}
+
+/**
+ * Makes the specified arena current,
+ * or restores the process-wide arena if NULL is given
+ *
+ * @param[in] arena Pointer to the arena or NULL
+ *
+ * @return The previously selected arena
+ */
+mem_arena* arena_select(mem_arena* arena) {
+    mem_arena* previous = arena_current;
+    arena_current = (arena != NULL) ? arena : &arena_global;
+    return previous;
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+/**
+ * @file cache.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Location of the persistent compiler caches implementation
+ */
+    /* includes */
+#include "misc/cache.h" /* this */
+
+#include <stdlib.h>
+#include <stdbool.h> /* boolean */
+#include <stdio.h> /* string formatting */
+#include <string.h> /* string functions */
+#include <errno.h> /* error codes */
+#include <limits.h> /* path length */
+#include <sys/stat.h> /* directory creation */
+
+#include "misc/memory.h" /* memory allocation */
+
+    /* internal functions */
+/**
+ * Creates a directory and all of its parents
+ *
+ * @param[in] path The directory path
+ *
+ * @return false if the directory could not be created
+ */
+static bool cache_mkdir(char* path) {
+    char buffer[PATH_MAX];
+    if (snprintf(buffer, sizeof(buffer), "%s", path) >= (int) sizeof(buffer)) {
+        return false;
+    }
+
+    for (char* p = buffer + 1; *p != '\0'; p++) {
+        if (*p == '/') {
+            *p = '\0';
+            if (mkdir(buffer, 0755) != 0 && errno != EEXIST) {
+                return false;
+            }
+            *p = '/';
+        }
+    }
+    return mkdir(buffer, 0755) == 0 || errno == EEXIST;
+}
+
+    /* functions */
+/**
+ * Creates a named cache directory inside the cache root
+ *
+ * @param[in] name Name of the cache
+ *
+ * @return Path to the directory allocated by malloc,
+ *         or NULL if the cache is disabled or unavailable
+ */
+char* cache_directory(const char* name) {
+    char buffer[PATH_MAX];
+    char* value = getenv("CARBONSTEEL_CACHE_DIR");
+    int length = -1;
+    if (value != NULL) {
+        length = snprintf(buffer, sizeof(buffer), "%s/%s", value, name);
+        if (*value == '\0') {
+            length = -1;
+        }
+    } else if ((value = getenv("XDG_CACHE_HOME")) != NULL && *value != '\0') {
+        length = snprintf(buffer, sizeof(buffer), "%s/carbonsteel/%s", value, name);
+    } else if ((value = getenv("HOME")) != NULL && *value != '\0') {
+        length = snprintf(buffer, sizeof(buffer), "%s/.cache/carbonsteel/%s", value, name);
+    }
+
+    if (length <= 0 || length >= (int) sizeof(buffer) || !cache_mkdir(buffer)) {
+        log_debug(LOG_IMPORT, "%s cache is disabled", name);
+        return NULL;
+    }
+
+    char* result = checked_malloc(length + 1);
+    memcpy(result, buffer, length + 1);
+    return result;
+}
\ No newline at end of file
@@ -12,7 +12,11 @@
 #include "syntax/declaration/declaration.h"  /* declarations */
 #include "syntax/statement/statement.h"  /* statement */
 #include "ast/type/primitive.h" /* primitives */
+#include "ast/type/layout.h" /* type layouts */
 #include "language/native/types.h"
+#include "language/scope.h" /* scope bindings */
+#include "language/module.h" /* module cache */
+#include "ast/root.h" /* shared values */
 
     /* generic implementations */
 list_define(st_compound_item);
@@ -21,10 +25,12 @@ arraylist_define(statement);
 arraylist_define(local_declaration);
 list_define(ast_type_primitive);
 arraylist_define(ast_type_level);
+arraylist_define(ast_layout);
 arraylist_define(ast_type);
 list_define(ast_type);
 arraylist_define(list(ast_type));
 arraylist_define(se_context_level);
+arraylist_define(se_scope_binding);
 list_define(dc_structure_member);
 list_define(dc_enum_member);
 list_define(dc_function_parameter);
@@ -38,10 +44,13 @@ arraylist_define(dc_structure_member);
 arraylist_define(dc_enum_member);
 arraylist_define(dc_function_parameter);
 arraylist_define(dc_import_node);
+arraylist_define(dc_import_ptr);
 arraylist_define(declaration_ptr);
 arraylist_define(declaration);
+arraylist_define(ast_shared_value);
 arraylist_define(op_unary);
 arraylist_define(se_context_import_file_ptr);
+arraylist_define(se_module_ptr);
 arraylist_define(char_ptr)
 arraylist_define(c_declarator);
 arraylist_define(c_declaration);
@@ -0,0 +1,156 @@
+/**
+ * @file intern.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ *  Global string interning table implementation
+ */
+    /* includes */
+#include "misc/intern.h" /* this */
+
+#include <string.h> /* string functions */
+
+#include "misc/hash.h"   /* string hashing */
+#include "misc/arena.h"  /* string storage */
+#include "misc/memory.h" /* checked allocation */
+
+    /* defines */
+/**
+ * Initial slot count of the table, must be a power of two
+ */
+#define INTERN_INITIAL_CAPACITY 4096
+
+    /* global variables */
+/**
+ * Storage of the interned strings, never released
+ */
+static mem_arena intern_arena;
+
+/**
+ * Open-addressing table of interned strings
+ * with linear probing, kept at most half full
+ */
+static char** intern_table = NULL;
+static size_t intern_capacity = 0;
+static size_t intern_count = 0;
+
+    /* internal functions */
+/**
+ * Finds the slot of a string or the
+ * empty slot where it should be inserted
+ * 
+ * @param[in] string The string
+ * @param[in] length Length of the string
+ * @param[in] hash   Hash of the string
+ * 
+ * @return Pointer to the slot
+ */
+static char** intern_probe(const char* string, size_t length, uint64_t hash) {
+    size_t mask = intern_capacity - 1;
+    size_t index = hash & mask;
+    while (intern_table[index] != NULL) {
+        char* current = intern_table[index];
+        if (intern_hash(current) == hash
+                && intern_length(current) == length
+                && memcmp(current, string, length) == 0) {
+            break;
+        }
+        index = (index + 1) & mask;
+    }
+    return &intern_table[index];
+}
+
+/**
+ * Doubles the capacity of the table
+ * and reinserts every string
+ */
+static void intern_grow() {
+    char** old_table = intern_table;
+    size_t old_capacity = intern_capacity;
+
+    intern_capacity = (old_capacity == 0) ? INTERN_INITIAL_CAPACITY : old_capacity * 2;
+    intern_table = calloc(intern_capacity, sizeof(char*));
+    if (intern_table == NULL) {
+        error_internal("failed to grow the string table to %zu entries", intern_capacity);
+    }
+
+    size_t mask = intern_capacity - 1;
+    for (size_t i = 0; i < old_capacity; i++) {
+        char* current = old_table[i];
+        if (current != NULL) {
+            size_t index = intern_hash(current) & mask;
+            while (intern_table[index] != NULL) {
+                index = (index + 1) & mask;
+            }
+            intern_table[index] = current;
+        }
+    }
+    free(old_table);
+}
+
+    /* functions */
+/**
+ * Returns the unique copy of a string
+ * with specified length, adding it
+ * to the table if needed
+ * 
+ * @param[in] string The string, not necessarily null-terminated
+ * @param[in] length Length of the string
+ * 
+ * @return The interned string
+ */
+char* intern_string_length(const char* string, size_t length) {
+    if ((intern_count + 1) * 2 > intern_capacity) {
+        intern_grow();
+    }
+
+    uint64_t hash = hash_bytes(string, length);
+    char** slot = intern_probe(string, length, hash);
+    if (*slot != NULL) {
+        return *slot;
+    }
+
+    /* store the header and the characters */
+    intern_header* header = arena_allocate(&intern_arena, sizeof(intern_header) + length + 1);
+    if (memstat_mode) {
+        memstat_count("char", sizeof(intern_header) + length + 1, MEMSTAT_SITE);
+    }
+    header->hash = hash;
+    header->length = length;
+    char* result = (char*) (header + 1);
+    memcpy(result, string, length);
+    result[length] = 0;
+
+    *slot = result;
+    intern_count++;
+    return result;
+}
+
+/**
+ * Returns the unique copy of a string,
+ * adding it to the table if needed
+ * 
+ * @param[in] string The string
+ * 
+ * @return The interned string
+ */
+char* intern_string(const char* string) {
+    return intern_string_length(string, strlen(string));
+}
+
+/**
+ * Finds the unique copy of a string
+ * without adding it to the table
+ * 
+ * @param[in] string The string
+ * 
+ * @return The interned string or NULL if it has never been interned
+ */
+char* intern_find(const char* string) {
+    if (intern_capacity == 0) {
+        return NULL;
+    }
+    size_t length = strlen(string);
+    return *intern_probe(string, length, hash_bytes(string, length));
+}
\ No newline at end of file
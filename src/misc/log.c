@@ -0,0 +1,67 @@
+/**
+ * @file log.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Filtered diagnostic logging implementation
+ */
+    /* includes */
+#include "misc/log.h" /* this */
+
+#include <string.h> /* string functions */
+
+    /* global variables */
+/**
+ * Enabled message categories, set by --log
+ */
+unsigned log_categories = 0;
+
+/**
+ * Names of the categories for --log
+ */
+static const struct {
+    const char* name;
+    unsigned category;
+} log_category_names[] = {
+    { "lexer",   LOG_LEXER },
+    { "parser",  LOG_PARSER },
+    { "import",  LOG_IMPORT },
+    { "native",  LOG_NATIVE },
+    { "codegen", LOG_CODEGEN },
+    { "all",     LOG_ALL }
+};
+
+    /* functions */
+/**
+ * Enables the message categories of a comma-separated
+ * list, such as "lexer,native" or "all"
+ *
+ * @param[in] list The category list
+ *
+ * @return false if a category is unknown
+ */
+bool log_enable(const char* list) {
+    unsigned categories = 0;
+    while (*list != '\0') {
+        size_t length = strcspn(list, ",");
+        size_t i = 0;
+        for (; i < sizeof(log_category_names) / sizeof(*log_category_names); i++) {
+            if (strlen(log_category_names[i].name) == length
+                    && strncmp(log_category_names[i].name, list, length) == 0) {
+                break;
+            }
+        }
+        if (i == sizeof(log_category_names) / sizeof(*log_category_names)) {
+            return false;
+        }
+        categories |= log_category_names[i].category;
+
+        list += length;
+        if (*list == ',') {
+            list++;
+        }
+    }
+    log_categories |= categories;
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,359 @@
+/**
+ * @file memstat.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Allocation statistics implementation
+ */
+    /* includes */
+#include "misc/memstat.h" /* this */
+
+#include <stdint.h> /* integer types */
+#include <string.h> /* string functions */
+#include <stdlib.h> /* sorting */
+#include <sys/resource.h> /* resource usage */
+
+#include "misc/memory.h" /* checked allocation */
+
+    /* defines */
+/**
+ * Number of files and call sites in the report
+ */
+#define MEMSTAT_REPORT_SIZE 16
+
+/**
+ * Capacity of the call site table, a power of two
+ */
+#define MEMSTAT_SITE_CAPACITY 4096
+
+    /* typedefs */
+/**
+ * Allocation counter
+ */
+typedef struct memstat_counter {
+    uint64_t count;
+    uint64_t bytes;
+} memstat_counter;
+
+/**
+ * Allocations of a parsed file
+ */
+typedef struct memstat_file {
+    char* filename;
+    bool is_native;
+    memstat_counter counter;
+} memstat_file;
+
+/**
+ * Allocations of a call site
+ */
+typedef struct memstat_site {
+    const char* file;
+    int line;
+    memstat_counter counter;
+} memstat_site;
+
+    /* global variables */
+/**
+ * Enables the allocation statistics, set by --mem-report
+ */
+bool memstat_mode = false;
+
+/**
+ * Allocations by category and by phase
+ */
+static memstat_counter memstat_categories[MEMSTAT_CATEGORY_COUNT];
+static memstat_counter memstat_phases[MEMSTAT_PHASE_COUNT];
+
+/**
+ * Memory held by arena chunks, its peak
+ * and the peak of every phase
+ */
+static uint64_t memstat_live = 0;
+static uint64_t memstat_peak = 0;
+static uint64_t memstat_phase_peaks[MEMSTAT_PHASE_COUNT];
+
+/**
+ * The current phase and scope
+ */
+static memstat_phase memstat_current_phase = MEMSTAT_PHASE_SETUP;
+static memstat_scope memstat_current = { 0, false };
+
+/**
+ * Allocations by file, the allocations
+ * outside of any file are not attributed
+ */
+static memstat_file* memstat_files = NULL;
+static size_t memstat_file_count = 0;
+static size_t memstat_file_capacity = 0;
+
+/**
+ * Allocations by call site
+ */
+static memstat_site memstat_sites[MEMSTAT_SITE_CAPACITY];
+
+/**
+ * Names of the categories and phases in the report
+ */
+static const char* memstat_category_names[MEMSTAT_CATEGORY_COUNT] = {
+    [MEMSTAT_DECLARATION] = "declarations",
+    [MEMSTAT_TYPE]        = "types",
+    [MEMSTAT_LEVEL_LIST]  = "type levels",
+    [MEMSTAT_EXPRESSION]  = "expressions",
+    [MEMSTAT_STATEMENT]   = "statements",
+    [MEMSTAT_STRING]      = "strings",
+    [MEMSTAT_NATIVE]      = "native declarations",
+    [MEMSTAT_CODEGEN]     = "codegen temporaries",
+    [MEMSTAT_OTHER]       = "other"
+};
+static const char* memstat_phase_names[MEMSTAT_PHASE_COUNT] = {
+    [MEMSTAT_PHASE_SETUP]   = "setup",
+    [MEMSTAT_PHASE_PASS_1]  = "pass 1",
+    [MEMSTAT_PHASE_PASS_2]  = "pass 2",
+    [MEMSTAT_PHASE_PASS_3]  = "pass 3",
+    [MEMSTAT_PHASE_CODEGEN] = "codegen"
+};
+
+    /* internal functions */
+/**
+ * Checks if a type name starts with a prefix
+ */
+#define memstat_prefix(type, prefix) (strncmp(type, prefix, sizeof(prefix) - 1) == 0)
+
+/**
+ * Determines the category of an allocation
+ *
+ * @param[in] type Name of the allocated type
+ *
+ * @return The category
+ */
+static memstat_category memstat_classify(const char* type) {
+    if (strcmp(type, "char") == 0) {
+        return MEMSTAT_STRING;
+    }
+    if (memstat_current_phase == MEMSTAT_PHASE_CODEGEN) {
+        return MEMSTAT_CODEGEN;
+    }
+    if (memstat_current.is_native) {
+        return MEMSTAT_NATIVE;
+    }
+    if (memstat_prefix(type, "ast_type_level")) {
+        return MEMSTAT_LEVEL_LIST;
+    }
+    if (memstat_prefix(type, "ast_type") || memstat_prefix(type, "ast_layout")) {
+        return MEMSTAT_TYPE;
+    }
+    if (memstat_prefix(type, "dc_") || memstat_prefix(type, "declaration") || memstat_prefix(type, "local_declaration")) {
+        return MEMSTAT_DECLARATION;
+    }
+    if (memstat_prefix(type, "ex_") || memstat_prefix(type, "expression")) {
+        return MEMSTAT_EXPRESSION;
+    }
+    if (memstat_prefix(type, "st_") || memstat_prefix(type, "statement")) {
+        return MEMSTAT_STATEMENT;
+    }
+    if (memstat_prefix(type, "c_")) {
+        return MEMSTAT_NATIVE;
+    }
+    return MEMSTAT_OTHER;
+}
+
+/**
+ * Adds an allocation to a counter
+ */
+static inline void memstat_add(memstat_counter* counter, size_t size) {
+    counter->count++;
+    counter->bytes += size;
+}
+
+/**
+ * Adds an allocation to its call site
+ *
+ * @param[in] file Source file of the call site
+ * @param[in] line Source line of the call site
+ * @param[in] size Size of the allocation
+ */
+static void memstat_add_site(const char* file, int line, size_t size) {
+    size_t mask = MEMSTAT_SITE_CAPACITY - 1;
+    size_t index = ((uintptr_t) file * 31 + line) & mask;
+    for (size_t i = 0; i < MEMSTAT_SITE_CAPACITY; i++) {
+        memstat_site* site = &memstat_sites[(index + i) & mask];
+        if (site->file == NULL) {
+            site->file = file;
+            site->line = line;
+        }
+        if (site->file == file && site->line == line) {
+            memstat_add(&site->counter, size);
+            return;
+        }
+    }
+}
+
+/**
+ * Orders files and call sites by their allocated bytes, descending
+ */
+static int memstat_compare_files(const void* a, const void* b) {
+    uint64_t x = ((const memstat_file*) a)->counter.bytes, y = ((const memstat_file*) b)->counter.bytes;
+    return (x < y) - (x > y);
+}
+static int memstat_compare_sites(const void* a, const void* b) {
+    uint64_t x = ((const memstat_site*) a)->counter.bytes, y = ((const memstat_site*) b)->counter.bytes;
+    return (x < y) - (x > y);
+}
+
+    /* functions */
+/**
+ * Counts an allocation
+ *
+ * @param[in] type Name of the allocated type
+ * @param[in] size Size of the allocation
+ * @param[in] file Source file of the call site or NULL
+ * @param[in] line Source line of the call site
+ */
+void memstat_count(const char* type, size_t size, const char* file, int line) {
+    memstat_add(&memstat_categories[memstat_classify(type)], size);
+    memstat_add(&memstat_phases[memstat_current_phase], size);
+    if (memstat_current.file < memstat_file_count) {
+        memstat_add(&memstat_files[memstat_current.file].counter, size);
+    }
+    if (file != NULL) {
+        memstat_add_site(file, line, size);
+    }
+}
+
+/**
+ * Counts the memory of a new arena chunk,
+ * or of a released one if the size is negative
+ *
+ * @param[in] size Size of the chunk
+ */
+void memstat_chunk(long long size) {
+    memstat_live += size;
+    if (memstat_live > memstat_peak) {
+        memstat_peak = memstat_live;
+    }
+    if (memstat_live > memstat_phase_peaks[memstat_current_phase]) {
+        memstat_phase_peaks[memstat_current_phase] = memstat_live;
+    }
+}
+
+/**
+ * Starts a compilation phase
+ *
+ * @param[in] phase The phase
+ */
+void memstat_enter_phase(memstat_phase phase) {
+    memstat_current_phase = phase;
+    if (memstat_live > memstat_phase_peaks[phase]) {
+        memstat_phase_peaks[phase] = memstat_live;
+    }
+}
+
+/**
+ * Attributes the next allocations to a file
+ *
+ * @param[in] filename  Interned name of the file
+ * @param[in] is_native Marks native headers
+ *
+ * @return The previous scope
+ */
+memstat_scope memstat_enter_file(char* filename, bool is_native) {
+    memstat_scope previous = memstat_current;
+    if (!memstat_mode) {
+        return previous;
+    }
+
+    size_t index = 0;
+    while (index < memstat_file_count && (memstat_files[index].filename != filename
+            || memstat_files[index].is_native != is_native)) {
+        index++;
+    }
+    if (index == memstat_file_count) {
+        if (memstat_file_count == memstat_file_capacity) {
+            memstat_file_capacity = memstat_file_capacity != 0 ? memstat_file_capacity * 2 : 64;
+            memstat_files = checked_realloc(memstat_files, sizeof(memstat_file) * memstat_file_capacity);
+        }
+        memstat_file* file = &memstat_files[memstat_file_count++];
+        file->filename = filename;
+        file->is_native = is_native;
+        memset(&file->counter, 0, sizeof(memstat_counter));
+    }
+
+    memstat_current.file = index;
+    memstat_current.is_native = is_native;
+    return previous;
+}
+
+/**
+ * Restores the scope replaced by memstat_enter_file
+ *
+ * @param[in] scope The previous scope
+ */
+void memstat_exit_file(memstat_scope scope) {
+    memstat_current = scope;
+}
+
+/**
+ * Discards the statistics of the previous compilation
+ */
+void memstat_reset() {
+    memset(memstat_categories, 0, sizeof(memstat_categories));
+    memset(memstat_phases, 0, sizeof(memstat_phases));
+    memset(memstat_phase_peaks, 0, sizeof(memstat_phase_peaks));
+    memset(memstat_sites, 0, sizeof(memstat_sites));
+    memstat_peak = memstat_live;
+    memstat_current_phase = MEMSTAT_PHASE_SETUP;
+    memstat_file_count = 0;
+    memstat_current.file = 0;
+    memstat_current.is_native = false;
+}
+
+/**
+ * Prints the allocation report
+ *
+ * @param[in] output The output file
+ * @param[in] title  Title of the report, such as the input filename
+ */
+void memstat_print(FILE* output, const char* title) {
+    fprintf(output, "memory report: %s\n", title);
+    fprintf(output, "  %-24s %12s %14s\n", "category", "count", "bytes");
+    for (int i = 0; i < MEMSTAT_CATEGORY_COUNT; i++) {
+        if (memstat_categories[i].count != 0) {
+            fprintf(output, "  %-24s %12llu %14llu\n", memstat_category_names[i],
+                (unsigned long long) memstat_categories[i].count, (unsigned long long) memstat_categories[i].bytes);
+        }
+    }
+
+    fprintf(output, "  %-24s %12s %14s %14s\n", "phase", "count", "bytes", "peak");
+    for (int i = 0; i < MEMSTAT_PHASE_COUNT; i++) {
+        fprintf(output, "  %-24s %12llu %14llu %14llu\n", memstat_phase_names[i],
+            (unsigned long long) memstat_phases[i].count, (unsigned long long) memstat_phases[i].bytes,
+            (unsigned long long) memstat_phase_peaks[i]);
+    }
+
+    /* the largest files */
+    qsort(memstat_files, memstat_file_count, sizeof(memstat_file), memstat_compare_files);
+    fprintf(output, "  %-24s %12s %14s\n", "file", "count", "bytes");
+    for (size_t i = 0; i < memstat_file_count && i < MEMSTAT_REPORT_SIZE; i++) {
+        memstat_file* file = &memstat_files[i];
+        fprintf(output, "  %s%s\n  %-24s %12llu %14llu\n", file->is_native ? "native " : "", file->filename, "",
+            (unsigned long long) file->counter.count, (unsigned long long) file->counter.bytes);
+    }
+
+    /* the largest call sites */
+    qsort(memstat_sites, MEMSTAT_SITE_CAPACITY, sizeof(memstat_site), memstat_compare_sites);
+    if (memstat_sites[0].file != NULL) {
+        fprintf(output, "  %-24s %12s %14s\n", "call site", "count", "bytes");
+        for (size_t i = 0; i < MEMSTAT_REPORT_SIZE && memstat_sites[i].file != NULL; i++) {
+            memstat_site* site = &memstat_sites[i];
+            fprintf(output, "  %s:%d\n  %-24s %12llu %14llu\n", site->file, site->line, "",
+                (unsigned long long) site->counter.count, (unsigned long long) site->counter.bytes);
+        }
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    fprintf(output, "  %-24s %27llu\n", "arena peak", (unsigned long long) memstat_peak);
+    fprintf(output, "  %-24s %27llu\n", "resident peak", (unsigned long long) usage.ru_maxrss * 1024);
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+/**
+ * @file scan.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Vectorized byte search for the lexer fast paths implementation
+ */
+    /* includes */
+#include "misc/scan.h" /* this */
+
+#include <stdbool.h> /* boolean */
+#include <stdint.h> /* integer types */
+#include <string.h> /* string functions */
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h> /* vector intrinsics */
+#define SCAN_X86
+#endif
+
+    /* internal functions */
+#ifdef SCAN_X86
+/**
+ * Returns a mask of the bytes of a block which belong to a search set
+ */
+__attribute__((target("sse2")))
+static inline unsigned scan_block_sse2(const __m128i* block, const scan_set* set) {
+    __m128i value = _mm_load_si128(block);
+    __m128i result = _mm_cmpeq_epi8(value, _mm_setzero_si128());
+    for (int i = 0; i < set->count; i++) {
+        result = _mm_or_si128(result, _mm_cmpeq_epi8(value, _mm_set1_epi8(set->bytes[i])));
+    }
+    return (unsigned) _mm_movemask_epi8(result);
+}
+
+/**
+ * Returns a mask of the bytes of a block which belong to a search set
+ */
+__attribute__((target("avx2")))
+static inline uint32_t scan_block_avx2(const __m256i* block, const scan_set* set) {
+    __m256i value = _mm256_load_si256(block);
+    __m256i result = _mm256_cmpeq_epi8(value, _mm256_setzero_si256());
+    for (int i = 0; i < set->count; i++) {
+        result = _mm256_or_si256(result, _mm256_cmpeq_epi8(value, _mm256_set1_epi8(set->bytes[i])));
+    }
+    return (uint32_t) _mm256_movemask_epi8(result);
+}
+
+/**
+ * SSE2 search
+ */
+__attribute__((target("sse2")))
+static char* scan_find_sse2(char* data, const scan_set* set) {
+    /* the first block is aligned down, bytes before the data are masked out */
+    uintptr_t offset = (uintptr_t) data & 15;
+    const __m128i* block = (const __m128i*) (data - offset);
+    unsigned mask = scan_block_sse2(block, set) >> offset;
+    if (mask != 0) {
+        return data + __builtin_ctz(mask);
+    }
+
+    do {
+        block++;
+        mask = scan_block_sse2(block, set);
+    } while (mask == 0);
+    return (char*) block + __builtin_ctz(mask);
+}
+
+/**
+ * AVX2 search
+ */
+__attribute__((target("avx2")))
+static char* scan_find_avx2(char* data, const scan_set* set) {
+    /* the first block is aligned down, bytes before the data are masked out */
+    uintptr_t offset = (uintptr_t) data & 31;
+    const __m256i* block = (const __m256i*) (data - offset);
+    uint32_t mask = scan_block_avx2(block, set) >> offset;
+    if (mask != 0) {
+        return data + __builtin_ctz(mask);
+    }
+
+    do {
+        block++;
+        mask = scan_block_avx2(block, set);
+    } while (mask == 0);
+    return (char*) block + __builtin_ctz(mask);
+}
+#endif
+
+/**
+ * Scalar search
+ */
+static char* scan_find_scalar(char* data, const scan_set* set) {
+    while (!set->is_member[(unsigned char) *data]) {
+        data++;
+    }
+    return data;
+}
+
+    /* functions */
+/**
+ * Initializes a search set
+ *
+ * @param[out] set   Pointer to the set
+ * @param[in]  bytes The bytes, at most SCAN_SET_MAX
+ */
+void scan_set_init(scan_set* set, const char* bytes) {
+    memset(set, 0, sizeof(scan_set));
+    set->is_member[0] = true;
+    for (; *bytes != '\0' && set->count < SCAN_SET_MAX; bytes++) {
+        set->bytes[set->count++] = *bytes;
+        set->is_member[(unsigned char) *bytes] = true;
+    }
+}
+
+/**
+ * Finds the first byte of a null-terminated
+ * buffer which belongs to a search set
+ *
+ * @param[in] data The buffer
+ * @param[in] set  Pointer to the search set
+ *
+ * @return Pointer to the byte, or to the null terminator
+ */
+char* scan_find(char* data, const scan_set* set) {
+#ifdef SCAN_X86
+    /* i386 processors may lack SSE2 as well */
+    static int has_avx2 = -1, has_sse2;
+    if (has_avx2 < 0) {
+        __builtin_cpu_init();
+        has_avx2 = __builtin_cpu_supports("avx2");
+        has_sse2 = __builtin_cpu_supports("sse2");
+    }
+    if (has_avx2) {
+        return scan_find_avx2(data, set);
+    }
+    if (has_sse2) {
+        return scan_find_sse2(data, set);
+    }
+#endif
+    return scan_find_scalar(data, set);
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+/**
+ * @file source.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Memory-mapped source files implementation
+ */
+    /* includes */
+#include "misc/source.h" /* this */
+
+#include <stdlib.h>
+#include <string.h> /* memory functions */
+#include <unistd.h> /* file functions */
+#include <fcntl.h> /* file control */
+#include <sys/mman.h> /* memory mapping */
+#include <sys/stat.h> /* file status */
+
+#include "misc/memory.h" /* memory allocation */
+
+    /* internal functions */
+/**
+ * Reads a whole file into a source buffer
+ *
+ * @param[out] source Pointer to the source buffer
+ * @param[in]  fd     The file descriptor
+ * @param[in]  size   Size of the file
+ *
+ * @return false if the file could not be read
+ */
+static bool source_buffer_read(source_buffer* source, int fd, size_t size) {
+    source->data = checked_malloc(size + SOURCE_BUFFER_SENTINEL);
+    source->size = 0;
+    source->mapped_size = 0;
+
+    while (source->size < size) {
+        ssize_t count = read(fd, source->data + source->size, size - source->size);
+        if (count < 0) {
+            free(source->data);
+            return false;
+        }
+        if (count == 0) {
+            break;
+        }
+        source->size += count;
+    }
+    memset(source->data + source->size, 0, SOURCE_BUFFER_SENTINEL);
+    return true;
+}
+
+    /* functions */
+/**
+ * Maps a file into a source buffer
+ *
+ * @param[out] source   Pointer to the source buffer
+ * @param[in]  filename Name of the file
+ *
+ * @return false if the file could not be opened
+ */
+bool source_buffer_open(source_buffer* source, const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+        return false;
+    }
+    size_t size = status.st_size;
+
+    /* the rest of the last page is zero-filled, the sentinel has to fit into it */
+    size_t page = sysconf(_SC_PAGESIZE);
+    if (size % page != 0 && size % page <= page - SOURCE_BUFFER_SENTINEL) {
+        void* data = mmap(NULL, size + SOURCE_BUFFER_SENTINEL, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            close(fd);
+            source->data = data;
+            source->size = size;
+            source->mapped_size = size + SOURCE_BUFFER_SENTINEL;
+            return true;
+        }
+    }
+
+    bool result = source_buffer_read(source, fd, size);
+    close(fd);
+    return result;
+}
+
+/**
+ * Releases a source buffer
+ *
+ * @param[in] source Pointer to the source buffer
+ */
+void source_buffer_close(source_buffer* source) {
+    if (source->mapped_size != 0) {
+        munmap(source->data, source->mapped_size);
+    } else {
+        free(source->data);
+    }
+    source->data = NULL;
+}
\ No newline at end of file
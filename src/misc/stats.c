@@ -0,0 +1,187 @@
+/**
+ * @file stats.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Symbol table and lookup statistics implementation
+ */
+    /* includes */
+#include "misc/stats.h" /* this */
+
+#include <stdlib.h> /* sorting */
+
+#include "language/parser.h" /* token names */
+
+    /* defines */
+/**
+ * Maximum number of generic structures in a report
+ */
+#define STATS_REPORT_SIZE 16
+
+    /* typedefs */
+/**
+ * A counted entry of a report
+ */
+typedef struct stats_entry {
+    const char* name;
+    uint64_t count;
+} stats_entry;
+
+    /* global variables */
+/**
+ * Enables the statistics, set by --stats
+ */
+bool stats_mode = false;
+
+/**
+ * Counters of the current compilation
+ */
+stats_report stats_current;
+
+    /* internal functions */
+/**
+ * Orders report entries by their count, the largest first
+ */
+static int stats_compare_entries(const void* a, const void* b) {
+    uint64_t ac = ((const stats_entry*) a)->count;
+    uint64_t bc = ((const stats_entry*) b)->count;
+    return ac < bc ? 1 : ac > bc ? -1 : 0;
+}
+
+/**
+ * Prints a count with its percentage of a total
+ *
+ * @param[in] file  The output file
+ * @param[in] name  Name of the count
+ * @param[in] count The count
+ * @param[in] total The total
+ */
+static void stats_print_share(FILE* file, const char* name, uint64_t count, uint64_t total) {
+    double percent = total != 0 ? 100.0 * count / total : 0;
+    fprintf(file, "  %-24s %12llu %6.1f%%\n", name, (unsigned long long) count, percent);
+}
+
+/**
+ * Prints the counted tokens by kind, the most frequent first
+ *
+ * @param[in] file The output file
+ */
+static void stats_print_tokens(FILE* file) {
+    stats_entry entries[STATS_TOKEN_KINDS];
+    size_t count = 0;
+    uint64_t total = 0;
+    for (int i = 0; i < STATS_TOKEN_KINDS; i++) {
+        if (stats_current.tokens[i] != 0) {
+            entries[count].name = myytoken_name(i);
+            entries[count].count = stats_current.tokens[i];
+            total += entries[count].count;
+            count++;
+        }
+    }
+    qsort(entries, count, sizeof(stats_entry), stats_compare_entries);
+
+    fprintf(file, "  %-24s %12s %7s\n", "token", "count", "%");
+    for (size_t i = 0; i < count; i++) {
+        stats_print_share(file, entries[i].name, entries[i].count, total);
+    }
+    fprintf(file, "  %-24s %12llu\n", "total", (unsigned long long) total);
+}
+
+/**
+ * Prints the load and the probe lengths of a symbol table
+ *
+ * @param[in] file  The output file
+ * @param[in] table Pointer to the symbol table
+ */
+static void stats_print_symbol_table(FILE* file, ast_symbol_table* table) {
+    size_t mask = table->capacity - 1;
+    uint64_t total_probes = 0;
+    size_t max_probes = 0;
+    for (size_t i = 0; i < table->capacity; i++) {
+        if (table->data[i].key != NULL) {
+            /* the number of slots visited by a successful lookup */
+            size_t probes = ((i - (table->data[i].hash & mask)) & mask) + 1;
+            total_probes += probes;
+            if (probes > max_probes) {
+                max_probes = probes;
+            }
+        }
+    }
+
+    fprintf(file, "  %-24s %12zu\n", "symbols", table->size);
+    fprintf(file, "  %-24s %12zu\n", "capacity", table->capacity);
+    fprintf(file, "  %-24s %11.1f%%\n", "fill ratio",
+        table->capacity != 0 ? 100.0 * table->size / table->capacity : 0);
+    fprintf(file, "  %-24s %12.2f\n", "average probe length",
+        table->size != 0 ? (double) total_probes / table->size : 0);
+    fprintf(file, "  %-24s %12zu\n", "max probe length", max_probes);
+    fprintf(file, "  %-24s %12llu\n", "resizes", (unsigned long long) stats_current.symbol_grows);
+}
+
+/**
+ * Prints the generic structures with the
+ * most generic implementations
+ *
+ * @param[in] file The output file
+ * @param[in] ast  Pointer to the syntax tree
+ */
+static void stats_print_generics(FILE* file, ast_root* ast) {
+    stats_entry* entries = malloc(sizeof(stats_entry) * (ast->declaration_list.size + 1));
+    if (entries == NULL) {
+        return;
+    }
+    size_t count = 0;
+    uint64_t total = 0;
+    iterate_array(i, ast->declaration_list.size) {
+        declaration* dc = ast->declaration_list.data[i];
+        if (dc->kind == DC_STRUCTURE && dc->u_structure->generics.size != 0) {
+            entries[count].name = dc->name;
+            entries[count].count = dc->u_structure->_generic_impls.size;
+            total += entries[count].count;
+            count++;
+        }
+    }
+    qsort(entries, count, sizeof(stats_entry), stats_compare_entries);
+
+    fprintf(file, "  %-24s %12s\n", "generic structure", "impls");
+    for (size_t i = 0; i < count && i < STATS_REPORT_SIZE; i++) {
+        fprintf(file, "  %-24s %12llu\n", entries[i].name, (unsigned long long) entries[i].count);
+    }
+    fprintf(file, "  %-24s %12llu\n", "total", (unsigned long long) total);
+    free(entries);
+}
+
+    /* functions */
+/**
+ * Prints the statistics of a compilation
+ *
+ * @param[in] file  The output file
+ * @param[in] title Title of the report, such as the input filename
+ * @param[in] ast   Pointer to the parsed syntax tree
+ */
+void stats_print(FILE* file, const char* title, ast_root* ast) {
+    stats_report* report = &stats_current;
+    fprintf(file, "statistics: %s\n", title);
+    stats_print_tokens(file);
+
+    fprintf(file, "  %-24s %12s %7s\n", "lookup", "count", "%");
+    fprintf(file, "  %-24s %12llu\n", "identifiers", (unsigned long long) report->lookups);
+    stats_print_share(file, "local hits", report->local_hits, report->lookups);
+    stats_print_share(file, "global hits", report->global_hits, report->lookups);
+    stats_print_share(file, "not found", report->lookups - report->local_hits - report->global_hits, report->lookups);
+    fprintf(file, "  %-24s %12llu\n", "native identifiers", (unsigned long long) report->native_lookups);
+    stats_print_share(file, "native hits", report->native_hits, report->native_lookups);
+
+    fprintf(file, "  %-24s %12s\n", "symbol table", "");
+    stats_print_symbol_table(file, &ast->symbol_table);
+
+    fprintf(file, "  %-24s %12s\n", "import", "count");
+    fprintf(file, "  %-24s %12llu\n", "imports", (unsigned long long) report->imports);
+    fprintf(file, "  %-24s %12llu\n", "native imports", (unsigned long long) report->native_imports);
+    fprintf(file, "  %-24s %12llu\n", "linked from modules", (unsigned long long) report->linked_imports);
+    fprintf(file, "  %-24s %12llu\n", "repeat rejections", (unsigned long long) report->repeat_imports);
+
+    stats_print_generics(file, ast);
+    fprintf(file, "  %-24s %12llu\n", "merged declarations", (unsigned long long) report->merges);
+}
\ No newline at end of file
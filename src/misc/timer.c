@@ -0,0 +1,87 @@
+/**
+ * @file timer.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Compilation phase timers implementation
+ */
+    /* includes */
+#include "misc/timer.h" /* this */
+
+#include <time.h> /* clock */
+
+    /* global variables */
+/**
+ * Enables the phase timers, set by --time-report
+ */
+bool timer_mode = false;
+
+/**
+ * Phase times of the current compilation
+ */
+timer_report timer_current;
+
+/**
+ * Names of the phases in the report
+ */
+static const char* timer_phase_names[TIMER_PHASE_COUNT] = {
+    [TIMER_LEX]                 = "lexing",
+    [TIMER_PASS_1]              = "pass 1 (declarations)",
+    [TIMER_PASS_2]              = "pass 2 (headers)",
+    [TIMER_PASS_3]              = "pass 3 (bodies)",
+    [TIMER_NATIVE_PREPROCESS]   = "native preprocessing",
+    [TIMER_NATIVE_PARSE]        = "native parsing",
+    [TIMER_NATIVE_MACROS]       = "native macros",
+    [TIMER_NATIVE_SNAPSHOT]     = "native snapshots",
+    [TIMER_SYMBOL_TABLE]        = "symbol table (sampled)",
+    [TIMER_CODEGEN_HEADER]      = "codegen header",
+    [TIMER_CODEGEN_DEFINITIONS] = "codegen definitions"
+};
+
+    /* functions */
+/**
+ * Reads the monotonic clock
+ *
+ * @return The time in nanoseconds
+ */
+uint64_t timer_now() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+/**
+ * Adds the phase times of a report to another one
+ *
+ * @param[in] report Pointer to the resulting report
+ * @param[in] source Pointer to the added report
+ */
+void timer_report_add(timer_report* report, const timer_report* source) {
+    report->total += source->total;
+    for (int i = 0; i < TIMER_PHASE_COUNT; i++) {
+        report->time[i] += source->time[i];
+        report->count[i] += source->count[i];
+    }
+}
+
+/**
+ * Prints a phase time report
+ *
+ * @param[in] file   The output file
+ * @param[in] title  Title of the report, such as the input filename
+ * @param[in] report Pointer to the report
+ */
+void timer_report_print(FILE* file, const char* title, const timer_report* report) {
+    fprintf(file, "time report: %s\n", title);
+    fprintf(file, "  %-24s %12s %7s %10s\n", "phase", "ms", "%", "count");
+    for (int i = 0; i < TIMER_PHASE_COUNT; i++) {
+        if (report->count[i] == 0) {
+            continue;
+        }
+        double percent = report->total != 0 ? 100.0 * report->time[i] / report->total : 0;
+        fprintf(file, "  %-24s %12.3f %6.1f%% %10llu\n", timer_phase_names[i],
+            report->time[i] / 1e6, percent, (unsigned long long) report->count[i]);
+    }
+    fprintf(file, "  %-24s %12.3f\n", "total", report->total / 1e6);
+}
\ No newline at end of file
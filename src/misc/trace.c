@@ -0,0 +1,168 @@
+/**
+ * @file trace.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Trace Event Format output implementation
+ */
+    /* includes */
+#include "misc/trace.h" /* this */
+
+#include <stdio.h> /* string formatting */
+#include <string.h> /* string functions */
+#include <unistd.h> /* process functions */
+#include <fcntl.h> /* file control */
+#include <errno.h> /* error codes */
+
+#include "misc/timer.h" /* monotonic clock */
+
+    /* defines */
+/**
+ * Maximum size of an event
+ */
+#define TRACE_EVENT_SIZE 2048
+
+/**
+ * Maximum length of an escaped name
+ */
+#define TRACE_NAME_SIZE 1024
+
+    /* global variables */
+/**
+ * Enables the trace output, set by --trace
+ */
+bool trace_mode = false;
+
+/**
+ * The trace file, shared with the worker processes
+ */
+static int trace_fd = -1;
+
+    /* internal functions */
+/**
+ * Escapes a string for a JSON string literal,
+ * truncating it if it is too long
+ *
+ * @param[out] buffer The buffer of TRACE_NAME_SIZE characters
+ * @param[in]  string The string
+ *
+ * @return The buffer
+ */
+static char* trace_escape(char* buffer, const char* string) {
+    size_t length = 0;
+    for (const char* c = string; *c != '\0' && length + 7 < TRACE_NAME_SIZE; c++) {
+        if (*c == '"' || *c == '\\') {
+            buffer[length++] = '\\';
+            buffer[length++] = *c;
+        } else if ((unsigned char) *c < 0x20) {
+            length += snprintf(buffer + length, TRACE_NAME_SIZE - length, "\\u%04x", *c);
+        } else {
+            buffer[length++] = *c;
+        }
+    }
+    buffer[length] = '\0';
+    return buffer;
+}
+
+/**
+ * Appends an event to the trace file
+ *
+ * @param[in] phase    Event phase, as in the format
+ * @param[in] category Category of the event or NULL
+ * @param[in] name     Name of the event or NULL
+ * @param[in] start    Time of the event from timer_now
+ * @param[in] duration Duration of a complete event
+ * @param[in] thread   Thread id of the event
+ */
+static void trace_write(char phase, const char* category, const char* name,
+        uint64_t start, uint64_t duration, pid_t thread) {
+    char event[TRACE_EVENT_SIZE], escaped_category[TRACE_NAME_SIZE], escaped_name[TRACE_NAME_SIZE];
+    int length = snprintf(event, sizeof(event), "{\"ph\":\"%c\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f",
+        phase, (int) getpid(), (int) thread, start / 1e3);
+    if (phase == 'X') {
+        length += snprintf(event + length, sizeof(event) - length, ",\"dur\":%.3f", duration / 1e3);
+    }
+    if (phase == 'M') {
+        length += snprintf(event + length, sizeof(event) - length,
+            ",\"name\":\"process_name\",\"args\":{\"name\":\"%s\"}", trace_escape(escaped_name, name));
+    } else if (name != NULL) {
+        length += snprintf(event + length, sizeof(event) - length, ",\"cat\":\"%s\",\"name\":\"%s\"",
+            trace_escape(escaped_category, category), trace_escape(escaped_name, name));
+    }
+    length += snprintf(event + length, sizeof(event) - length, "},\n");
+    if (length >= (int) sizeof(event)) {
+        return;
+    }
+
+    /* a single append is not interleaved with the other workers */
+    while (write(trace_fd, event, length) < 0 && errno == EINTR) {}
+}
+
+    /* functions */
+/**
+ * Creates the trace file and enables the trace output
+ *
+ * @param[in] filename Name of the trace file
+ *
+ * @return false if the file could not be created
+ */
+bool trace_open(const char* filename) {
+    trace_fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if (trace_fd < 0) {
+        return false;
+    }
+    if (write(trace_fd, "[\n", 2) != 2) {
+        close(trace_fd);
+        return false;
+    }
+    trace_mode = true;
+    return true;
+}
+
+/**
+ * Names the current process in the trace
+ *
+ * @param[in] name The name
+ */
+void trace_name_process(const char* name) {
+    if (trace_mode) {
+        trace_write('M', NULL, name, 0, 0, getpid());
+    }
+}
+
+/**
+ * Begins a span of the current process,
+ * spans must be ended in the reverse order
+ *
+ * @param[in] category Category of the span
+ * @param[in] name     Name of the span
+ */
+void trace_begin(const char* category, const char* name) {
+    if (trace_mode) {
+        trace_write('B', category, name, timer_now(), 0, getpid());
+    }
+}
+
+/**
+ * Ends the last span of the current process
+ */
+void trace_end() {
+    if (trace_mode) {
+        trace_write('E', NULL, NULL, timer_now(), 0, getpid());
+    }
+}
+
+/**
+ * Adds a finished span of a child process
+ *
+ * @param[in] category Category of the span
+ * @param[in] name     Name of the span
+ * @param[in] start    Start time from timer_now
+ * @param[in] child    The child process id
+ */
+void trace_process(const char* category, const char* name, uint64_t start, pid_t child) {
+    if (trace_mode) {
+        trace_write('X', category, name, start, timer_now() - start, child);
+    }
+}
\ No newline at end of file
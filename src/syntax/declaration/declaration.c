@@ -27,11 +27,35 @@ index_t dc_structure_generic_add_impl(dc_structure* this, list(ast_type) impl) {
             this->generics.size, this->name, impl.size);
     }
 
+    /* non-generic structures have a single implementation */
+    if (this->generics.size == 0) {
+        return 0;
+    }
+
     /* check for duplicates */
-    bool is_equal = false;
+    index_t index;
+    if (dc_structure_generic_find_impl(this, impl, &index)) {
+        return index;
+    }
+
+    /* add the generic implementation */
+    arl_add(list(ast_type), this->_generic_impls, impl);
+    return this->_generic_impls.size - 1;
+}
+
+/**
+ * Finds an existing generic implementation of a structure
+ * 
+ * @param[in]  this  The structure
+ * @param[in]  impl  The list of types for the generic implementation
+ * @param[out] index The index of the implementation
+ * 
+ * @return false if the structure has no such implementation
+ */
+bool dc_structure_generic_find_impl(dc_structure* this, list(ast_type) impl, index_t* index) {
     for (size_t i = 0; i < this->_generic_impls.size; i++) {
         list(ast_type) impls = this->_generic_impls.data[i];
-        is_equal = true;
+        bool is_equal = true;
 
         /* compare an implementation */
         for (size_t j = 0; j < impls.size; j++) {
@@ -40,12 +64,35 @@ index_t dc_structure_generic_add_impl(dc_structure* this, list(ast_type) impl) {
             }
         }
 
-        if (is_equal) return i;
+        if (is_equal) {
+            *index = i;
+            return true;
+        }
     }
+    return false;
+}
 
-    /* add the generic implementation */
-    arl_add(list(ast_type), this->_generic_impls, impl);
-    return this->_generic_impls.size - 1;
+/**
+ * Copies a structure into the current arena, so that
+ * implementations can be added to the copy without
+ * changing the original
+ * 
+ * @param this The structure
+ * 
+ * @return The copy, which keeps the implementation indices of the original
+ */
+dc_structure* dc_structure_copy(dc_structure* this) {
+    dc_structure* copy = allocate(dc_structure);
+    *copy = *this;
+    copy->_origin = dc_structure_origin(this);
+    copy->_is_sealed = false;
+
+    arraylist_init_empty(list(ast_type))(&copy->_generic_impls);
+    iterate_array(i, this->_generic_impls.size) {
+        arl_add(list(ast_type), copy->_generic_impls, this->_generic_impls.data[i]);
+    }
+    arraylist_init_empty(ast_layout)(&copy->_layouts);
+    return copy;
 }
 
 /**
@@ -100,7 +147,7 @@ ast_type* dc_generic_get_impl(ast_type* this) {
  * 
  * @param[in] this The structure
  * 
- * @return The string, allocated by malloc
+ * @return The string, allocated in the current arena
  */
 char* dc_structure_contents_to_string(dc_structure* this) {
     /* the prefix */
@@ -127,7 +174,6 @@ char* dc_structure_contents_to_string(dc_structure* this) {
 
         strncpy(member_names[i], internal_type, member_name_sizes[i]);
         member_name_sizes[i] = strlen(internal_type);
-        free(internal_type);
 
         member_names[i][member_name_sizes[i]] = ' ';
         member_name_sizes[i] += 1;
@@ -181,7 +227,7 @@ char* dc_structure_contents_to_string(dc_structure* this) {
  * @param this The structure
  * @param index The generic impl index to use
  * 
- * @return Display name, allocated by a malloc,
+ * @return Display name, allocated in the current arena,
  *          or the structure's actual name
  */
 char* dc_structure_display_name(dc_structure* this, index_t impl_index) {
@@ -247,7 +293,7 @@ char* dc_structure_display_name(dc_structure* this, index_t impl_index) {
  * @param this The enum
  * @param index The generic impl index to use
  * 
- * @return Display name, allocated by a malloc,
+ * @return Display name, allocated in the current arena,
  *          or the enum's actual name
  */
 char* dc_enum_display_name(dc_enum* this, index_t impl_index) {
@@ -271,7 +317,7 @@ char* dc_enum_display_name(dc_enum* this, index_t impl_index) {
  * @param this The function
  * @param index The generic impl index to use
  * 
- * @return Display name, allocated by a malloc,
+ * @return Display name, allocated in the current arena,
  *          or the function's actual name
  */
 char* dc_function_display_name(dc_function* this, index_t impl_index) {
@@ -299,7 +345,7 @@ char* dc_function_display_name(dc_function* this, index_t impl_index) {
  * @param this The structure
  * @param index The generic impl index to use
  * 
- * @return Mangled name, allocated by a malloc,
+ * @return Mangled name, allocated in the current arena,
  *          or the structure's actual name
  */
 char* dc_structure_mangled_name(dc_structure* this, index_t impl_index) {
@@ -318,6 +364,7 @@ char* dc_structure_mangled_name(dc_structure* this, index_t impl_index) {
 
     /* handle c names */
     if (this->is_c_struct) {
+        name = copy_string(name); /* the original name is interned */
         name[CST_NATIVE_STRUCT_PREFIX_STRLEN - 1] = ' ';
         return name;
     }
@@ -381,7 +428,7 @@ char* dc_structure_mangled_name(dc_structure* this, index_t impl_index) {
  * @param this The enum
  * @param index The generic impl index to use
  * 
- * @return Mangled name, allocated by a malloc,
+ * @return Mangled name, allocated in the current arena,
  *          or the enum's actual name
  */
 char* dc_enum_mangled_name(dc_enum* this, index_t impl_index) {
@@ -399,6 +446,7 @@ char* dc_enum_mangled_name(dc_enum* this, index_t impl_index) {
 
     /* handle c names */
     if (this->is_c_enum) {
+        name = copy_string(name); /* the original name is interned */
         name[CST_NATIVE_ENUM_PREFIX_STRLEN - 1] = ' ';
         return name;
     }
@@ -413,7 +461,7 @@ char* dc_enum_mangled_name(dc_enum* this, index_t impl_index) {
  * @param this The function
  * @param index The generic impl index to use
  * 
- * @return Mangled name, allocated by a malloc,
+ * @return Mangled name, allocated in the current arena,
  *          or the function's actual name
  */
 char* dc_function_mangled_name(dc_function* this, index_t impl_index) {
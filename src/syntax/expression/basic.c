@@ -12,6 +12,7 @@
 #include "syntax/statement/statement.h" /* statements */
 #include "ast/type/resolve.h" /* type initialization */
 #include "ast/type/check.h" /* type comparison */
+#include "ast/type/primitive.h" /* primitives */
 
         /* inheritance */
 
@@ -72,6 +73,16 @@ iapi_init_union_from_extern(B, basic, ex_enum_member*, ENUM_MEMBER, enum_member)
     }
 }
 
+    /* {PROPERTIES} BASIC << CONSTANT */
+iapi_init_union_from_extern(B, basic, dc_constant*, CONSTANT, constant) {
+    iset_type(init) {
+        ast_type_init(&this->type, AST_TYPE_PRIMITIVE, value->type);
+    }
+    iset_constant(clone) {
+        ex_constant_clone(&this->constant, &value->value);
+    }
+}
+
     /* {PROPERTIES} BASIC << STRING */
 iapi_init_union_from_extern(B, basic, char*, STRING, string)  {
     iset_type(resolve) {
@@ -103,6 +114,20 @@ iapi_init_union_from_extern(B, basic, ex_constructor*, EX_CONSTRUCTOR, ex_constr
     }
 }
 
+    /* {PROPERTIES} BASIC << LAYOUT EXPRESSION */
+iapi_init_union_from_extern(B, basic, ex_layout*, LAYOUT, layout) {
+    iset_type(init) {
+        ast_type_init(&this->type, AST_TYPE_PRIMITIVE, &primitive_list.data[PRIMITIVE_INDEX_ULONG]);
+    }
+    iset_constant(resolve) {
+        if (value->is_known) {
+            ex_constant_init(this->constant, ULONG, ulong, (uint64_t) value->value);
+        } else {
+            ex_constant_dynamic(&this->constant);
+        }
+    }
+}
+
     /* {PROPERTIES} BASIC << FUNCTION PARAMETER */
 iapi_init_union_from_extern(B, basic, dc_function_parameter*, FUNCTION_PARAMETER, function_parameter) {
     iset_type(clone) {
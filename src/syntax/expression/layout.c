@@ -0,0 +1,71 @@
+/**
+ * @file layout.c
+ * @author andersonarc (e.andersonarc@gmail.com)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ *  Layout expression functions
+ */
+    /* includes */
+#include "syntax/declaration/declaration.h" /* declarations */
+#include "syntax/expression/unary.h" /* unary expressions */
+#include "ast/type/layout.h" /* type layouts */
+#include "ast/type/check.h" /* type checks */
+#include "ast/type/primitive.h" /* primitives */
+#include "misc/memory.h" /* memory allocation */
+
+    /* functions */
+/**
+ * Creates a layout expression and folds its
+ * value if the layout of the type is known
+ *
+ * @param[in] kind   Kind of the layout expression
+ * @param[in] type   The type
+ * @param[in] member Name of the structure member for offsetof, or NULL
+ *
+ * @return Pointer to the layout expression
+ */
+ex_layout* ex_layout_new(ex_layout_kind kind, ast_type type, char* member) {
+    ex_layout* this = allocate(ex_layout);
+    this->kind = kind;
+    this->type = ast_type_clone(type);
+    this->u_member = NULL;
+
+    size_t size, alignment;
+    switch (kind) {
+        case EX_L_SIZEOF:
+        case EX_L_ALIGNOF:
+            expect(this->type->kind != AST_TYPE_FUNCTION || !ast_type_is_plain(this->type))
+                otherwise("cannot compute the layout of a function \"%s\"", ast_type_display_name(this->type));
+            expect(this->type->kind != AST_TYPE_PRIMITIVE || !ast_type_is_plain(this->type)
+                    || !ast_type_primitive_is_void(this->type->u_primitive))
+                otherwise("cannot compute the layout of a void type");
+
+            this->is_known = ast_layout_of_type(this->type, &size, &alignment);
+            if (this->is_known) {
+                this->value = kind == EX_L_SIZEOF ? size : alignment;
+            }
+            break;
+
+        case EX_L_OFFSETOF: {
+            expect(this->type->kind == AST_TYPE_STRUCTURE && ast_type_is_plain(this->type))
+                otherwise("offsetof requires a structure type, got \"%s\"", ast_type_display_name(this->type));
+
+            dc_structure* structure = this->type->u_structure;
+            arl_find_by_name(
+                in_list(dc_structure_member, structure->member_list),
+                find_and_assign(member, this->u_member),
+                on_error("structure \"%s\" has no member \"%s\"",
+                            structure->name,
+                            member)
+            );
+
+            size_t index = this->u_member - structure->member_list.data;
+            this->is_known = ast_layout_offset_of(this->type, index, &this->value);
+            break;
+        }
+
+        otherwise_error
+    }
+    return this;
+}
\ No newline at end of file